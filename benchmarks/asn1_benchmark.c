@@ -0,0 +1,31 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <openssl/asn1.h>
+#include <openssl/bn.h>
+#include <stdlib.h>
+
+void harness() {
+    unsigned char *der = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(der != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        ASN1_INTEGER *ai  = NULL;
+        unsigned char *in = der;
+        if (d2i_ASN1_INTEGER(&ai, &in, BENCHMARK_MAX_INPUT_SIZE) != NULL) {
+            BIGNUM *bn = ASN1_INTEGER_to_BN(ai, NULL);
+            if (bn != NULL) {
+                ASN1_INTEGER *copy = BN_to_ASN1_INTEGER(bn, NULL);
+                unsigned char *out = NULL;
+                if (copy != NULL && i2d_ASN1_INTEGER(copy, &out) > 0) free(out);
+                ASN1_STRING_clear_free(copy);
+                BN_free(bn);
+            }
+        }
+        ASN1_STRING_clear_free(ai);
+    }
+}
@@ -0,0 +1,24 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <stdlib.h>
+
+void harness() {
+    unsigned char *raw     = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    unsigned char *encoded = malloc(BENCHMARK_MAX_INPUT_SIZE / 3 * 4 + 5);
+    unsigned char *decoded = malloc(BENCHMARK_MAX_INPUT_SIZE + 3); /* Decoding may yield up to 2 padding bytes. */
+    __CPROVER_assume(raw != NULL && encoded != NULL && decoded != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        int n = nondet_int();
+        __CPROVER_assume(0 <= n && n <= BENCHMARK_MAX_INPUT_SIZE);
+        int len = EVP_EncodeBlock(encoded, raw, n);
+        if (len > 0) EVP_DecodeBlock(decoded, encoded, len);
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*
+ * Shared definitions of the benchmark harnesses. Every harness exercises one API family of the model in a loop of
+ * BENCHMARK_ITERATIONS rounds. It must be the first loop of harness(): run_benchmarks.py unwinds it completely by
+ * its loop id, harness.0.
+ */
+#ifndef BENCHMARK_ITERATIONS
+#    define BENCHMARK_ITERATIONS 4
+#endif
+
+/* Largest input buffer passed to a single call. Small enough to keep buffers symbolic but cheap. */
+#ifndef BENCHMARK_MAX_INPUT_SIZE
+#    define BENCHMARK_MAX_INPUT_SIZE 64
+#endif
+
+#endif /* BENCHMARK_H */
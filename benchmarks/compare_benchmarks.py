@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+
+"""Compares two benchmark reports written by run_benchmarks.py and fails on proof-cost regressions.
+
+A family regresses when its SAT clause count grows by more than --clause-threshold percent, or its solver time grows
+by more than --time-threshold percent (times below --min-time seconds in both reports are ignored as noise). Families
+whose status got worse (e.g. SUCCESS to FAILURE) or that disappeared are reported as regressions too.
+
+Exits with status 1 if any regression is found, so it can gate CI:
+
+    benchmarks/compare_benchmarks.py baseline/report.json benchmarks/build/report.json
+"""
+
+import argparse
+import json
+import sys
+
+STATUS_RANK = {"SUCCESS": 0, "FAILURE": 1, "ERROR": 2}
+
+# Metrics shown for every family; only those with a threshold can fail the comparison.
+METRICS = ["program_steps", "vccs_remaining", "sat_variables", "sat_clauses", "solver_time"]
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return report, {b["family"]: b for b in report["benchmarks"]}
+
+
+def growth(old, new):
+    """Relative growth in percent, or None if either value is missing."""
+    if old is None or new is None:
+        return None
+    if old == 0:
+        return 0.0 if new == 0 else float("inf")
+    return 100.0 * (new - old) / old
+
+
+def regressions_of(old, new, args):
+    if new is None:
+        return ["missing from the new report"]
+    found = []
+    if STATUS_RANK.get(new["status"], 2) > STATUS_RANK.get(old["status"], 2):
+        found.append("status %s -> %s" % (old["status"], new["status"]))
+    clauses = growth(old.get("sat_clauses"), new.get("sat_clauses"))
+    if clauses is not None and clauses > args.clause_threshold:
+        found.append("sat_clauses +%.1f%%" % clauses)
+    old_time, new_time = old.get("solver_time"), new.get("solver_time")
+    time = growth(old_time, new_time)
+    if time is not None and max(old_time, new_time) >= args.min_time and time > args.time_threshold:
+        found.append("solver_time +%.1f%%" % time)
+    return found
+
+
+def cell(old, new, metric):
+    a, b = old.get(metric), (new or {}).get(metric)
+    g = growth(a, b)
+    return "%s -> %s (%s)" % (a, b, "n/a" if g is None else "%+.1f%%" % g)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="report of the reference revision")
+    parser.add_argument("current", help="report of the revision under test")
+    parser.add_argument("--clause-threshold", type=float, default=10.0, help="allowed clause growth in %% (default 10)")
+    parser.add_argument("--time-threshold", type=float, default=25.0, help="allowed time growth in %% (default 25)")
+    parser.add_argument("--min-time", type=float, default=1.0, help="ignore solver times below this (default 1s)")
+    args = parser.parse_args()
+
+    old_report, old = load(args.baseline)
+    new_report, new = load(args.current)
+    for key in ("iterations", "model_flags", "cbmc_version"):
+        if old_report.get(key) != new_report.get(key):
+            print("warning: %s differs: %r vs %r" % (key, old_report.get(key), new_report.get(key)))
+
+    failed = False
+    for family in sorted(old):
+        found = regressions_of(old[family], new.get(family), args)
+        failed = failed or bool(found)
+        print("%-6s %s" % ("REGR" if found else "ok", family))
+        for metric in METRICS:
+            print("       %-15s %s" % (metric, cell(old[family], new.get(family), metric)))
+        for regression in found:
+            print("       ! " + regression)
+    for family in sorted(set(new) - set(old)):
+        print("new    %s" % family)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,27 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <openssl/dh.h>
+#include <stdlib.h>
+
+void harness() {
+    unsigned char *key = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(key != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        DH *dh = DH_new();
+        if (dh == NULL) continue;
+        int codes;
+        const BIGNUM *p, *q, *g;
+        DH_get0_pqg(dh, &p, &q, &g);
+        if (p != NULL && g != NULL && dh->pub_key != NULL && DH_check(dh, &codes) == 1 && DH_generate_key(dh) == 1 &&
+            DH_size(dh) <= BENCHMARK_MAX_INPUT_SIZE) {
+            DH_compute_key(key, dh->pub_key, dh);
+        }
+        DH_free(dh);
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <openssl/ec.h>
+#include <openssl/objects.h>
+#include <stdlib.h>
+
+void harness() {
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        EC_GROUP *group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+        EC_KEY *key     = EC_KEY_new();
+        if (group != NULL && key != NULL) {
+            EC_GROUP_set_point_conversion_form(group, POINT_CONVERSION_COMPRESSED);
+            EC_KEY_set_conv_form(key, POINT_CONVERSION_COMPRESSED);
+        }
+        if (group != NULL && key != NULL && EC_KEY_set_group(key, group) == 1 && EC_KEY_generate_key(key) == 1) {
+            unsigned char *encoded = NULL;
+            int len                = i2o_ECPublicKey(key, &encoded);
+            if (len > 0) free(encoded);
+        }
+        EC_KEY_free(key);
+        EC_GROUP_free(group);
+    }
+}
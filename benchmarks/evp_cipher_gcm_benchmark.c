@@ -0,0 +1,34 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <stdlib.h>
+
+void harness() {
+    unsigned char key[32];
+    unsigned char iv[12];
+    unsigned char tag[16];
+    unsigned char *in  = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    unsigned char *out = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(in != NULL && out != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        int inl = nondet_int();
+        __CPROVER_assume(0 < inl && inl <= BENCHMARK_MAX_INPUT_SIZE);
+        int outl;
+        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+        if (ctx == NULL) continue;
+        if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, sizeof(iv), NULL) == 1 &&
+            EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv) == 1 && EVP_EncryptUpdate(ctx, NULL, &outl, in, inl) == 1 &&
+            EVP_EncryptUpdate(ctx, out, &outl, in, inl) == 1 && EVP_EncryptFinal_ex(ctx, out, &outl) == 1) {
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, sizeof(tag), tag);
+        }
+        EVP_CIPHER_CTX_free(ctx);
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_MD_CTX *ctx     = EVP_MD_CTX_new();
+    unsigned char *data = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(ctx != NULL && data != NULL);
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int md_len;
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        size_t len = nondet_size_t();
+        __CPROVER_assume(len <= BENCHMARK_MAX_INPUT_SIZE);
+        if (EVP_DigestInit_ex(ctx, nondet_bool() ? EVP_sha256() : EVP_sha384(), NULL) != 1) continue;
+        if (EVP_DigestUpdate(ctx, data, len) != 1) continue;
+        EVP_DigestFinal_ex(ctx, md, &md_len);
+    }
+    EVP_MD_CTX_free(ctx);
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY *pkey = EVP_PKEY_new();
+    EC_KEY *ec_key = ec_key_nondet_alloc();
+    __CPROVER_assume(pkey != NULL && ec_key_is_valid(ec_key) && ec_key->references == 1);
+    evp_pkey_set0_ec_key(pkey, ec_key);
+    unsigned char *in  = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    unsigned char *out = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(in != NULL && out != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(pkey, NULL);
+        if (ctx == NULL) continue;
+        size_t inlen = nondet_size_t();
+        __CPROVER_assume(0 < inlen && inlen <= BENCHMARK_MAX_INPUT_SIZE);
+        size_t outlen = BENCHMARK_MAX_INPUT_SIZE;
+        if (EVP_PKEY_sign_init(ctx) == 1 && EVP_PKEY_sign(ctx, NULL, &outlen, in, inlen) == 1 &&
+            outlen <= BENCHMARK_MAX_INPUT_SIZE) {
+            EVP_PKEY_sign(ctx, out, &outlen, in, inlen);
+        }
+        outlen = BENCHMARK_MAX_INPUT_SIZE;
+        if (EVP_PKEY_derive_init(ctx) == 1) EVP_PKEY_derive(ctx, out, &outlen);
+        outlen = BENCHMARK_MAX_INPUT_SIZE;
+        if (EVP_PKEY_encrypt_init(ctx) == 1) EVP_PKEY_encrypt(ctx, out, &outlen, in, inlen);
+        EVP_PKEY_CTX_free(ctx);
+    }
+    EVP_PKEY_free(pkey);
+}
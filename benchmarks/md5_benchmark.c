@@ -0,0 +1,25 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/md5.h>
+#include <stdlib.h>
+
+void harness() {
+    MD5_CTX c;
+    unsigned char md[MD5_DIGEST_LENGTH];
+    unsigned char *data = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(data != NULL);
+
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        size_t len = nondet_size_t();
+        __CPROVER_assume(len <= BENCHMARK_MAX_INPUT_SIZE);
+        MD5_Init(&c);
+        MD5_Update(&c, data, len);
+        MD5_Final(md, &c);
+    }
+}
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+
+"""Runs the benchmark harnesses of the model and writes their CBMC statistics to a JSON report.
+
+Every benchmarks/<family>_benchmark.c calls the functions of one API family in a loop of BENCHMARK_ITERATIONS rounds.
+Each harness is linked against the prebuilt model (see build_model.sh) and run through CBMC with that loop, the first
+loop of harness(), fully unwound through --unwindset. The loops of the model get the per-family bound of MODEL_UNWIND,
+so that no unwinding assertion fails in a complete run. The report records, per family, the size of the symex
+equation, the number of VCCs, the size of the SAT instance and the time spent in symex and in the solver.
+
+CBMC_PROOF_INCLUDE and MODEL_FLAGS are used as in build_model.sh.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BENCHMARKS = os.path.join(ROOT, "benchmarks")
+
+CBMC_CHECKS = [
+    "--bounds-check",
+    "--pointer-check",
+    "--div-by-zero-check",
+    "--signed-overflow-check",
+    "--malloc-may-fail",
+    "--malloc-fail-null",
+]
+
+# Unwinding bound (CBMC's --unwind) of the model loops that each family reaches, for inputs of at most
+# BENCHMARK_MAX_INPUT_SIZE (64) bytes. The benchmark loop of harness() gets its own bound through --unwindset.
+# Other families use DEFAULT_MODEL_UNWIND, enough for a loop over one input.
+MODEL_UNWIND = {
+    "evp_digest": 65,  # LIBCRYPTO_MODEL_UF_DIGESTS absorbs up to 64 bytes and outputs up to 64.
+    "md5": 65,  # 64 rounds per LIBCRYPTO_MODEL_CONCRETE_MD5 block, and up to 64 absorbed bytes.
+    "sha": 81,  # 80 rounds per LIBCRYPTO_MODEL_CONCRETE_SHA1 block.
+}
+DEFAULT_MODEL_UNWIND = 65
+
+# Statistics printed by CBMC at --verbosity 8, mapped to the report field they fill in.
+STATISTICS = [
+    (re.compile(r"size of program expression: (\d+) steps"), "program_steps", int),
+    (re.compile(r"Generated (\d+) VCC\(s\), (\d+) remaining after simplification"), ("vccs", "vccs_remaining"), int),
+    (re.compile(r"^(\d+) variables, (\d+) clauses", re.M), ("sat_variables", "sat_clauses"), int),
+    (re.compile(r"Runtime Symex: ([\d.]+)s"), "symex_time", float),
+    (re.compile(r"Runtime (?:Solver|decision procedure): ([\d.]+)s"), "solver_time", float),
+]
+
+
+def families():
+    suffix = "_benchmark.c"
+    return sorted(f[: -len(suffix)] for f in os.listdir(BENCHMARKS) if f.endswith(suffix))
+
+
+def parse_statistics(output):
+    stats = {}
+    for pattern, fields, convert in STATISTICS:
+        matches = pattern.findall(output)
+        if not matches:
+            continue
+        # The last match describes the final (complete) run when CBMC reports several.
+        values = matches[-1] if isinstance(matches[-1], tuple) else (matches[-1],)
+        for field, value in zip(fields if isinstance(fields, tuple) else (fields,), values):
+            stats[field] = convert(value)
+    return stats
+
+
+def run_benchmark(family, args, model):
+    goto = os.path.join(args.build_dir, family + ".goto")
+    compile_cmd = (
+        ["goto-cc", "--function", "harness", "-DBENCHMARK_ITERATIONS=%d" % args.iterations]
+        + ["-I", os.path.join(ROOT, "include"), "-I", BENCHMARKS, "-I", os.environ["CBMC_PROOF_INCLUDE"]]
+        + shlex.split(os.environ.get("MODEL_FLAGS", ""))
+        + ["-o", goto, os.path.join(BENCHMARKS, family + "_benchmark.c"), model]
+    )
+    result = {"family": family}
+    compiled = subprocess.run(compile_cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if compiled.returncode != 0:
+        result["status"] = "ERROR"
+        result["error"] = compiled.stdout[-2000:]
+        return result
+
+    cbmc_cmd = ["cbmc", "--verbosity", "8", "--unwind", str(MODEL_UNWIND.get(family, DEFAULT_MODEL_UNWIND))]
+    cbmc_cmd += ["--unwindset", "harness.0:%d" % (args.iterations + 1), "--unwinding-assertions"]
+    start = time.monotonic()
+    checked = subprocess.run(
+        cbmc_cmd + CBMC_CHECKS + [goto], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True
+    )
+    result["total_time"] = round(time.monotonic() - start, 3)
+    # CBMC exits with 0 when all properties hold and 10 when some fail; both runs produced statistics.
+    result["status"] = {0: "SUCCESS", 10: "FAILURE"}.get(checked.returncode, "ERROR")
+    result.update(parse_statistics(checked.stdout))
+    if result["status"] == "ERROR":
+        result["error"] = checked.stdout[-2000:]
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("families", nargs="*", help="benchmarks to run (default: all of %s)" % ", ".join(families()))
+    parser.add_argument("--iterations", type=int, default=4, help="calls per function (default: 4)")
+    parser.add_argument("--build-dir", default=os.path.join(BENCHMARKS, "build"), help="directory for build outputs")
+    parser.add_argument("--output", default=None, help="JSON report path (default: <build-dir>/report.json)")
+    args = parser.parse_args()
+
+    if "CBMC_PROOF_INCLUDE" not in os.environ:
+        sys.exit("set CBMC_PROOF_INCLUDE to the directory of the proof helper headers")
+    unknown = sorted(set(args.families) - set(families()))
+    if unknown:
+        sys.exit("unknown benchmarks: " + ", ".join(unknown))
+
+    os.makedirs(args.build_dir, exist_ok=True)
+    model_dir = os.path.join(args.build_dir, "model")
+    subprocess.run([os.path.join(ROOT, "build_model.sh")], check=True, env=dict(os.environ, BUILD_DIR=model_dir))
+    model = os.path.join(model_dir, "libcrypto_model.goto")
+    with open(model + ".sha256") as f:
+        model_hash = f.read().strip()
+
+    results = []
+    for family in args.families or families():
+        result = run_benchmark(family, args, model)
+        print("%-16s %-8s %s" % (family, result["status"], result.get("total_time", "-")), flush=True)
+        results.append(result)
+
+    version = subprocess.run(["cbmc", "--version"], stdout=subprocess.PIPE, text=True).stdout.strip()
+    report = {
+        "cbmc_version": version,
+        "model_hash": model_hash,
+        "model_flags": os.environ.get("MODEL_FLAGS", ""),
+        "iterations": args.iterations,
+        "benchmarks": results,
+    }
+    output = args.output or os.path.join(args.build_dir, "report.json")
+    with open(output, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+        f.write("\n")
+    print("Wrote " + output)
+    return 0 if all(r["status"] != "ERROR" for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,52 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "benchmark.h"
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/sha.h>
+#include <stdlib.h>
+
+void harness() {
+    SHA_CTX c1;
+    SHA256_CTX c256;
+    SHA512_CTX c512;
+    unsigned char md[SHA512_DIGEST_LENGTH];
+    unsigned char *data = malloc(BENCHMARK_MAX_INPUT_SIZE);
+    __CPROVER_assume(data != NULL);
+
+    /* Each round digests with one of SHA-1, SHA-224, SHA-256, SHA-384 and SHA-512. */
+    for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+        size_t len = nondet_size_t();
+        __CPROVER_assume(len <= BENCHMARK_MAX_INPUT_SIZE);
+        switch (nondet_int()) {
+            case 1:
+                SHA1_Init(&c1);
+                SHA1_Update(&c1, data, len);
+                SHA1_Final(md, &c1);
+                break;
+            case 224:
+                SHA224_Init(&c256);
+                SHA224_Update(&c256, data, len);
+                SHA224_Final(md, &c256);
+                break;
+            case 384:
+                SHA384_Init(&c512);
+                SHA384_Update(&c512, data, len);
+                SHA384_Final(md, &c512);
+                break;
+            case 512:
+                SHA512_Init(&c512);
+                SHA512_Update(&c512, data, len);
+                SHA512_Final(md, &c512);
+                break;
+            default:
+                SHA256_Init(&c256);
+                SHA256_Update(&c256, data, len);
+                SHA256_Final(md, &c256);
+                break;
+        }
+    }
+}
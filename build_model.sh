@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"). You may not use
+# this file except in compliance with the License. A copy of the License is
+# located at
+#
+#     http://aws.amazon.com/apache2.0/
+#
+# or in the "license" file accompanying this file. This file is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+# implied. See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Compiles the model into goto binaries that proofs can link instead of compiling source/*.c themselves:
+#   $BUILD_DIR/<file>.goto           one per source/<file>.c
+#   $BUILD_DIR/libcrypto_model.goto  all of them, prelinked
+#
+# proofs/run_proofs.py links each harness with the <file>.goto binaries of its link set only (see proofs/link_sets.py
+# and source/dependencies.json).
+#
+# Every artifact has a <artifact>.sha256 companion holding the content hash of its inputs: the compiled sources, all
+# headers under include/ and $CBMC_PROOF_INCLUDE, MODEL_FLAGS and the goto-cc version. An artifact is only rebuilt
+# when its hash changes, so CI can cache $BUILD_DIR keyed on the hash of libcrypto_model.goto, which is printed at the
+# end (and only depends on the inputs, never on timestamps or paths).
+#
+# Usage: ./build_model.sh
+#
+# CBMC_PROOF_INCLUDE must point to the directory holding the proof helper headers the model includes (see
+# proofs/run_proofs.sh). MODEL_FLAGS passes configuration macros (see include/model_config.h); use a separate
+# BUILD_DIR per configuration.
+
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD_DIR="${BUILD_DIR:-$ROOT/build}"
+: "${CBMC_PROOF_INCLUDE:?set CBMC_PROOF_INCLUDE to the directory of the proof helper headers}"
+MODEL_FLAGS="${MODEL_FLAGS:-}"
+
+# Hash of everything a translation unit may depend on besides its own source file.
+header_hash() {
+    {
+        goto-cc --version
+        echo "$MODEL_FLAGS"
+        (cd "$ROOT" && find include -name '*.h' -print0 | LC_ALL=C sort -z | xargs -0 sha256sum)
+        (cd "$CBMC_PROOF_INCLUDE" && find . -name '*.h' -print0 | LC_ALL=C sort -z | xargs -0 sha256sum)
+    } | sha256sum | cut -d' ' -f1
+}
+
+# Runs the build command in "$@" unless $1.sha256 already records the given hash.
+build_if_changed() {
+    local hash="$1" artifact="$2"
+    shift 2
+    if [ -f "$artifact" ] && [ "$(cat "$artifact.sha256" 2>/dev/null)" = "$hash" ]; then
+        return 0
+    fi
+    rm -f "$artifact.sha256"
+    "$@"
+    echo "$hash" >"$artifact.sha256"
+    echo "Built $(basename "$artifact")"
+}
+
+mkdir -p "$BUILD_DIR"
+HEADERS="$(header_hash)"
+objects=()
+object_hashes=""
+for src in "$ROOT"/source/*.c; do
+    name="$(basename "$src" .c)"
+    hash="$( (echo "$HEADERS" && sha256sum <"$src") | sha256sum | cut -d' ' -f1)"
+    # shellcheck disable=SC2086 # MODEL_FLAGS is a word list.
+    build_if_changed "$hash" "$BUILD_DIR/$name.goto" \
+        goto-cc -c -I "$ROOT/include" -I "$CBMC_PROOF_INCLUDE" $MODEL_FLAGS -o "$BUILD_DIR/$name.goto" "$src"
+    objects+=("$BUILD_DIR/$name.goto")
+    object_hashes+="$name $hash"$'\n'
+done
+
+LIB_HASH="$(printf '%s' "$object_hashes" | sha256sum | cut -d' ' -f1)"
+build_if_changed "$LIB_HASH" "$BUILD_DIR/libcrypto_model.goto" \
+    goto-cc -o "$BUILD_DIR/libcrypto_model.goto" "${objects[@]}"
+echo "libcrypto_model.goto $LIB_HASH"
@@ -0,0 +1,72 @@
+#!/bin/bash
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"). You may not use
+# this file except in compliance with the License. A copy of the License is
+# located at
+#
+#     http://aws.amazon.com/apache2.0/
+#
+# or in the "license" file accompanying this file. This file is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+# implied. See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Compiles the model and one proof or benchmark harness natively into a libFuzzer target, with every nondet_*() value
+# drawn from the fuzzer input (see fuzz/include/cbmc_compat.h). Inputs that the harness assumes away are skipped, and
+# failed assertions, including the assert() preconditions of the model, and out-of-bounds accesses (caught by ASan) are
+# reported as crashes:
+#   $BUILD_DIR/<harness>  the fuzz target, run as e.g. fuzz/build/EVP_DecodeUpdate_harness corpus/
+#
+# A proof harness <function>_harness.c calls the function under test through an entry point that assumes the
+# function's __CPROVER_requires clauses (see fuzz/requires_wrapper.py), as CBMC does when it enforces the contract.
+#
+# Usage: fuzz/build_fuzz.sh proofs/EVP_DecodeUpdate/EVP_DecodeUpdate_harness.c
+#
+# CC defaults to clang, which provides -fsanitize=fuzzer. With FUZZ_STANDALONE=1 the target is a plain ASan executable
+# instead, which runs every file given on its command line as one input (e.g. to replay a corpus or a crash) and also
+# builds with gcc. MODEL_FLAGS passes configuration macros as in build_model.sh; use a separate BUILD_DIR per
+# configuration. The profiles of proofs/manifest.json are not applied: pass the macros of a proof's profile in
+# MODEL_FLAGS.
+
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-$ROOT/fuzz/build}"
+CC="${CC:-clang}"
+MODEL_FLAGS="${MODEL_FLAGS:-}"
+HARNESS="${1:?usage: $0 <harness.c>}"
+
+if [ "${FUZZ_STANDALONE:-0}" = 1 ]; then
+    SANITIZE=(-fsanitize=address -DFUZZ_STANDALONE)
+else
+    SANITIZE=(-fsanitize=fuzzer,address)
+fi
+
+mkdir -p "$BUILD_DIR"
+NAME="$(basename "$HARNESS" .c)"
+TARGET="$BUILD_DIR/$NAME"
+CFLAGS=(-g -O1 -fno-omit-frame-pointer "${SANITIZE[@]}" -I "$ROOT/include" -I "$ROOT/fuzz/include"
+    -include "$ROOT/fuzz/include/cbmc_compat.h")
+
+SOURCES=("$ROOT"/source/*.c)
+HARNESS_FLAGS=()
+FUNCTION="${NAME%_harness}"
+if [ "$FUNCTION" != "$NAME" ]; then
+    CHECKED="$BUILD_DIR/${NAME}_requires.c"
+    UNIT="$(python3 "$ROOT/fuzz/requires_wrapper.py" "$FUNCTION" "$CHECKED")"
+    if [ -n "$UNIT" ]; then
+        for i in "${!SOURCES[@]}"; do
+            [ "${SOURCES[$i]}" = "$UNIT" ] && SOURCES[$i]="$CHECKED"
+        done
+        HARNESS_FLAGS=("-D$FUNCTION=fuzz_checked_$FUNCTION")
+    fi
+fi
+
+# shellcheck disable=SC2086 # MODEL_FLAGS is a word list.
+"$CC" "${CFLAGS[@]}" -I "$(dirname "$HARNESS")" $MODEL_FLAGS "${HARNESS_FLAGS[@]}" \
+    -c -o "$BUILD_DIR/$NAME.o" "$HARNESS"
+# shellcheck disable=SC2086
+"$CC" "${CFLAGS[@]}" $MODEL_FLAGS -o "$TARGET" "${SOURCES[@]}" "$ROOT/fuzz/fuzz_runtime.c" "$BUILD_DIR/$NAME.o"
+echo "Built $TARGET"
@@ -0,0 +1,188 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+/*
+ * Runtime of the fuzzing backend (see cbmc_compat.h): runs the harness() entry point of a proof or benchmark harness
+ * once per fuzzer input, with every nondeterministic value drawn from the bytes of the input.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <digest_utils.h>
+#include <sanitizer/asan_interface.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#undef malloc
+
+void harness(void);
+
+/* Unread bytes of the current input. */
+static const uint8_t *fuzz_data;
+static size_t fuzz_size;
+
+/* Where fuzz_assume() returns to when the input does not satisfy an assumption. */
+static jmp_buf fuzz_rejected;
+
+void fuzz_fill(void *dst, size_t len) {
+    size_t available = len < fuzz_size ? len : fuzz_size;
+    memcpy(dst, fuzz_data, available);
+    memset((uint8_t *)dst + available, 0, len - available);
+    fuzz_data += available;
+    fuzz_size -= available;
+}
+
+#define DEFINE_NONDET(type, name)         \
+    type nondet_##name(void) {            \
+        type value;                       \
+        fuzz_fill(&value, sizeof(value)); \
+        return value;                     \
+    }
+
+DEFINE_NONDET(char, char)
+DEFINE_NONDET(unsigned char, unsigned_char)
+DEFINE_NONDET(int, int)
+DEFINE_NONDET(unsigned int, uint)
+DEFINE_NONDET(long, long)
+DEFINE_NONDET(size_t, size_t)
+DEFINE_NONDET(uint8_t, uint8_t)
+DEFINE_NONDET(uint16_t, uint16_t)
+DEFINE_NONDET(uint32_t, uint32_t)
+DEFINE_NONDET(uint64_t, uint64_t)
+
+bool nondet_bool(void) {
+    return nondet_unsigned_char() & 1;
+}
+
+void fuzz_assume(bool cond) {
+    if (!cond) longjmp(fuzz_rejected, 1);
+}
+
+void fuzz_assert(bool cond, const char *msg) {
+    if (cond) return;
+    fprintf(stderr, "model assertion failed: %s\n", msg);
+    abort();
+}
+
+/*
+ * Larger allocations fail, like allocations exceeding CBMC's maximum object size under --malloc-fail-null. Harnesses
+ * draw sizes from the input, which would otherwise exhaust the memory of the fuzzer.
+ */
+#ifndef FUZZ_MAX_ALLOCATION
+#    define FUZZ_MAX_ALLOCATION ((size_t)1 << 20)
+#endif
+
+void *fuzz_malloc(size_t size) {
+    void *ptr = size <= FUZZ_MAX_ALLOCATION ? malloc(size) : NULL;
+    if (ptr != NULL) fuzz_fill(ptr, size);
+    return ptr;
+}
+
+/* Finds the heap block, stack variable or global that ptr points into; returns false for unknown memory. */
+static bool fuzz_locate(const void *ptr, uint8_t **start, size_t *size) {
+    char name[1];
+    void *region_address = NULL;
+    size_t region_size   = 0;
+    if (ptr == NULL) return false;
+    __asan_locate_address((void *)ptr, name, sizeof(name), &region_address, &region_size);
+    if (region_address == NULL || (const uint8_t *)ptr < (uint8_t *)region_address ||
+        (const uint8_t *)ptr > (uint8_t *)region_address + region_size)
+        return false;
+    *start = region_address;
+    *size  = region_size;
+    return true;
+}
+
+/*
+ * Pointers read from input bytes are wild: their shadow memory may well be clean while the pages are not mapped, so
+ * the range must also lie within an object that ASan knows of.
+ */
+bool fuzz_is_addressable(const void *ptr, size_t len) {
+    uint8_t *start;
+    size_t size;
+    if (len == 0) return true;
+    if (!fuzz_locate(ptr, &start, &size) || len > size - (size_t)((const uint8_t *)ptr - start)) return false;
+    return __asan_region_is_poisoned((void *)ptr, len) == NULL;
+}
+
+size_t fuzz_object_size(const void *ptr) {
+    uint8_t *start;
+    size_t size;
+    return fuzz_locate(ptr, &start, &size) ? size : 0;
+}
+
+size_t fuzz_pointer_offset(const void *ptr) {
+    uint8_t *start;
+    size_t size;
+    return fuzz_locate(ptr, &start, &size) ? (size_t)((const uint8_t *)ptr - start) : (size_t)(uintptr_t)ptr;
+}
+
+bool fuzz_same_object(const void *a, const void *b) {
+    uint8_t *start_a, *start_b;
+    size_t size_a, size_b;
+    if (!fuzz_locate(a, &start_a, &size_a) || !fuzz_locate(b, &start_b, &size_b)) return a == b;
+    return start_a == start_b;
+}
+
+void fuzz_havoc_object(void *ptr) {
+    uint8_t *start;
+    size_t size;
+    if (fuzz_locate(ptr, &start, &size)) fuzz_fill(start, size);
+}
+
+/* Uninterpreted digest functions of LIBCRYPTO_MODEL_UF_DIGESTS (see digest_utils.h), as fixed hash functions. */
+static uint64_t fuzz_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+digest_fingerprint __CPROVER_uninterpreted_digest_absorb(digest_fingerprint fingerprint, unsigned char byte) {
+    return fuzz_mix(fingerprint * 0x100000001b3ULL + byte + 1);
+}
+
+unsigned char __CPROVER_uninterpreted_digest_output(
+    int algorithm, digest_fingerprint message, digest_fingerprint key, size_t index) {
+    return (unsigned char)fuzz_mix(fuzz_mix(fuzz_mix(message) ^ key) + ((uint64_t)algorithm << 32) + index);
+}
+
+/* Harnesses never free their objects, so leaks are expected and not reported. */
+int __lsan_is_turned_off(void) {
+    return 1;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    fuzz_data = data;
+    fuzz_size = size;
+    if (setjmp(fuzz_rejected) == 0) harness();
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+/* Runs every file given on the command line as one input, e.g. to replay a corpus without libFuzzer. */
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        FILE *file = fopen(argv[i], "rb");
+        if (file == NULL) {
+            perror(argv[i]);
+            return 1;
+        }
+        uint8_t *data = NULL;
+        size_t size = 0, capacity = 0, n;
+        do {
+            if (size == capacity) data = realloc(data, capacity = capacity * 2 + 4096);
+            n = fread(data + size, 1, capacity - size, file);
+            size += n;
+        } while (n > 0);
+        fclose(file);
+        LLVMFuzzerTestOneInput(data, size);
+        free(data);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,20 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+/*
+ * Replaces the system <assert.h> in the fuzzing backend (see cbmc_compat.h), independently of NDEBUG. The assert()
+ * calls of the model check the preconditions of the overrides and abort like a failed __CPROVER_assert(), so that the
+ * fuzzer reports the inputs that CBMC reports as violations. Harnesses skip the inputs outside of the precondition of
+ * the function under test by assuming its __CPROVER_requires clauses (see fuzz/requires_wrapper.py).
+ */
+
+#include <cbmc_compat.h>
+
+#undef assert
+#define assert(cond) fuzz_assert((cond), "assert(" #cond ")")
+
+#ifndef __cplusplus
+#    define static_assert _Static_assert
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef CBMC_COMPAT_H
+#define CBMC_COMPAT_H
+
+/*
+ * Native build of the model and its harnesses, driven by the bytes of a fuzzer input (see fuzz/build_fuzz.sh). This
+ * header is force-included into every translation unit and maps the CBMC built-ins onto fuzz_runtime.c:
+ *
+ *   nondet_*(), malloc()             values and fresh memory are drawn from the input, zeros once it is exhausted
+ *   __CPROVER_assume(c)              ends the run on the current input early when c does not hold
+ *   __CPROVER_assert(c, msg)         aborts, so that the fuzzer records the input as a crash
+ *   __CPROVER_havoc_slice/object()   fill the bytes with input bytes
+ *   __CPROVER_r_ok/w_ok/rw_ok()      ask ASan whether every byte of the range is addressable
+ *   __CPROVER_OBJECT_SIZE() etc.     use the heap block, stack variable or global that ASan locates for the pointer
+ *   __CPROVER_atomic_begin/end()     are no-ops: inputs run on a single thread
+ *
+ * Function contract clauses expand to nothing, so the fuzzer runs the bodies that the contracts summarize (a proof
+ * harness assumes the requires clauses of the function under test, see fuzz/requires_wrapper.py). Values read from
+ * uninitialized local variables are not drawn from the input, so the model and the harnesses take every unconstrained
+ * value from nondet_*() or from malloc'ed memory.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+void fuzz_assume(bool cond);
+void fuzz_assert(bool cond, const char *msg);
+void fuzz_fill(void *dst, size_t len);
+void *fuzz_malloc(size_t size);
+bool fuzz_is_addressable(const void *ptr, size_t len);
+size_t fuzz_object_size(const void *ptr);
+size_t fuzz_pointer_offset(const void *ptr);
+bool fuzz_same_object(const void *a, const void *b);
+void fuzz_havoc_object(void *ptr);
+
+#define __CPROVER_requires(...)
+#define __CPROVER_ensures(...)
+#define __CPROVER_assigns(...)
+#define __CPROVER_frees(...)
+
+#define __CPROVER_assume(cond) fuzz_assume(cond)
+#define __CPROVER_assert(cond, msg) fuzz_assert((cond), (msg))
+#define __CPROVER_cover(cond) ((void)(cond))
+#define __CPROVER_havoc_slice(ptr, len) fuzz_fill((ptr), (len))
+#define __CPROVER_havoc_object(ptr) fuzz_havoc_object(ptr)
+#define __CPROVER_r_ok(ptr, len) fuzz_is_addressable((ptr), (len))
+#define __CPROVER_w_ok(ptr, len) fuzz_is_addressable((ptr), (len))
+#define __CPROVER_rw_ok(ptr, len) fuzz_is_addressable((ptr), (len))
+#define __CPROVER_OBJECT_SIZE(ptr) fuzz_object_size(ptr)
+#define __CPROVER_POINTER_OFFSET(ptr) fuzz_pointer_offset(ptr)
+#define __CPROVER_same_object(a, b) fuzz_same_object((a), (b))
+#define __CPROVER_atomic_begin() ((void)0)
+#define __CPROVER_atomic_end() ((void)0)
+
+/* Like CBMC's malloc(), which returns unconstrained memory. Only allocations beyond FUZZ_MAX_ALLOCATION fail. */
+#define malloc(size) fuzz_malloc(size)
+
+#endif /* CBMC_COMPAT_H */
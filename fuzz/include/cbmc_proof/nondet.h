@@ -0,0 +1,26 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef CBMC_PROOF_NONDET_H
+#define CBMC_PROOF_NONDET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Nondeterministic values of the fuzzing backend, drawn from the input by fuzz_runtime.c (see cbmc_compat.h). */
+bool nondet_bool(void);
+char nondet_char(void);
+unsigned char nondet_unsigned_char(void);
+int nondet_int(void);
+unsigned int nondet_uint(void);
+long nondet_long(void);
+size_t nondet_size_t(void);
+uint8_t nondet_uint8_t(void);
+uint16_t nondet_uint16_t(void);
+uint32_t nondet_uint32_t(void);
+uint64_t nondet_uint64_t(void);
+
+#endif /* CBMC_PROOF_NONDET_H */
@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef MAKE_COMMON_DATA_STRUCTURES_H
+#define MAKE_COMMON_DATA_STRUCTURES_H
+
+#include <assert.h>
+#include <proof_helpers/nondet.h>
+#include <proof_helpers/proof_allocators.h>
+
+#endif /* MAKE_COMMON_DATA_STRUCTURES_H */
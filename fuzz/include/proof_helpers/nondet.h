@@ -0,0 +1,11 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef PROOF_HELPERS_NONDET_H
+#define PROOF_HELPERS_NONDET_H
+
+#include <cbmc_proof/nondet.h>
+
+#endif /* PROOF_HELPERS_NONDET_H */
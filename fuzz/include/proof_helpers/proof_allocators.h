@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef PROOF_HELPERS_PROOF_ALLOCATORS_H
+#define PROOF_HELPERS_PROOF_ALLOCATORS_H
+
+#include <cbmc_proof/nondet.h>
+#include <stdlib.h>
+
+/* Allocates size bytes, or nothing when the input says so. */
+static inline void *can_fail_malloc(size_t size) {
+    return nondet_bool() ? NULL : malloc(size);
+}
+
+#endif /* PROOF_HELPERS_PROOF_ALLOCATORS_H */
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+
+"""Generates the checked entry point of a function under test for the fuzzing backend (see fuzz/build_fuzz.sh).
+
+CBMC assumes the __CPROVER_requires clauses of the function whose contract a proof enforces, so a proof harness may
+call it with any arguments. Natively the clauses expand to nothing. The generated fuzz_checked_<function>() assumes
+each of them with __CPROVER_assume() and then calls the function, so that the harness, compiled with
+-D<function>=fuzz_checked_<function>, skips inputs outside of the precondition. Calls from within the model still go to
+the function itself, and a precondition that the model violates fails its assert() as in CBMC.
+
+The output file includes the unit defining the function, which it replaces in the build, so that the clauses see the
+macros and static helpers of that unit. Preprocessor lines between the clauses are copied, as are the conditions they
+apply to.
+
+Usage: fuzz/requires_wrapper.py <function> <output.c>
+Prints the path of the replaced unit, or nothing (and writes no output) when source/*.c does not define the function.
+"""
+
+import glob
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def matching_paren(text, start):
+    """Index of the parenthesis closing the one at text[start]."""
+    depth = 0
+    for i in range(start, len(text)):
+        if text[i] == "(":
+            depth += 1
+        elif text[i] == ")":
+            depth -= 1
+            if depth == 0:
+                return i
+    raise ValueError("unbalanced parentheses")
+
+
+def strip_comments(line):
+    """line without its comments (the clauses of the model do not span comments over several lines)."""
+    return re.sub(r"/\*.*?\*/|//.*", "", line).rstrip()
+
+
+def find_definition(function):
+    """(unit path, signature text, lines of the contract clauses) of the definition of function, or None."""
+    start = re.compile(r"^[A-Za-z_].*\b%s\(" % re.escape(function))
+    for path in sorted(glob.glob(os.path.join(ROOT, "source", "*.c"))):
+        with open(path) as f:
+            lines = [strip_comments(line) for line in f.read().split("\n")]
+        for i, line in enumerate(lines):
+            if not start.match(line) or line.startswith(("static ", "#")):
+                continue
+            end, depth = i, 0
+            while end < len(lines):
+                if not lines[end].lstrip().startswith("#"):
+                    depth += lines[end].count("(") - lines[end].count(")")
+                    if depth == 0 and (lines[end] == "{" or lines[end].endswith((";", "{"))):
+                        break
+                end += 1
+            if end == len(lines) or lines[end] != "{":
+                continue  # A declaration, or a definition without contract clauses.
+            text = "\n".join(lines[i:end])
+            open_paren = text.index(function + "(") + len(function)
+            close_paren = matching_paren(text, open_paren)
+            clauses = text[close_paren + 1 :].split("\n")
+            return path, text[: close_paren + 1], clauses
+    return None
+
+
+def parameters(signature, function):
+    """Return type, parameter declarations and parameter names of a signature."""
+    head, params = signature.split(function + "(", 1)
+    params = params[:-1].strip()
+    declarations, depth, current = [], 0, ""
+    for c in params:
+        if c == "," and depth == 0:
+            declarations.append(current.strip())
+            current = ""
+            continue
+        depth += {"(": 1, ")": -1}.get(c, 0)
+        current += c
+    if current.strip() and current.strip() != "void":
+        declarations.append(current.strip())
+    names = [re.findall(r"[A-Za-z_]\w*", re.sub(r"\[.*\]", "", d))[-1] for d in declarations]
+    return head.strip(), declarations, names
+
+
+def requires_clauses(chunk):
+    """Conditions of the __CPROVER_requires clauses in a chunk of clause text."""
+    conditions = []
+    for match in re.finditer(r"__CPROVER_requires\(", chunk):
+        close = matching_paren(chunk, match.end() - 1)
+        conditions.append(" ".join(chunk[match.end() : close].split()))
+    return conditions
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    function, output = sys.argv[1:]
+    definition = find_definition(function)
+    if definition is None:
+        return 0
+    path, signature, clauses = definition
+    return_type, declarations, names = parameters(signature, function)
+
+    body, chunk = [], []
+    for line in clauses + ["#"]:
+        if line.lstrip().startswith("#"):
+            body += ["    __CPROVER_assume(%s);" % c for c in requires_clauses("\n".join(chunk))]
+            chunk = []
+            if line != "#":
+                body.append(line)
+        else:
+            chunk.append(line)
+    call = "%s(%s)" % (function, ", ".join(names))
+    body.append("    %s%s;" % ("" if return_type == "void" else "return ", call))
+
+    with open(output, "w") as f:
+        f.write("/* Generated by fuzz/requires_wrapper.py. */\n")
+        f.write('#include "%s"\n\n' % path)
+        f.write("%s fuzz_checked_%s(%s) {\n" % (return_type, function, ", ".join(declarations) or "void"))
+        f.write("\n".join(body) + "\n}\n")
+    print(path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
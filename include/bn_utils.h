@@ -7,9 +7,24 @@
 #define BN_UTILS_H
 
 #include <openssl/bn.h>
+#include <pool_utils.h>
 #include <stdbool.h>
 
+DECLARE_MODEL_POOL(BIGNUM, bignum)
+
 bool bignum_is_valid(BIGNUM *bn);
 BIGNUM *bignum_nondet_alloc();
+BIGNUM *bignum_nondet_valid_alloc();
+
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+void bignum_havoc_value(BIGNUM *bn);
+#endif
+
+/* Frees clause targets of BN_free(bn) when cond holds, for function contracts. */
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+#    define BIGNUM_FREES(cond, bn) (cond) && (bn) != NULL: (bn)
+#else
+#    define BIGNUM_FREES(cond, bn) (cond) && (bn) != NULL: (bn), (bn)->d
+#endif
 
 #endif /* BN_UTILS_H */
@@ -0,0 +1,57 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef CALL_COUNT_UTILS_H
+#define CALL_COUNT_UTILS_H
+
+#include <model_config.h>
+#include <stddef.h>
+
+/*
+ * Ghost call and byte counts of the hot-path APIs (see LIBCRYPTO_MODEL_CALL_COUNTS in model_config.h). A call counts
+ * when it is made, whether it succeeds or fails, and calls the model makes internally count as well: EVP_DigestSign()
+ * counts one EVP_DigestUpdate() and one EVP_PKEY_sign(), for instance. Size queries, i.e. calls with a NULL output
+ * buffer that only report the output length, are not counted. The bytes of a call are the length of its input data,
+ * or of its output for RAND_bytes(), and 0 for functions without either.
+ */
+enum model_call {
+    MODEL_CALL_RAND_BYTES,
+    MODEL_CALL_EVP_DIGEST_UPDATE,
+    MODEL_CALL_EVP_DIGEST_FINAL,        /* EVP_DigestFinal_ex(), also through EVP_DigestFinal(). */
+    MODEL_CALL_EVP_DIGEST,
+    MODEL_CALL_EVP_PKEY_SIGN,           /* Bytes: the length of the digest to sign. */
+    MODEL_CALL_EVP_DIGEST_VERIFY_FINAL, /* Bytes: the length of the signature. */
+    MODEL_CALL_EVP_PKEY_DERIVE,
+    MODEL_CALL_EVP_PKEY_ENCRYPT,
+    MODEL_CALL_EVP_PKEY_DECRYPT,
+    MODEL_CALL_EVP_ENCRYPT_UPDATE,      /* Also through EVP_CipherUpdate(); bytes include any AAD. */
+    MODEL_CALL_EVP_DECRYPT_UPDATE,      /* Likewise. */
+    MODEL_CALL_EVP_AEAD_CTX_SEAL,       /* EVP_AEAD_CTX_seal() and EVP_AEAD_CTX_seal_scatter(). */
+    MODEL_CALL_EVP_AEAD_CTX_OPEN,
+    MODEL_CALL_HMAC_UPDATE,
+    MODEL_CALL_HMAC_FINAL,
+    MODEL_CALL_HMAC,
+    MODEL_CALL_COUNT
+};
+
+#ifdef LIBCRYPTO_MODEL_CALL_COUNTS
+/* Counts one call with the given number of bytes. Defined in model_state.c, which must be linked in this mode. */
+void model_count_call(enum model_call call, size_t bytes);
+
+/* Helper function for CBMC proofs: returns the number of calls counted so far, saturating at SIZE_MAX. */
+size_t model_call_count(enum model_call call);
+
+/* Helper function for CBMC proofs: returns the bytes of the calls counted so far, saturating at SIZE_MAX. */
+size_t model_call_bytes(enum model_call call);
+
+/* Helper function for CBMC proofs: resets all counts, e.g. between two requests handled by one harness. */
+void model_reset_call_counts(void);
+
+#    define COUNT_CALL(call, bytes) model_count_call((call), (bytes))
+#else
+#    define COUNT_CALL(call, bytes) ((void)0)
+#endif
+
+#endif /* CALL_COUNT_UTILS_H */
@@ -0,0 +1,54 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef DIGEST_UTILS_H
+#define DIGEST_UTILS_H
+
+#include <model_config.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Uninterpreted digests (see LIBCRYPTO_MODEL_UF_DIGESTS in model_config.h). A digest context carries a fingerprint of
+ * the bytes absorbed so far, obtained by folding every byte into the previous fingerprint with an uninterpreted
+ * function: the fingerprint only depends on the sequence of bytes, not on how it was split into updates. Every byte of
+ * the output is an uninterpreted function of the algorithm, the fingerprints of the message and of the key (if any),
+ * and its index. Equal inputs thus give provably equal digests, while nothing is known about distinct inputs.
+ */
+typedef uint64_t digest_fingerprint;
+
+/* Fingerprint of the empty message, and key fingerprint of unkeyed digests. */
+#define DIGEST_FINGERPRINT_EMPTY ((digest_fingerprint)0)
+
+/* Algorithm identifier of HMAC with the digest algorithm (an enum evp_sha value), distinct from the digest itself. */
+#define DIGEST_ALGORITHM_HMAC(algorithm) (0x100 | (algorithm))
+
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    if defined(LIBCRYPTO_MODEL_CONCRETE_SHA1) || defined(LIBCRYPTO_MODEL_CONCRETE_SHA256) || \
+        defined(LIBCRYPTO_MODEL_CONCRETE_MD5)
+#        error "LIBCRYPTO_MODEL_UF_DIGESTS and LIBCRYPTO_MODEL_CONCRETE_* are mutually exclusive"
+#    endif
+
+digest_fingerprint __CPROVER_uninterpreted_digest_absorb(digest_fingerprint fingerprint, unsigned char byte);
+
+unsigned char __CPROVER_uninterpreted_digest_output(
+    int algorithm, digest_fingerprint message, digest_fingerprint key, size_t index);
+
+/* Folds the len bytes at data into fingerprint. */
+static inline digest_fingerprint digest_fingerprint_absorb(
+    digest_fingerprint fingerprint, const void *data, size_t len) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < len; i++) fingerprint = __CPROVER_uninterpreted_digest_absorb(fingerprint, bytes[i]);
+    return fingerprint;
+}
+
+/* Writes the md_len bytes of the digest of the given algorithm, message and key fingerprints to md. */
+static inline void digest_fingerprint_output(
+    unsigned char *md, size_t md_len, int algorithm, digest_fingerprint message, digest_fingerprint key) {
+    for (size_t i = 0; i < md_len; i++) md[i] = __CPROVER_uninterpreted_digest_output(algorithm, message, key, i);
+}
+#endif
+
+#endif /* DIGEST_UTILS_H */
@@ -6,32 +6,92 @@
 #ifndef EC_UTILS_H
 #define EC_UTILS_H
 
+#include <model_config.h>
 #include <openssl/ec.h>
+#include <pool_utils.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
+DECLARE_MODEL_POOL(EC_KEY, ec_key)
+
 int ec_key_get_reference_count(EC_KEY *key);
 
 bool ec_key_is_valid(EC_KEY *key);
 
 EC_KEY *ec_key_nondet_alloc();
 
+/*
+ * Valid-by-construction generators for proofs: each returns NULL when an allocation fails, or a fresh object graph that
+ * satisfies the validity predicate of its type without any assumption on the pointers. depth bounds the nesting of
+ * optional objects (see ec_key_nondet_valid_alloc).
+ */
+EC_GROUP *ec_group_nondet_valid_alloc();
+EC_KEY *ec_key_nondet_valid_alloc(int depth);
+
 void ec_key_unconditional_free(EC_KEY *key);
 
-/**
- * Initializes a fixed nondeterministic value meant to represent the maximum
- * possible amount of decrypted data to be written to the output buffer
- * (see EVP_PKEY_encrypt for an example of its use).
+/*
+ * Frees clause targets of EC_GROUP_free(group) and EC_KEY_free(key), for function contracts: the objects that are
+ * released when cond holds. An EC_KEY is only released together with its last reference.
+ */
+#define EC_GROUP_FREES(cond, group) \
+    (cond) && (group) != NULL: (group); BIGNUM_FREES((cond) && (group) != NULL, (group)->order)
+#define EC_KEY_FREES(cond, key)                                                      \
+    (cond) && (key) != NULL && (key)->references == 1: (key);                        \
+    EC_GROUP_FREES((cond) && (key) != NULL && (key)->references == 1, (key)->group); \
+    BIGNUM_FREES((cond) && (key) != NULL && (key)->references == 1, (key)->priv_key)
+
+/* Assigns clause target of EC_KEY_free(key) when cond holds, for function contracts. */
+#define EC_KEY_RELEASE_ASSIGNS(cond, key) (cond) && (key) != NULL: (key)->references
+
+/*
+ * Size in bytes of a field element of the named curve nid, which is P-256 or P-384: the only curves of the model (see
+ * EC_GROUP_new_by_curve_name).
+ */
+#define EC_CURVE_FIELD_SIZE(nid) ((nid) == NID_X9_62_prime256v1 ? 32 : 48)
+
+/* Size in bytes of the octet string encoding of the public key of key (see i2o_ECPublicKey), in its conversion form. */
+#define EC_PUBLIC_KEY_ENCODING_SIZE(key) \
+    (1 + ((key)->conv_form == POINT_CONVERSION_COMPRESSED ? 1 : 2) * EC_CURVE_FIELD_SIZE((key)->group->curve_name))
+
+/*
+ * Largest DER encoding of an ECDSA signature on curve nid, as returned by ECDSA_size(): a SEQUENCE of two INTEGERs,
+ * each of which may need a leading zero octet on top of the field size. 72 bytes for P-256 and 104 for P-384.
+ */
+#define ECDSA_SIG_DER_MAX_SIZE(nid) (2 + 2 * (2 + 1 + EC_CURVE_FIELD_SIZE(nid)))
+
+/* Largest DER encoding of an ECDSA signature on any curve of the model. */
+#define ECDSA_SIG_MAX_DER_SIZE ECDSA_SIG_DER_MAX_SIZE(NID_secp384r1)
+
+#ifndef LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE
+/* Global upper cap on every bound in the output size registry below (see model_config.h). */
+#    define LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE INT_MAX
+#endif
+
+/*
+ * Registry of fixed nondeterministic values, each meant to represent the maximum possible amount of data a family of
+ * operations writes to its output buffer (see EVP_PKEY_sign for an example of its use). A bound is chosen in
+ * (0, SIZE_BOUND_CAP(which)] when it is first initialized or used, and stays fixed afterwards.
  */
+enum output_size_bound {
+    SIGNATURE_SIZE_BOUND,
+    DERIVATION_SIZE_BOUND,
+    ENCRYPTION_SIZE_BOUND,
+    DECRYPTION_SIZE_BOUND,
+    NUM_SIZE_BOUNDS
+};
+
+/* (Re-)initializes the given bound to a fresh nondeterministic value. */
+void initialize_size_bound(enum output_size_bound which);
+
+/* Returns the given bound, initializing it first if needed. */
+size_t size_bound(enum output_size_bound which);
+
+/* Shorthands for initialize_size_bound()/size_bound() of the individual registry entries. */
 void initialize_max_decryption_size();
 
 void initialize_max_derivation_size();
 
-/**
- * Initializes a fixed nondeterministic value meant to represent the maximum
- * possible amount of encrypted data to be written to the output buffer
- * (see EVP_PKEY_decrypt for an example of its use).
- */
 void initialize_max_encryption_size();
 
 void initialize_max_signature_size();
@@ -44,7 +104,37 @@ size_t max_encryption_size();
 
 size_t max_signature_size();
 
-void write_unconstrained_data(unsigned char *out, size_t len);
+/* State of the registry, only exposed so that function contracts can refer to it through the macros below. */
+extern size_t output_size_bounds[NUM_SIZE_BOUNDS];
+extern bool output_size_bound_is_initialized[NUM_SIZE_BOUNDS];
+
+/*
+ * Cap of the given bound. Without RSA keys (LIBCRYPTO_MODEL_PKEY_EC_ONLY or LIBCRYPTO_MODEL_PKEY_NONE), every signature
+ * is an ECDSA signature, so the signature size bound does not exceed ECDSA_SIG_MAX_DER_SIZE.
+ */
+#if defined(LIBCRYPTO_MODEL_PKEY_EC_ONLY) || defined(LIBCRYPTO_MODEL_PKEY_NONE)
+#    define SIZE_BOUND_CAP(which)                                                                    \
+        ((which) == SIGNATURE_SIZE_BOUND && ECDSA_SIG_MAX_DER_SIZE < LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE \
+             ? (size_t)ECDSA_SIG_MAX_DER_SIZE                                                        \
+             : (size_t)LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE)
+#else
+#    define SIZE_BOUND_CAP(which) ((size_t)LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE)
+#endif
+
+/* Largest value the given bound can take: its value once fixed, SIZE_BOUND_CAP(which) before. */
+#define SIZE_BOUND_UPPER(which) \
+    (output_size_bound_is_initialized[which] ? output_size_bounds[which] : SIZE_BOUND_CAP(which))
+
+/* Assigns clause targets of a function that may fix the given bound. */
+#define SIZE_BOUND_ASSIGNS(which) output_size_bounds[which], output_size_bound_is_initialized[which]
+
+/* Ensures clause of a function that may fix the given bound: a bound never changes once fixed, and is in range. */
+#define SIZE_BOUND_IS_STABLE(which)                                               \
+    ((!__CPROVER_old(output_size_bound_is_initialized[which]) ||                  \
+      (output_size_bound_is_initialized[which] &&                                 \
+       output_size_bounds[which] == __CPROVER_old(output_size_bounds[which]))) && \
+     (!output_size_bound_is_initialized[which] ||                                 \
+      (0 < output_size_bounds[which] && output_size_bounds[which] <= SIZE_BOUND_CAP(which))))
 
 unsigned char nondet_unsigned_char();
 
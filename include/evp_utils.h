@@ -7,7 +7,9 @@
 #define EVP_UTILS_H
 
 #include <ec_utils.h>
+#include <havoc_utils.h>
 #include <openssl/evp.h>
+#include <pool_utils.h>
 
 #define IMPLIES(a, b) (!(a) || (b))
 /**
@@ -16,6 +18,10 @@
  */
 #define IFF(a, b) (!!(a) == !!(b))
 
+DECLARE_MODEL_POOL(EVP_PKEY, evp_pkey)
+DECLARE_MODEL_POOL(EVP_MD_CTX, evp_md_ctx)
+DECLARE_MODEL_POOL(EVP_CIPHER_CTX, evp_cipher_ctx)
+
 size_t evp_md_ctx_get_digest_size(EVP_MD_CTX *ctx);
 
 EVP_PKEY *evp_md_ctx_get0_evp_pkey(EVP_MD_CTX *ctx);
@@ -26,6 +32,15 @@ bool evp_md_ctx_is_valid(EVP_MD_CTX *ctx);
 
 EVP_MD_CTX *evp_md_ctx_nondet_alloc();
 
+/*
+ * Valid-by-construction generators for proofs, like ec_key_nondet_valid_alloc(): each returns NULL when an allocation
+ * fails, or a fresh object graph that satisfies the validity predicate of its type. depth bounds the nesting of
+ * optional objects, e.g. depth 3 reaches EVP_PKEY_CTX -> EVP_PKEY -> EC_KEY -> private key. A non-NULL shared object
+ * is referenced instead of generating a fresh one, so that several generated objects can share one key.
+ */
+EVP_MD_CTX *evp_md_ctx_nondet_valid_alloc(int depth, EVP_PKEY *shared_pkey);
+EVP_PKEY_CTX *evp_pkey_ctx_nondet_valid_alloc(int depth, EVP_PKEY *shared_pkey);
+
 void evp_md_ctx_set0_evp_pkey(EVP_MD_CTX *ctx, EVP_PKEY *pkey);
 
 void evp_md_ctx_shallow_free(EVP_MD_CTX *ctx);
@@ -36,8 +51,147 @@ bool evp_pkey_is_valid(EVP_PKEY *pkey);
 
 EVP_PKEY *evp_pkey_nondet_alloc();
 
+EVP_PKEY *evp_pkey_nondet_valid_alloc(int depth, EC_KEY *shared_ec_key);
+
 void evp_pkey_set0_ec_key(EVP_PKEY *pkey, EC_KEY *ec);
 
 void evp_pkey_unconditional_free(EVP_PKEY *pkey);
 
+bool evp_pkey_ctx_is_valid(EVP_PKEY_CTX *ctx);
+
+bool evp_cipher_is_valid(EVP_CIPHER *cipher);
+
+bool evp_cipher_ctx_is_valid(EVP_CIPHER_CTX *ctx);
+
+bool evp_aead_is_valid(const EVP_AEAD *aead);
+
+bool evp_aead_ctx_is_valid(const EVP_AEAD_CTX *ctx);
+
+bool evp_md_is_valid(EVP_MD *md);
+
+bool evp_encode_ctx_is_valid(const EVP_ENCODE_CTX *ctx);
+
+bool evp_decode_ctx_is_valid(const EVP_ENCODE_CTX *ctx);
+
+bool hmac_ctx_is_valid(HMAC_CTX *ctx);
+
+/* Shared by the EVP_PKEY_*_init() functions and EVP_DigestSignInit() and EVP_DigestVerifyInit(). */
+int evp_pkey_ctx_start_operation(EVP_PKEY_CTX *ctx, enum evp_pkey_ctx_operation operation);
+
+/*
+ * Descriptors of all supported digests, indexed by enum evp_sha (see evp_digest_override.c). The EVP_md5() ...
+ * EVP_sha512() getters return pointers into this table, and EVP_MD_size(), evp_md_is_valid() and the HMAC functions
+ * look digest properties up here, so that a concrete digest folds to a constant and a nondeterministic one costs a
+ * single array lookup.
+ */
+#define EVP_MD_TABLE_SIZE (EVP_SHA512 + 1)
+extern const EVP_MD evp_md_table[EVP_MD_TABLE_SIZE];
+
+/*
+ * Digest outputs of the EVP digest and HMAC functions. By default a digest is unconstrained; with
+ * LIBCRYPTO_MODEL_UF_DIGESTS it is an uninterpreted function of the algorithm and of the fingerprints of the message
+ * and key (see digest_utils.h), using the same algorithm identifiers as the low-level SHA functions.
+ */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define DIGEST_OUTPUT(md, md_len, algorithm, message, key) \
+        digest_fingerprint_output((md), (md_len), (algorithm), (message), (key))
+#else
+#    define DIGEST_OUTPUT(md, md_len, algorithm, message, key) write_unconstrained_data((md), (md_len))
+#endif
+
+/*
+ * Assigns clause targets of the state of an EVP_MD_CTX that absorbing message bytes updates, shared by the digest and
+ * the digest signing functions.
+ */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define EVP_MD_CTX_ABSORB_ASSIGNS(ctx) (ctx)->bytes_absorbed, (ctx)->fingerprint
+#else
+#    define EVP_MD_CTX_ABSORB_ASSIGNS(ctx) (ctx)->bytes_absorbed
+#endif
+
+/* Whether two digest contexts absorbed the same bytes, as far as the model tracks them. */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define EVP_MD_CTX_SAME_FINGERPRINT(a, b) ((a)->fingerprint == (b)->fingerprint)
+#else
+#    define EVP_MD_CTX_SAME_FINGERPRINT(a, b) true
+#endif
+
+/* The EC_KEY held by pkey, or NULL in configurations without EC keys (see LIBCRYPTO_MODEL_PKEY_* in model_config.h). */
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+#    define EVP_PKEY_EC_KEY(pkey) ((pkey)->ec_key)
+#else
+#    define EVP_PKEY_EC_KEY(pkey) ((EC_KEY *)NULL)
+#endif
+
+/* The public key context of the digest context ctx, always NULL with LIBCRYPTO_MODEL_MD_CTX_NO_PKEY. */
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+#    define EVP_MD_CTX_PCTX(ctx) ((EVP_PKEY_CTX *)NULL)
+#else
+#    define EVP_MD_CTX_PCTX(ctx) ((ctx)->pctx)
+#endif
+
+/*
+ * Whether pctx may be the public key context of a digest context: NULL or a valid EVP_PKEY_CTX, and always NULL with
+ * LIBCRYPTO_MODEL_MD_CTX_NO_PKEY, where the digest unit does not use the EVP_PKEY family.
+ */
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+#    define EVP_MD_CTX_PCTX_IS_VALID(pctx) ((pctx) == NULL)
+#else
+#    define EVP_MD_CTX_PCTX_IS_VALID(pctx) ((pctx) == NULL || evp_pkey_ctx_is_valid(pctx))
+#endif
+
+/*
+ * Whether pkey holds an EC key, and the size in bytes of an ECDSA signature by such a pkey (see EVP_PKEY_sign): the
+ * largest DER encoding on its curve, as in OpenSSL's EVP_PKEY_size().
+ */
+#define EVP_PKEY_HAS_EC_KEY(pkey) ((pkey) != NULL && EVP_PKEY_EC_KEY(pkey) != NULL)
+#define EVP_PKEY_ECDSA_SIZE(pkey) ((size_t)ECDSA_SIG_DER_MAX_SIZE(EVP_PKEY_EC_KEY(pkey)->group->curve_name))
+
+/*
+ * Signature buffer requirement and signature size guarantee of EVP_PKEY_sign() and EVP_DigestSignFinal() when signing
+ * with the public key context pctx, for function contracts. ECDSA signatures are sized by the curve of the key, other
+ * signatures by the signature size bound.
+ */
+#define EVP_PKEY_SIGNATURE_BUFFER_IS_VALID(pctx, sig, siglen)               \
+    ((sig) == NULL || (EVP_PKEY_HAS_EC_KEY((pctx)->pkey)                    \
+                           ? *(siglen) >= EVP_PKEY_ECDSA_SIZE((pctx)->pkey) \
+                           : *(siglen) >= SIZE_BOUND_UPPER(SIGNATURE_SIZE_BOUND)))
+#define EVP_PKEY_SIGNATURE_SIZE_IS_VALID(pctx, sig, siglen)                        \
+    (EVP_PKEY_HAS_EC_KEY((pctx)->pkey)                                             \
+         ? ((sig) == NULL ? *(siglen) == EVP_PKEY_ECDSA_SIZE((pctx)->pkey)         \
+                          : *(siglen) <= EVP_PKEY_ECDSA_SIZE((pctx)->pkey))        \
+         : (output_size_bound_is_initialized[SIGNATURE_SIZE_BOUND] &&              \
+            ((sig) == NULL ? *(siglen) == output_size_bounds[SIGNATURE_SIZE_BOUND] \
+                           : *(siglen) <= output_size_bounds[SIGNATURE_SIZE_BOUND])))
+
+/*
+ * Assigns and frees clause targets of EVP_PKEY_free(pkey) and EVP_PKEY_CTX_free(ctx) when cond holds, for function
+ * contracts: the reference counts that are decremented and the objects that are released along with their last
+ * reference.
+ */
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+#    define EVP_PKEY_RELEASE_ASSIGNS(cond, pkey)      \
+        (cond) && (pkey) != NULL: (pkey)->references; \
+        EC_KEY_RELEASE_ASSIGNS((cond) && (pkey) != NULL && (pkey)->references == 1, (pkey)->ec_key)
+#    define EVP_PKEY_FREES(cond, pkey)                               \
+        (cond) && (pkey) != NULL && (pkey)->references == 1: (pkey); \
+        EC_KEY_FREES((cond) && (pkey) != NULL && (pkey)->references == 1, (pkey)->ec_key)
+#else
+#    define EVP_PKEY_RELEASE_ASSIGNS(cond, pkey) (cond) && (pkey) != NULL: (pkey)->references
+#    define EVP_PKEY_FREES(cond, pkey) (cond) && (pkey) != NULL && (pkey)->references == 1: (pkey)
+#endif
+#define EVP_PKEY_CTX_RELEASE_ASSIGNS(cond, ctx) EVP_PKEY_RELEASE_ASSIGNS((cond) && (ctx) != NULL, (ctx)->pkey)
+#define EVP_PKEY_CTX_FREES(cond, ctx) \
+    (cond) && (ctx) != NULL: (ctx); EVP_PKEY_FREES((cond) && (ctx) != NULL, (ctx)->pkey)
+
+/*
+ * Assigns clause targets for the per-operation state of an EVP_CIPHER_CTX, and the predicate that holds once an
+ * operation has been started afresh by EVP_CipherInit_ex() and friends.
+ */
+#define EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx) \
+    (ctx)->data_remaining, (ctx)->data_processed, (ctx)->phase, (ctx)->aad_len, (ctx)->data_len
+#define EVP_CIPHER_CTX_OPERATION_IS_FRESH(ctx)                                                       \
+    ((ctx)->data_remaining == 0 && !(ctx)->data_processed && (ctx)->phase == EVP_CIPHER_PHASE_AAD && \
+     (ctx)->aad_len == 0 && (ctx)->data_len == 0)
+
 #endif
@@ -0,0 +1,84 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef FAILURE_UTILS_H
+#define FAILURE_UTILS_H
+
+#include <cbmc_proof/nondet.h>
+#include <model_config.h>
+#include <stdbool.h>
+
+/*
+ * Subsystems of the model whose failures can be injected independently. Each override that may nondeterministically
+ * fail tags its failure site with exactly one of these.
+ */
+#define LIBCRYPTO_MODEL_ASN1 (1U << 0)
+#define LIBCRYPTO_MODEL_BIO (1U << 1)
+#define LIBCRYPTO_MODEL_BN (1U << 2)
+#define LIBCRYPTO_MODEL_DH (1U << 3)
+#define LIBCRYPTO_MODEL_EC (1U << 4)
+#define LIBCRYPTO_MODEL_EVP_PKEY (1U << 5)
+#define LIBCRYPTO_MODEL_EVP_CIPHER (1U << 6)
+#define LIBCRYPTO_MODEL_EVP_DIGEST (1U << 7)
+#define LIBCRYPTO_MODEL_EVP_ENCODE (1U << 8)
+#define LIBCRYPTO_MODEL_HMAC (1U << 9)
+#define LIBCRYPTO_MODEL_MD5 (1U << 10)
+#define LIBCRYPTO_MODEL_RAND (1U << 11)
+#define LIBCRYPTO_MODEL_SHA (1U << 12)
+/* Allocation failures of the pooled allocators in pool_utils.h. */
+#define LIBCRYPTO_MODEL_ALLOC (1U << 13)
+
+#define LIBCRYPTO_MODEL_EVP                                                                                            \
+    (LIBCRYPTO_MODEL_EVP_PKEY | LIBCRYPTO_MODEL_EVP_CIPHER | LIBCRYPTO_MODEL_EVP_DIGEST | LIBCRYPTO_MODEL_EVP_ENCODE | \
+     LIBCRYPTO_MODEL_HMAC)
+#define LIBCRYPTO_MODEL_ALL ((1U << 14) - 1)
+
+#ifdef LIBCRYPTO_MODEL_FAIL_FREE
+#    ifdef LIBCRYPTO_MODEL_FAILURE_MASK
+#        error "LIBCRYPTO_MODEL_FAIL_FREE and LIBCRYPTO_MODEL_FAILURE_MASK are mutually exclusive"
+#    endif
+#    define LIBCRYPTO_MODEL_FAILURE_MASK 0U
+#endif
+
+#ifndef LIBCRYPTO_MODEL_FAILURE_MASK
+#    define LIBCRYPTO_MODEL_FAILURE_MASK LIBCRYPTO_MODEL_ALL
+#endif
+
+#ifdef LIBCRYPTO_MODEL_FAILURE_BUDGET
+/*
+ * Nondeterministically injects a failure, unless LIBCRYPTO_MODEL_FAILURE_BUDGET failures have already been injected
+ * in the current trace. Defined in model_state.c, which must be linked when the budget is enabled.
+ */
+bool inject_budgeted_failure(void);
+
+/* Helper function for CBMC proofs: returns the number of failures injected so far. */
+unsigned int injected_failure_count(void);
+
+#    define LIBCRYPTO_MODEL_NONDET_FAILURE() inject_budgeted_failure()
+#else
+#    define LIBCRYPTO_MODEL_NONDET_FAILURE() nondet_bool()
+#endif
+
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+/*
+ * Pushes an error of the given subsystem onto the error queue (see ERR_get_error) and returns true. Defined in
+ * err_override.c, which must be linked when the queue is enabled.
+ */
+bool err_queue_push_failure(unsigned int subsystem);
+
+#    define LIBCRYPTO_MODEL_RECORD_FAILURE(subsystem) err_queue_push_failure(subsystem)
+#else
+#    define LIBCRYPTO_MODEL_RECORD_FAILURE(subsystem) true
+#endif
+
+/*
+ * Nondeterministically decides whether the current call into the given subsystem fails. Evaluates to the constant
+ * false for subsystems that are not in LIBCRYPTO_MODEL_FAILURE_MASK, so their error paths are pruned before symex.
+ */
+#define inject_failure(subsystem)                                                                \
+    ((((LIBCRYPTO_MODEL_FAILURE_MASK) & (subsystem)) != 0) && LIBCRYPTO_MODEL_NONDET_FAILURE() && \
+     LIBCRYPTO_MODEL_RECORD_FAILURE(subsystem))
+
+#endif /* FAILURE_UTILS_H */
@@ -0,0 +1,27 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef HAVOC_UTILS_H
+#define HAVOC_UTILS_H
+
+#include <model_config.h>
+#include <stddef.h>
+
+/**
+ * Writes len bytes of unconstrained data to out. By default the entire object that out points into is havocked; with
+ * LIBCRYPTO_MODEL_PRECISE_HAVOC only the bytes [out, out + len) are (see model_config.h). Defined in model_havoc.c,
+ * which every family that writes unconstrained output links, so that e.g. the base64 or digest units do not depend on
+ * the EC unit.
+ */
+void write_unconstrained_data(unsigned char *out, size_t len);
+
+/* Assigns clause target covering what write_unconstrained_data(out, len) modifies, for function contracts. */
+#ifdef LIBCRYPTO_MODEL_PRECISE_HAVOC
+#    define UNCONSTRAINED_DATA(out, len) __CPROVER_object_upto((out), (len))
+#else
+#    define UNCONSTRAINED_DATA(out, len) __CPROVER_object_whole((out))
+#endif
+
+#endif /* HAVOC_UTILS_H */
@@ -0,0 +1,50 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef HEAP_UTILS_H
+#define HEAP_UTILS_H
+
+#include <model_config.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+ * Heap allocations of the model. Every override allocates through model_malloc() or model_realloc() and releases
+ * through model_free(), which are plain malloc(), realloc() and free() unless LIBCRYPTO_MODEL_HEAP_ACCOUNTING is
+ * defined (see model_config.h). Buffers that the model returns to the caller, e.g. the output of i2d_ASN1_INTEGER(),
+ * are released with OPENSSL_free().
+ */
+#ifdef LIBCRYPTO_MODEL_HEAP_ACCOUNTING
+/*
+ * Same as malloc(), realloc() and free(), and additionally keep the ghost counters below up to date. The size of a
+ * released object is the size that CBMC records for it. Defined in model_state.c, which must be linked in this mode.
+ * Only objects allocated by the model may be released by it: model_free() fails an assertion on any other object,
+ * e.g. a context that the harness allocated with malloc().
+ */
+void *model_malloc(size_t size);
+void *model_realloc(void *ptr, size_t size);
+void model_free(void *ptr);
+
+/* Helper function for CBMC proofs: returns the number of bytes allocated by the model and not freed yet. */
+size_t model_heap_live_bytes(void);
+
+/* Helper function for CBMC proofs: returns the number of objects allocated by the model and not freed yet. */
+size_t model_heap_live_objects(void);
+
+/*
+ * Helper function for CBMC proofs: returns the maximum of model_heap_live_bytes() so far. A model_realloc() counts the
+ * old and the new object at once.
+ */
+size_t model_heap_peak_bytes(void);
+
+/* Helper function for CBMC proofs: restarts the peak at the current live bytes, e.g. when a new session starts. */
+void model_heap_reset_peak(void);
+#else
+#    define model_malloc(size) malloc(size)
+#    define model_realloc(ptr, size) realloc((ptr), (size))
+#    define model_free(ptr) free(ptr)
+#endif
+
+#endif /* HEAP_UTILS_H */
@@ -0,0 +1,103 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef MD32_UTILS_H
+#define MD32_UTILS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Streaming and padding shared by the reference implementations of SHA-1, SHA-256 and MD5 (see
+ * LIBCRYPTO_MODEL_CONCRETE_* in model_config.h), after OpenSSL's crypto/md32_common.h. All three digests compress
+ * 64-byte blocks of 32-bit words and pad the message with its bit length; they only differ in their compression
+ * function and byte order. Every loop is bounded by a constant or by the length of the input, so CBMC unwinds them
+ * completely for fixed-size inputs.
+ */
+#define MD32_CBLOCK 64
+#define MD32_LAST_BLOCK (MD32_CBLOCK - 8)
+
+/* Compresses one MD32_CBLOCK-byte block into the chaining state of the digest context ctx. */
+typedef void (*md32_block_fn)(void *ctx, const unsigned char *block);
+
+/* Byte buffer and bit counter of a digest context, i.e. the data, num, Nl and Nh fields of its OpenSSL struct. */
+struct md32_stream {
+    unsigned char *buffer; /* MD32_CBLOCK bytes, of which the first *num are pending. */
+    unsigned int *num;
+    uint32_t *Nl;
+    uint32_t *Nh;
+};
+
+#define MD32_ROTL(x, n) ((uint32_t)(((x) << (n)) | ((x) >> (32 - (n)))))
+
+static inline uint32_t md32_load_be(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline uint32_t md32_load_le(const unsigned char *p) {
+    return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | (uint32_t)p[0];
+}
+
+static inline void md32_store_be(unsigned char *p, uint32_t x) {
+    p[0] = (unsigned char)(x >> 24);
+    p[1] = (unsigned char)(x >> 16);
+    p[2] = (unsigned char)(x >> 8);
+    p[3] = (unsigned char)x;
+}
+
+static inline void md32_store_le(unsigned char *p, uint32_t x) {
+    p[0] = (unsigned char)x;
+    p[1] = (unsigned char)(x >> 8);
+    p[2] = (unsigned char)(x >> 16);
+    p[3] = (unsigned char)(x >> 24);
+}
+
+/* Absorbs len bytes of data into stream, compressing every block that fills up into ctx. */
+static inline void md32_update(
+    void *ctx, struct md32_stream stream, md32_block_fn block, const unsigned char *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        stream.buffer[*stream.num] = data[i];
+        *stream.num += 1;
+        if (*stream.num == MD32_CBLOCK) {
+            block(ctx, stream.buffer);
+            *stream.num = 0;
+        }
+    }
+
+    // Same carry handling as HASH_UPDATE in md32_common.h: the bit count is a 64-bit value split in two words.
+    uint32_t low = *stream.Nl + (((uint32_t)len) << 3);
+    if (low < *stream.Nl) *stream.Nh += 1;
+    *stream.Nh += (uint32_t)((uint64_t)len >> 29);
+    *stream.Nl = low;
+}
+
+/*
+ * Pads the message absorbed into stream and compresses the last block(s) into ctx. The bit length is appended
+ * big-endian (SHA) or little-endian (MD5).
+ */
+static inline void md32_final(void *ctx, struct md32_stream stream, md32_block_fn block, bool big_endian) {
+    unsigned int num = *stream.num;
+
+    stream.buffer[num++] = 0x80;
+    if (num > MD32_LAST_BLOCK) {
+        while (num < MD32_CBLOCK) stream.buffer[num++] = 0;
+        block(ctx, stream.buffer);
+        num = 0;
+    }
+    while (num < MD32_LAST_BLOCK) stream.buffer[num++] = 0;
+
+    if (big_endian) {
+        md32_store_be(stream.buffer + MD32_LAST_BLOCK, *stream.Nh);
+        md32_store_be(stream.buffer + MD32_LAST_BLOCK + 4, *stream.Nl);
+    } else {
+        md32_store_le(stream.buffer + MD32_LAST_BLOCK, *stream.Nl);
+        md32_store_le(stream.buffer + MD32_LAST_BLOCK + 4, *stream.Nh);
+    }
+    block(ctx, stream.buffer);
+    *stream.num = 0;
+}
+
+#endif /* MD32_UTILS_H */
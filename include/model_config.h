@@ -0,0 +1,153 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef MODEL_CONFIG_H
+#define MODEL_CONFIG_H
+
+/*
+ * Model-wide configuration knobs. None of these are defined by default, which gives the most general (and most
+ * expensive) model. Proofs opt in by passing e.g. -DLIBCRYPTO_MODEL_PRECISE_HAVOC to goto-cc.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_PRECISE_HAVOC
+ * When defined, write_unconstrained_data() havocs exactly the len bytes that a function writes, instead of the whole
+ * object that contains the output buffer. Bytes of the object outside of [out, out + len) keep their values, which
+ * keeps them available for constant propagation when out is a slice of a larger buffer.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_FAIL_FREE
+ * When defined, none of the overrides nondeterministically fail: every failure injection site evaluates to constant
+ * success. Useful for a fast pass that only covers the happy path.
+ *
+ * LIBCRYPTO_MODEL_FAILURE_MASK
+ * Bitwise OR of the LIBCRYPTO_MODEL_<SUBSYSTEM> values in failure_utils.h. Only subsystems in the mask inject
+ * failures; defaults to LIBCRYPTO_MODEL_ALL. For instance -DLIBCRYPTO_MODEL_FAILURE_MASK=LIBCRYPTO_MODEL_EVP_PKEY only
+ * explores error paths of the EVP_PKEY functions. Cannot be combined with LIBCRYPTO_MODEL_FAIL_FREE.
+ *
+ * LIBCRYPTO_MODEL_FAILURE_BUDGET
+ * Maximum number of failures injected along any single trace, across all subsystems. Once the budget is used up all
+ * remaining calls succeed. Requires linking model_state.c, which holds the global failure counter. The function
+ * contracts of the overrides do not describe the counter, so they must not replace calls in this mode.
+ *
+ * LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+ * When defined, every injected failure pushes an error code onto a ring buffer of this many entries, which
+ * ERR_get_error(), ERR_peek_error(), ERR_peek_last_error() and ERR_clear_error() operate on in constant time. Once the
+ * queue is full the oldest error is dropped, so a loop draining the queue runs at most LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+ * times. Without it the queue is always empty. Requires linking err_override.c; as with the failure budget, the
+ * function contracts do not describe the queue, so they must not replace calls in this mode.
+ *
+ * LIBCRYPTO_MODEL_CALL_COUNTS
+ * When defined, the model counts the calls to its hot-path APIs (RAND_bytes(), EVP_DigestUpdate(), EVP_PKEY_sign(),
+ * etc.) and the bytes passed to them, which harnesses read with model_call_count() and model_call_bytes() (see
+ * call_count_utils.h). A harness can then assert budgets such as "at most one signature per request" on every path.
+ * Requires linking model_state.c, which holds the counters; the function contracts do not describe them either.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_HEAP_ACCOUNTING
+ * When defined, every heap allocation of the model goes through a wrapper that keeps ghost counters of the live bytes,
+ * live objects and peak bytes (see heap_utils.h). Harnesses read them with model_heap_live_bytes() etc., e.g. to prove
+ * that a session stays under a memory bound and that its teardown frees everything. Objects taken from the pools of
+ * LIBCRYPTO_MODEL_POOL_SIZE are static and not counted. Requires linking model_state.c; as with the call counts, the
+ * function contracts do not describe the counters.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_THREADS
+ * When defined, the model may be called from several threads: the reference count updates of EVP_PKEY, EC_KEY and DH
+ * are atomic (see refcount_utils.h), and CRYPTO_THREAD_read_lock() and CRYPTO_THREAD_write_lock() block until the lock
+ * is available (see thread_utils.h). With CBMC's support for threads, a harness that shares objects between threads
+ * can then be checked for uses after free. Without it, the model assumes a single thread and taking a lock that is
+ * already held fails an assertion.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+ * When defined, an EVP_MD_CTX never carries a public key context: evp_md_ctx_is_valid() requires ctx->pctx to be NULL,
+ * and EVP_MD_CTX_free(), EVP_MD_CTX_cleanup(), EVP_MD_CTX_reset() and EVP_MD_CTX_copy_ex() skip the EVP_PKEY_CTX
+ * release along with everything it may free. Meant for harnesses that only digest, which then link
+ * evp_digest_override.c without the EVP_PKEY family; EVP_DigestSignInit() and EVP_DigestVerifyInit() fail an assertion.
+ */
+
+/*
+ * Model profiles
+ * proofs/manifest.json names the knob combinations that proofs share, e.g. "no-pkey-digest" for
+ * LIBCRYPTO_MODEL_MD_CTX_NO_PKEY or "no-ec-key-pkey" for LIBCRYPTO_MODEL_PKEY_NONE. A proof selects one with its
+ * "profile" and is then linked against a model built with those knobs, so that every function keeps exactly one
+ * definition instead of being replaced by a hand-written stub.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE
+ * Upper cap on all bounds of the output size registry in ec_utils.h (signature, derivation, encryption and decryption
+ * sizes). Defaults to INT_MAX. A small cap, e.g. -DLIBCRYPTO_MODEL_MAX_OUTPUT_SIZE=512, keeps buffer lengths narrow.
+ * EC encodings (points and ECDSA signatures) do not use the registry: their sizes follow from the curve of the key.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_DETERMINISTIC_RAND
+ * When defined, RAND_bytes() writes a fixed function of a per-call counter instead of unconstrained bytes: byte i of
+ * the output of the n-th successful call (counting from 0) is (unsigned char)(n + i). Nonces and IVs then become
+ * constants that the solver can propagate, e.g. in functional-equivalence proofs. Only sound for properties that do
+ * not depend on the generated values.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_CONCRETE_SHA1, LIBCRYPTO_MODEL_CONCRETE_SHA256, LIBCRYPTO_MODEL_CONCRETE_MD5
+ * Each replaces the unconstrained output of one digest family by a real implementation (see md32_utils.h): SHA1_*(),
+ * SHA224_*() and SHA256_*() (including the one-shot SHA1(), SHA224() and SHA256()), or MD5_*(). Meant for
+ * differential and test-vector proofs on small, fixed inputs, which CBMC fully unwinds: one 80 or 64 round compression
+ * per 64-byte block. The EVP digest functions and SHA-384/SHA-512 keep their unconstrained outputs.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_UF_DIGESTS
+ * When defined, the outputs of SHA*_Final(), SHA*(), EVP_DigestFinal_ex(), EVP_Digest(), HMAC_Final() and HMAC() are
+ * uninterpreted functions of the algorithm, message and key (see digest_utils.h) instead of unconstrained bytes. Equal
+ * inputs thus provably give equal digests, however the message was split into updates and whether it went through EVP
+ * or the low-level SHA functions; nothing is implied for distinct inputs. The function contracts only assign the
+ * fingerprints, so equalities need the bodies. Cannot be combined with LIBCRYPTO_MODEL_CONCRETE_*.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_BIGNUM_LITE
+ * When defined, a BIGNUM is a single allocation carrying an abstract value (is_zero and num_bits) instead of a pointer
+ * to a separately allocated limb array. Halves the number of heap objects behind every BN_new(), DH_new(), etc.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_POOL_SIZE
+ * When defined, EVP_PKEY, EVP_MD_CTX, EVP_CIPHER_CTX, EC_KEY, BIGNUM and DH objects are allocated from fixed-capacity
+ * static pools of this many objects per type instead of malloc() (see pool_utils.h). Allocation only fails when a
+ * pool is exhausted or through LIBCRYPTO_MODEL_ALLOC failure injection.
+ * Contracts of constructors and destructors assume malloc() and free(), so do not replace those calls in this mode.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_SINGLE_OWNER
+ * When defined, the reference counts of EVP_PKEY and EC_KEY objects are 8-bit instead of int (see refcount_utils.h).
+ * Meant for harnesses in which keys are only shared with the model itself; taking more than UCHAR_MAX references to
+ * one object is reported as an assertion failure.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_PARSE_CACHE
+ * When defined, d2i_DHparams(), PEM_read_bio_PUBKEY() and PEM_read_bio_PrivateKey() memoize their most recent
+ * successful parse. Parsing the same input again (the same unread bytes at the same address) returns the cached object
+ * with one more reference instead of a freshly allocated one, and consumes as many bytes as the cached parse, like a
+ * caller that memoizes its parses. The input must not be modified between parses. The cache holds its own reference,
+ * so cached objects are never freed.
+ */
+
+/*
+ * LIBCRYPTO_MODEL_PKEY_EC_ONLY, LIBCRYPTO_MODEL_PKEY_RSA_ONLY, LIBCRYPTO_MODEL_PKEY_NONE
+ * At most one may be defined. Each restricts EVP_PKEY to one key type (EC, RSA or no key material at all) and strips
+ * the state and validity checks of the other types from EVP_PKEY and EVP_PKEY_CTX. Calling a function that is
+ * specific to a stripped key type, e.g. EVP_PKEY_set1_EC_KEY() with LIBCRYPTO_MODEL_PKEY_RSA_ONLY, fails an assertion.
+ */
+
+#endif /* MODEL_CONFIG_H */
@@ -14,16 +14,30 @@
 #    include <stdio.h>
 #endif
 #include <stdarg.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 #include <openssl/ossl_typ.h>
 
+#define BIO_TYPE_SOURCE_SINK 0x0400
+#define BIO_TYPE_MEM (1 | BIO_TYPE_SOURCE_SINK)
+
 typedef int pem_password_cb(char *buf, int size, int rwflag, void *u);
 
+const BIO_METHOD *BIO_s_mem(void);
+
+BIO *BIO_new(const BIO_METHOD *type);
+
 BIO *BIO_new_mem_buf(const void *buf, signed int len);
 
+int BIO_read(BIO *b, void *data, int dlen);
+
+int BIO_write(BIO *b, const void *data, int dlen);
+
+size_t BIO_ctrl_pending(BIO *b);
+
 EVP_PKEY *PEM_read_bio_PUBKEY(BIO *bp, EVP_PKEY **x, pem_password_cb *cb, void *u);
 
 EVP_PKEY *PEM_read_bio_PrivateKey(BIO *bp, EVP_PKEY **x, pem_password_cb *cb, void *u);
@@ -30,6 +30,11 @@
 /* Abstraction of the BIGNUM struct. */
 struct bignum_st {
     bool is_initialized;
+#    ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    /* Abstract value: no limb array, so a BIGNUM is a single allocation. */
+    bool is_zero;
+    int num_bits; /* Zero iff is_zero. */
+#    else
     unsigned long int *d; /* Pointer to an array of 'BN_BITS2' bit
                            * chunks. */
     int top;              /* Index of last used d +1. */
@@ -37,6 +42,7 @@ struct bignum_st {
     int dmax; /* Size of the d array. */
     int neg;  /* one if the number is negative */
     int flags;
+#    endif
 };
 
 BIGNUM *BN_new(void);
@@ -14,4 +14,30 @@
  * permissions and limitations under the License.
  */
 
-/* Empty header. */
+#ifndef HEADER_CRYPTO_H
+#define HEADER_CRYPTO_H
+
+#include <heap_utils.h>
+#include <stdbool.h>
+
+/* Allocations made for the caller, e.g. the output of i2d_ASN1_INTEGER(), are released with OPENSSL_free(). */
+#define OPENSSL_malloc(num) model_malloc(num)
+#define OPENSSL_free(addr) model_free(addr)
+
+/*
+ * Abstraction of a CRYPTO_RWLOCK: held by any number of readers or by one writer. See LIBCRYPTO_MODEL_THREADS in
+ * model_config.h for how the model blocks on a held lock.
+ */
+typedef struct crypto_rwlock_st {
+    int readers;
+    bool writer;
+} CRYPTO_RWLOCK;
+
+CRYPTO_RWLOCK *CRYPTO_THREAD_lock_new(void);
+int CRYPTO_THREAD_read_lock(CRYPTO_RWLOCK *lock);
+int CRYPTO_THREAD_write_lock(CRYPTO_RWLOCK *lock);
+int CRYPTO_THREAD_unlock(CRYPTO_RWLOCK *lock);
+void CRYPTO_THREAD_lock_free(CRYPTO_RWLOCK *lock);
+int CRYPTO_atomic_add(int *val, int amount, int *ret, CRYPTO_RWLOCK *lock);
+
+#endif
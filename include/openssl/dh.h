@@ -18,6 +18,7 @@
 #include <cbmc_proof/nondet.h>
 #include <openssl/bn.h>
 #include <openssl/ffc.h>
+#include <refcount_utils.h>
 
 #ifndef OPENSSL_DH_H
 #    define OPENSSL_DH_H
@@ -51,6 +52,16 @@ struct dh_st {
 
     /* Provider data */
     size_t dirty_cnt; /* If any key material changes, increment this */
+
+    model_refcount references;
+
+    /*
+     * Parameters shared by DHparams_dup(): a duplicate uses the p, q and g of the DH it was duplicated from, of which
+     * it holds a reference in params_owner, instead of copies. params_dups counts the duplicates sharing the
+     * parameters of a DH. Owners are never duplicates themselves, and only their DH_free() frees p, q and g.
+     */
+    DH *params_owner;
+    int params_dups;
 };
 
 struct dh_method {
@@ -60,8 +71,9 @@ struct dh_method {
 DH *DH_new(void);
 bool openssl_DH_is_valid(const DH *dh);
 void DH_free(DH *dh);
+int DH_up_ref(DH *dh);
 int DH_size(const DH *dh);
-DH *d2i_DHparams(DH **a, unsigned char **pp, long length);
+DH *d2i_DHparams(DH **a, const unsigned char **pp, long length);
 int DH_check(DH *dh, int *codes);
 void DH_get0_pqg(const DH *dh, const BIGNUM **p, const BIGNUM **q, const BIGNUM **g);
 void DH_get0_key(const DH *dh, const BIGNUM **pub_key, const BIGNUM **priv_key);
@@ -20,6 +20,7 @@
 #include <limits.h>
 
 #include <bn_utils.h>
+#include <refcount_utils.h>
 
 #include <openssl/asn1.h>
 #include <openssl/objects.h>
@@ -49,7 +50,7 @@ typedef struct ec_group_st EC_GROUP;
 
 /* Abstraction of the EC_KEY struct */
 struct ec_key_st {
-    int references;
+    model_refcount references;
     EC_GROUP *group;
     point_conversion_form_t conv_form;
     BIGNUM *priv_key;
@@ -75,7 +76,7 @@ int EC_KEY_generate_key(EC_KEY *key);
 void EC_KEY_free(EC_KEY *key);
 
 EC_KEY *o2i_ECPublicKey(EC_KEY **key, const unsigned char **in, long len);
-int i2o_ECPublicKey(EC_KEY *key, unsigned char **out);
+int i2o_ECPublicKey(const EC_KEY *key, unsigned char **out);
 
 void ECDSA_SIG_get0(const ECDSA_SIG *sig, const BIGNUM **pr, const BIGNUM **ps);
 int ECDSA_SIG_set0(ECDSA_SIG *sig, BIGNUM *r, BIGNUM *s);
@@ -17,12 +17,37 @@
 #ifndef HEADER_ERR_H
 #define HEADER_ERR_H
 
+#include <stddef.h>
 #include <stdio.h>
 
+#define ERR_LIB_NONE 1
+#define ERR_LIB_BN 3
+#define ERR_LIB_DH 5
+#define ERR_LIB_EVP 6
+#define ERR_LIB_ASN1 13
+#define ERR_LIB_CRYPTO 15
+#define ERR_LIB_EC 16
+#define ERR_LIB_BIO 32
+#define ERR_LIB_RAND 36
+
+#define ERR_PACK(l, f, r) ((((unsigned long)(l) & 0x0FFL) << 24L) | (((unsigned long)(f) & 0xFFFL) << 12L) | \
+                           (((unsigned long)(r) & 0xFFFL)))
+#define ERR_GET_LIB(l) (int)(((l) >> 24L) & 0x0FFL)
+#define ERR_GET_REASON(l) (int)((l) & 0xFFFL)
+
 void ERR_print_errors_fp(FILE *fp);
 
-signed int ERR_get_error(void);
+unsigned long ERR_get_error(void);
+
+unsigned long ERR_peek_error(void);
 
 unsigned long ERR_peek_last_error(void);
 
+void ERR_clear_error(void);
+
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+/* Helper function for CBMC proofs: returns the number of errors in the queue. */
+size_t err_queue_length(void);
+#endif
+
 #endif
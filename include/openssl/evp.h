@@ -17,56 +17,135 @@
 #ifndef HEADER_EVP_H
 #define HEADER_EVP_H
 
+#include <digest_utils.h>
+#include <model_config.h>
 #include <openssl/ec.h>
 #include <openssl/ossl_typ.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Key types supported by EVP_PKEY, selected by LIBCRYPTO_MODEL_PKEY_EC_ONLY, LIBCRYPTO_MODEL_PKEY_RSA_ONLY or
+ * LIBCRYPTO_MODEL_PKEY_NONE (see model_config.h). By default both EC and RSA are supported.
+ */
+#if defined(LIBCRYPTO_MODEL_PKEY_EC_ONLY) && defined(LIBCRYPTO_MODEL_PKEY_RSA_ONLY)
+#    error "LIBCRYPTO_MODEL_PKEY_EC_ONLY and LIBCRYPTO_MODEL_PKEY_RSA_ONLY are mutually exclusive"
+#endif
+#if defined(LIBCRYPTO_MODEL_PKEY_NONE) && \
+    (defined(LIBCRYPTO_MODEL_PKEY_EC_ONLY) || defined(LIBCRYPTO_MODEL_PKEY_RSA_ONLY))
+#    error "LIBCRYPTO_MODEL_PKEY_NONE cannot be combined with another LIBCRYPTO_MODEL_PKEY_* key type"
+#endif
+#if !defined(LIBCRYPTO_MODEL_PKEY_RSA_ONLY) && !defined(LIBCRYPTO_MODEL_PKEY_NONE)
+#    define LIBCRYPTO_MODEL_PKEY_HAS_EC
+#endif
+#if !defined(LIBCRYPTO_MODEL_PKEY_EC_ONLY) && !defined(LIBCRYPTO_MODEL_PKEY_NONE)
+#    define LIBCRYPTO_MODEL_PKEY_HAS_RSA
+#endif
 
 #define EVP_MAX_MD_SIZE 64                    /* Longest known is SHA512. */
+#define EVP_MAX_BLOCK_LENGTH 32               /* Longest block of any cipher. */
 #define EVP_PKEY_HKDF 1036                    /* Reference from obj_mac.h. */
 #define EVP_MD_CTX_FLAG_NON_FIPS_ALLOW 0x0008 /* Allow use of non FIPS digest in FIPS mode. */
 
 enum evp_aes { EVP_AES_128_GCM, EVP_AES_192_GCM, EVP_AES_256_GCM, EVP_AES_128_ECB };
 enum evp_sha { EVP_MD5, EVP_SHA1, EVP_SHA224, EVP_SHA256, EVP_SHA384, EVP_SHA512 };
 
+#define EVP_AEAD_DEFAULT_TAG_LENGTH 0 /* Selects the longest tag of the AEAD in EVP_AEAD_CTX_init(). */
+#define EVP_AEAD_MAX_KEY_LENGTH 80
+#define EVP_AEAD_MAX_NONCE_LENGTH 24
+#define EVP_AEAD_MAX_OVERHEAD 64
+#define EVP_AEAD_AES_GCM_TAG_LEN 16
+
+// An EVP_AEAD is an AEAD algorithm (BoringSSL's one-shot AEAD interface), of which the model has AES-GCM.
+typedef struct evp_aead_st {
+    enum evp_aes from; /* One of the GCM ciphers. */
+    size_t key_len;
+    size_t nonce_len;  /* Default nonce length; any non-empty nonce is accepted. */
+    size_t overhead;   /* Most bytes a ciphertext is longer than its plaintext, i.e. max_tag_len for GCM. */
+    size_t max_tag_len;
+} EVP_AEAD;
+
 // An EVP_AEAD_CTX represents an AEAD algorithm configured with a specific key
 // and message-independent IV.
 typedef struct evp_aead_ctx_st {
     /* See https://github.com/google/boringssl/blob/master/include/openssl/aead.h#L217 */
+    const EVP_AEAD *aead; /* NULL unless initialized by EVP_AEAD_CTX_init(). */
+    size_t tag_len;       /* In bytes, at most aead->max_tag_len. */
 } EVP_AEAD_CTX;
 
 /* Abstraction of the EVP_PKEY struct. */
 struct evp_pkey_st {
-    int references;
+    model_refcount references;
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
     EC_KEY *ec_key;
+#endif
+};
+
+/*
+ * Parameters of an EVP_PKEY_HKDF context, set through the EVP_PKEY_CTX_ctrl() macros of kdf.h. Salt, key and info are
+ * only recorded by length, since the model never reads them back.
+ */
+struct evp_pkey_hkdf_params {
+    const EVP_MD *md; /* NULL until EVP_PKEY_CTX_set_hkdf_md(). */
+    size_t salt_len;
+    bool is_key_set;
+    size_t key_len;
+    size_t info_len; /* Total of all EVP_PKEY_CTX_add1_hkdf_info() calls, at most HKDF_MAXBUF. */
+    int mode;        /* EVP_PKEY_HKDEF_MODE_*, EVP_PKEY_HKDEF_MODE_EXTRACT_AND_EXPAND by default. */
+};
+
+/*
+ * Operation an EVP_PKEY_CTX is initialized for, i.e. the operation field of OpenSSL's struct (an EVP_PKEY_OP_* value).
+ * Every EVP_PKEY_*_init() replaces it: with its own operation on success and with EVP_PKEY_CTX_OPERATION_UNDEFINED on
+ * failure. The operation functions themselves leave it unchanged, so one initialization serves any number of calls.
+ */
+enum evp_pkey_ctx_operation {
+    EVP_PKEY_CTX_OPERATION_UNDEFINED,
+    EVP_PKEY_CTX_OPERATION_SIGN,
+    EVP_PKEY_CTX_OPERATION_VERIFY, /* Only set by EVP_DigestVerifyInit(), EVP_PKEY_verify() is not modelled. */
+    EVP_PKEY_CTX_OPERATION_DERIVE,
+    EVP_PKEY_CTX_OPERATION_ENCRYPT,
+    EVP_PKEY_CTX_OPERATION_DECRYPT
 };
 
 /* Abstraction of the EVP_PKEY_CTX struct. */
 struct evp_pkey_ctx_st {
-    bool is_initialized_for_signing;
-    bool is_initialized_for_derivation;
-    bool is_initialized_for_encryption;
-    bool is_initialized_for_decryption;
+    int id; /* Algorithm of the context: the id of EVP_PKEY_CTX_new_id(), or EVP_PKEY_NONE with a key. */
+    enum evp_pkey_ctx_operation operation;
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
     int rsa_pad;
+#endif
     EVP_PKEY *pkey;
+    struct evp_pkey_hkdf_params hkdf; /* Only used when id is EVP_PKEY_HKDF. */
 };
 
 /* Abstraction of the EVP_CIPHER struct. */
 struct evp_cipher_st {
     enum evp_aes from;
-    size_t block_size;
+    size_t block_size; /* In bytes, as returned by EVP_CIPHER_block_size(): 1 for stream modes such as GCM. */
 };
 
+/*
+ * Phases of a cipher operation. EVP_CipherInit_ex() and friends start in EVP_CIPHER_PHASE_AAD, the first
+ * EVP_CipherUpdate() with a non-NULL output moves to EVP_CIPHER_PHASE_DATA and EVP_CipherFinal_ex() ends the operation.
+ * Additional authenticated data is only accepted in the first phase.
+ */
+enum evp_cipher_phase { EVP_CIPHER_PHASE_AAD, EVP_CIPHER_PHASE_DATA, EVP_CIPHER_PHASE_FINAL };
+
 /* Abstraction of the EVP_CIPHER_CTX struct. */
 struct evp_cipher_ctx_st {
     EVP_CIPHER *cipher;
     int encrypt;
-    int iv_len;           // default: DEFAULT_IV_LEN.
-    bool iv_set;          // boolean marks if iv has been set. Default:false.
-    int key_len;          // default: DEFAULT_KEY_LEN
-    bool padding;         // boolean marks if padding is enabled. Default:true.
-    bool data_processed;  // boolean marks if has encrypt/decrypt final has been called. Default:false.
-    int data_remaining;   // how much is left to be encrypted/decrypted. Default: 0.
+    int iv_len;                  // default: DEFAULT_IV_LEN.
+    bool iv_set;                 // boolean marks if iv has been set. Default:false.
+    int key_len;                 // default: DEFAULT_KEY_LEN
+    bool padding;                // boolean marks if padding is enabled. Default:true.
+    bool data_processed;         // boolean marks if has encrypt/decrypt final has been called. Default:false.
+    int data_remaining;          // input bytes not written out yet, at most a block with a cipher set. Default: 0.
+    enum evp_cipher_phase phase; // Default: EVP_CIPHER_PHASE_AAD.
+    size_t aad_len;              // bytes of additional authenticated data so far. Default: 0.
+    size_t data_len;             // bytes of plaintext or ciphertext input so far. Default: 0.
 };
 
 /* Abstraction of the EVP_MD struct. */
@@ -90,10 +169,26 @@ struct evp_md_ctx_st {
 
     unsigned long flags;
     void *md_data;
-    /* Public key context for sign/verify. */
+    /* Public key context for sign/verify. Always NULL with LIBCRYPTO_MODEL_MD_CTX_NO_PKEY. */
     EVP_PKEY_CTX *pctx;
+
+    /* Abstract digest state, so that updates never need to touch the shared EVP_MD. */
+    size_t bytes_absorbed; /* Saturates at SIZE_MAX. */
+    bool is_finalized;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint fingerprint; /* Of the absorbed bytes, see digest_utils.h. */
+#endif
 } /* EVP_MD_CTX */;
 
+/*
+ * Abstraction of the EVP_ENCODE_CTX struct. Like OpenSSL, encoding buffers the input bytes of an incomplete output line
+ * and decoding the base64 characters of an incomplete 64-character group; the model only keeps their number.
+ */
+struct evp_Encode_Ctx_st {
+    int num; /* Buffered input bytes when encoding (below 48), base64 characters when decoding (below 64). */
+    int eof; /* Decoding only: number of '=' padding characters among the buffered ones, always the last ones. */
+};
+
 EVP_MD_CTX *EVP_MD_CTX_new(void);
 int EVP_MD_CTX_size(const EVP_MD_CTX *ctx);
 void EVP_MD_CTX_free(EVP_MD_CTX *ctx);
@@ -102,19 +197,39 @@ int EVP_DigestInit_ex(EVP_MD_CTX *ctx, const EVP_MD *type, ENGINE *impl);
 int EVP_DigestUpdate(EVP_MD_CTX *ctx, const void *d, size_t cnt);
 int EVP_DigestFinal_ex(EVP_MD_CTX *ctx, unsigned char *md, unsigned int *s);
 int EVP_DigestFinal(EVP_MD_CTX *ctx, unsigned char *md, unsigned int *s);
+int EVP_Digest(
+    const void *data, size_t count, unsigned char *md, unsigned int *size, const EVP_MD *type, ENGINE *impl);
+int EVP_DigestSignInit(EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx, const EVP_MD *type, ENGINE *e, EVP_PKEY *pkey);
+int EVP_DigestSignFinal(EVP_MD_CTX *ctx, unsigned char *sig, size_t *siglen);
+int EVP_DigestSign(EVP_MD_CTX *ctx, unsigned char *sigret, size_t *siglen, const unsigned char *tbs, size_t tbslen);
 int EVP_DigestVerifyInit(EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx, const EVP_MD *type, ENGINE *e, EVP_PKEY *pkey);
 int EVP_DigestVerifyFinal(EVP_MD_CTX *ctx, const unsigned char *sig, size_t siglen);
+int EVP_DigestVerify(
+    EVP_MD_CTX *ctx, const unsigned char *sig, size_t siglen, const unsigned char *tbs, size_t tbslen);
 void EVP_MD_CTX_set_flags(EVP_MD_CTX *ctx, int flags);
 int EVP_MD_CTX_test_flags(const EVP_MD_CTX *ctx, int flags);
 int EVP_MD_CTX_copy_ex(EVP_MD_CTX *out, const EVP_MD_CTX *in);
 int EVP_MD_CTX_cleanup(EVP_MD_CTX *ctx);
+int EVP_MD_CTX_reset(EVP_MD_CTX *ctx);
 int EVP_EncodeBlock(unsigned char *t, const unsigned char *f, int n);
 int EVP_DecodeBlock(unsigned char *t, const unsigned char *f, int n);
+EVP_ENCODE_CTX *EVP_ENCODE_CTX_new(void);
+void EVP_ENCODE_CTX_free(EVP_ENCODE_CTX *ctx);
+int EVP_ENCODE_CTX_num(EVP_ENCODE_CTX *ctx);
+void EVP_EncodeInit(EVP_ENCODE_CTX *ctx);
+int EVP_EncodeUpdate(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl);
+void EVP_EncodeFinal(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl);
+void EVP_DecodeInit(EVP_ENCODE_CTX *ctx);
+int EVP_DecodeUpdate(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl);
+int EVP_DecodeFinal(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl);
 
 #define EVP_MD_CTX_create() EVP_MD_CTX_new()
 #define EVP_MD_CTX_destroy(ctx) EVP_MD_CTX_free((ctx))
+#define EVP_DigestSignUpdate(ctx, d, cnt) EVP_DigestUpdate((ctx), (d), (cnt))
+#define EVP_DigestVerifyUpdate(ctx, d, cnt) EVP_DigestUpdate((ctx), (d), (cnt))
 
 EVP_PKEY *EVP_PKEY_new(void);
+int EVP_PKEY_up_ref(EVP_PKEY *pkey);
 EC_KEY *EVP_PKEY_get0_EC_KEY(EVP_PKEY *pkey);
 int EVP_PKEY_set1_EC_KEY(EVP_PKEY *pkey, EC_KEY *key);
 void EVP_PKEY_free(EVP_PKEY *pkey);
@@ -137,6 +252,7 @@ int EVP_PKEY_decrypt(EVP_PKEY_CTX *ctx, unsigned char *out, size_t *outlen, cons
 #define EVP_CIPHER_CTX_key_length(ctx) ((ctx)->key_len)
 
 void EVP_CIPHER_CTX_init(EVP_CIPHER_CTX *ctx);
+int EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX *ctx);
 EVP_CIPHER_CTX *EVP_CIPHER_CTX_new(void);
 int EVP_CipherInit_ex(
     EVP_CIPHER_CTX *ctx,
@@ -164,6 +280,53 @@ const EVP_CIPHER *EVP_aes_192_gcm(void);
 const EVP_CIPHER *EVP_aes_256_gcm(void);
 const EVP_CIPHER *EVP_aes_128_ecb(void);
 
+const EVP_AEAD *EVP_aead_aes_128_gcm(void);
+const EVP_AEAD *EVP_aead_aes_192_gcm(void);
+const EVP_AEAD *EVP_aead_aes_256_gcm(void);
+size_t EVP_AEAD_key_length(const EVP_AEAD *aead);
+size_t EVP_AEAD_nonce_length(const EVP_AEAD *aead);
+size_t EVP_AEAD_max_overhead(const EVP_AEAD *aead);
+size_t EVP_AEAD_max_tag_len(const EVP_AEAD *aead);
+int EVP_AEAD_CTX_init(
+    EVP_AEAD_CTX *ctx, const EVP_AEAD *aead, const uint8_t *key, size_t key_len, size_t tag_len, ENGINE *impl);
+void EVP_AEAD_CTX_cleanup(EVP_AEAD_CTX *ctx);
+int EVP_AEAD_CTX_seal(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    size_t *out_len,
+    size_t max_out_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *ad,
+    size_t ad_len);
+int EVP_AEAD_CTX_open(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    size_t *out_len,
+    size_t max_out_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *ad,
+    size_t ad_len);
+int EVP_AEAD_CTX_seal_scatter(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    uint8_t *out_tag,
+    size_t *out_tag_len,
+    size_t max_out_tag_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *extra_in,
+    size_t extra_in_len,
+    const uint8_t *ad,
+    size_t ad_len);
+
 const EVP_MD *EVP_md5(void);
 const EVP_MD *EVP_sha1(void);
 const EVP_MD *EVP_sha224(void);
@@ -216,6 +379,7 @@ int EVP_MD_size(const EVP_MD *md);
 #define EVP_CTRL_AEAD_SET_MAC_KEY 0x17
 #define EVP_CIPH_NO_PADDING 0x100
 
+#define EVP_PKEY_NONE 0 /* NID_undef */
 #define EVP_PKEY_RSA 6  /* NID_rsaEncryption */
 #define EVP_PKEY_EC 408 /* NID_X9_62_id_ecPublicKey */
 
@@ -19,14 +19,42 @@
 
 #include "ossl_typ.h"
 
+#include <digest_utils.h>
 #include <stdbool.h>
+#include <stddef.h>
 
+/*
+ * The model does not hash anything, so md_ctx, i_ctx and o_ctx are never allocated and stay NULL. is_keyed records
+ * whether a key has been set up, which HMAC_Init_ex() needs to reuse it.
+ */
 struct hmac_ctx_st {
     const EVP_MD *md;
     EVP_MD_CTX *md_ctx;
     EVP_MD_CTX *i_ctx;
     EVP_MD_CTX *o_ctx;
     bool is_initialized;
+    bool is_keyed;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint key_fingerprint; /* Of the key, see digest_utils.h. */
+    digest_fingerprint fingerprint;     /* Of the message absorbed since the last HMAC_Init_ex(). */
+#endif
 };
 
+HMAC_CTX *HMAC_CTX_new(void);
+void HMAC_CTX_init(HMAC_CTX *ctx);
+int HMAC_CTX_reset(HMAC_CTX *ctx);
+int HMAC_CTX_copy(HMAC_CTX *dctx, HMAC_CTX *sctx);
+void HMAC_CTX_free(HMAC_CTX *ctx);
+int HMAC_Init_ex(HMAC_CTX *ctx, const void *key, int len, const EVP_MD *md, ENGINE *impl);
+int HMAC_Update(HMAC_CTX *ctx, const unsigned char *data, size_t len);
+int HMAC_Final(HMAC_CTX *ctx, unsigned char *md, unsigned int *len);
+unsigned char *HMAC(
+    const EVP_MD *evp_md,
+    const void *key,
+    int key_len,
+    const unsigned char *d,
+    size_t n,
+    unsigned char *md,
+    unsigned int *md_len);
+
 #endif
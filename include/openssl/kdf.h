@@ -35,6 +35,14 @@ extern "C" {
 #define EVP_PKEY_CTRL_SCRYPT_P (EVP_PKEY_ALG_CTRL + 12)
 #define EVP_PKEY_CTRL_SCRYPT_MAXMEM_BYTES (EVP_PKEY_ALG_CTRL + 13)
 
+/* Limits of HKDF, as in crypto/kdf/hkdf.c: total length of the info, and of an expansion in digest-sized blocks. */
+#define HKDF_MAXBUF 1024
+#define HKDF_MAX_BLOCKS 255
+
+#define EVP_KDF_HKDF_MODE_EXTRACT_AND_EXPAND 0
+#define EVP_KDF_HKDF_MODE_EXTRACT_ONLY 1
+#define EVP_KDF_HKDF_MODE_EXPAND_ONLY 2
+
 #define EVP_PKEY_HKDEF_MODE_EXTRACT_AND_EXPAND EVP_KDF_HKDF_MODE_EXTRACT_AND_EXPAND
 #define EVP_PKEY_HKDEF_MODE_EXTRACT_ONLY EVP_KDF_HKDF_MODE_EXTRACT_ONLY
 #define EVP_PKEY_HKDEF_MODE_EXPAND_ONLY EVP_KDF_HKDF_MODE_EXPAND_ONLY
@@ -17,10 +17,23 @@
 #ifndef HEADER_OBJECTS_H
 #define HEADER_OBJECTS_H
 
+#define SN_undef "UNDEF"
+#define LN_undef "undefined"
 #define NID_undef 0
+#define OBJ_undef 0L
+
+#define SN_X9_62_prime256v1 "prime256v1"
 #define NID_X9_62_prime256v1 415
+#define OBJ_X9_62_prime256v1 "1.2.840.10045.3.1.7"
+
+#define SN_secp384r1 "secp384r1"
 #define NID_secp384r1 715
+#define OBJ_secp384r1 "1.3.132.0.34"
 
 int OBJ_txt2nid(const char *s);
+int OBJ_sn2nid(const char *s);
+int OBJ_ln2nid(const char *s);
+const char *OBJ_nid2sn(int n);
+const char *OBJ_nid2ln(int n);
 
 #endif
@@ -17,17 +17,13 @@
 #ifndef HEADER_OPENSSL_TYPES_H
 #define HEADER_OPENSSL_TYPES_H
 
-/* This is the base type that holds just about everything :-) */
+#include <stdbool.h>
+
+/* This is the base type that holds just about everything :-) The model only keeps what the ASN1 overrides need. */
 struct asn1_string_st {
-    int length;
-    int type;
-    unsigned char *data;
-    /*
-     * The value of the following field depends on the type being held.  It
-     * is mostly being used for BIT_STRING so if the input data has a
-     * non-zero 'unused bits' value, it will be handled correctly
-     */
-    long flags;
+    bool is_valid;
+    int length;              /* Number of content octets of the magnitude, as in OpenSSL. */
+    bool needs_leading_zero; /* The top bit of the magnitude is set, so DER prepends a zero octet. */
 };
 
 #ifdef NO_ASN1_TYPEDEFS
@@ -73,6 +69,7 @@ typedef int ASN1_NULL;
 #    undef BIGNUM
 #endif
 typedef struct bio_st BIO;
+typedef struct bio_method_st BIO_METHOD;
 typedef struct bignum_st BIGNUM;
 
 typedef struct dh_st DH;
@@ -85,6 +82,7 @@ typedef struct hmac_ctx_st HMAC_CTX;
 
 typedef struct evp_cipher_st EVP_CIPHER;
 typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+typedef struct evp_Encode_Ctx_st EVP_ENCODE_CTX;
 typedef struct evp_md_st EVP_MD;
 typedef struct evp_md_ctx_st EVP_MD_CTX;
 typedef struct evp_pkey_st EVP_PKEY;
@@ -17,9 +17,13 @@
 #ifndef HEADER_RAND_H
 #define HEADER_RAND_H
 
+#include <stddef.h>
+
 /* Already defined in ossl_typ.h */
 /* typedef struct rand_meth_st RAND_METHOD; */
 
+int RAND_bytes(unsigned char *buf, size_t num);
+
 struct rand_meth_st {
     void (*seed)(const void *buf, int num);
     int (*bytes)(unsigned char *buf, int num);
@@ -18,6 +18,9 @@
 #ifndef HEADER_SHA_H
 #define HEADER_SHA_H
 
+#include <digest_utils.h>
+#include <stddef.h>
+
 /*
  * !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
  * ! SHA_LONG has to be at least 32 bits wide. If it's wider, then !
@@ -42,11 +45,23 @@
 #define SHA_LAST_BLOCK (SHA_CBLOCK - 8)
 #define SHA_DIGEST_LENGTH 20
 
+/*
+ * Model-only streaming state of the contexts below: SHA*_Init() starts a stream, every successful SHA*_Update() moves
+ * it to SHA_STREAM_ABSORBING and SHA*_Final() ends it. A context that was never initialized holds no valid state.
+ */
+enum sha_stream_state { SHA_STREAM_INITIALIZED = 1, SHA_STREAM_ABSORBING, SHA_STREAM_FINALIZED };
+
 typedef struct SHAstate_st {
     SHA_LONG h0, h1, h2, h3, h4;
     SHA_LONG Nl, Nh;
     SHA_LONG data[SHA_LBLOCK];
     unsigned int num;
+    /* Model-only state, see enum sha_stream_state. */
+    enum sha_stream_state stream_state;
+    size_t bytes_absorbed; /* Saturates at SIZE_MAX. */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint fingerprint; /* Of the absorbed bytes, see digest_utils.h. */
+#endif
 } SHA_CTX;
 
 #define SHA256_CBLOCK                                  \
@@ -61,6 +76,12 @@ typedef struct SHA256state_st {
     SHA_LONG Nl, Nh;
     SHA_LONG data[SHA_LBLOCK];
     unsigned int num, md_len;
+    /* Model-only state, see enum sha_stream_state. */
+    enum sha_stream_state stream_state;
+    size_t bytes_absorbed; /* Saturates at SIZE_MAX. */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint fingerprint; /* Of the absorbed bytes, see digest_utils.h. */
+#endif
 } SHA256_CTX;
 
 #define SHA384_DIGEST_LENGTH 48
@@ -95,6 +116,12 @@ typedef struct SHA512state_st {
         unsigned char p[SHA512_CBLOCK];
     } u;
     unsigned int num, md_len;
+    /* Model-only state, see enum sha_stream_state. */
+    enum sha_stream_state stream_state;
+    size_t bytes_absorbed; /* Saturates at SIZE_MAX. */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint fingerprint; /* Of the absorbed bytes, see digest_utils.h. */
+#endif
 } SHA512_CTX;
 #endif
 
@@ -115,4 +142,10 @@ int SHA224_Update(SHA256_CTX *c, const void *data, size_t len);
 int SHA256_Update(SHA256_CTX *c, const void *data, size_t len);
 int SHA384_Update(SHA512_CTX *c, const void *data, size_t len);
 int SHA512_Update(SHA512_CTX *c, const void *data, size_t len);
+
+unsigned char *SHA1(const unsigned char *d, size_t n, unsigned char *md);
+unsigned char *SHA224(const unsigned char *d, size_t n, unsigned char *md);
+unsigned char *SHA256(const unsigned char *d, size_t n, unsigned char *md);
+unsigned char *SHA384(const unsigned char *d, size_t n, unsigned char *md);
+unsigned char *SHA512(const unsigned char *d, size_t n, unsigned char *md);
 #endif
@@ -0,0 +1,76 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef POOL_UTILS_H
+#define POOL_UTILS_H
+
+#include <assert.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <model_config.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*
+ * Allocation backends for the objects of the model. Every constructor of a pooled type allocates through
+ * <name>_pool_alloc() and every destructor releases through <name>_pool_free().
+ *
+ * By default these are plain malloc() and free(). With LIBCRYPTO_MODEL_POOL_SIZE defined (see model_config.h) each
+ * type instead gets a static array of LIBCRYPTO_MODEL_POOL_SIZE objects that is handed out in order and never reused,
+ * so every object of the model is one of a fixed set of statically known objects. Allocation then only fails when
+ * the pool is exhausted, or when LIBCRYPTO_MODEL_ALLOC failures are injected (see failure_utils.h).
+ */
+
+#define DECLARE_MODEL_POOL(type, name) \
+    type *name##_pool_alloc(void);     \
+    void name##_pool_free(type *ptr);
+
+#ifdef LIBCRYPTO_MODEL_POOL_SIZE
+
+/*
+ * Released slots are only marked as such and never handed out again, as name##_pool_next only grows: the memory stays
+ * valid, so double frees are caught by the assertion below but CBMC no longer reports uses after free for pooled
+ * objects. Pointers that were not allocated from the pool (e.g. objects malloc'ed by a harness) are simply passed on to
+ * free().
+ */
+#    define DEFINE_MODEL_POOL(type, name)                                                          \
+        static type name##_pool[LIBCRYPTO_MODEL_POOL_SIZE];                                        \
+        static bool name##_pool_in_use[LIBCRYPTO_MODEL_POOL_SIZE];                                 \
+        static size_t name##_pool_next = 0;                                                        \
+                                                                                                   \
+        type *name##_pool_alloc(void) {                                                            \
+            if (name##_pool_next >= LIBCRYPTO_MODEL_POOL_SIZE) return NULL;                        \
+            if (inject_failure(LIBCRYPTO_MODEL_ALLOC)) return NULL;                                \
+            /* Unconstrained like a fresh malloc, without havocking the rest of the pool. */       \
+            __CPROVER_havoc_slice(&name##_pool[name##_pool_next], sizeof(type));                   \
+            name##_pool_in_use[name##_pool_next] = true;                                           \
+            return &name##_pool[name##_pool_next++];                                               \
+        }                                                                                          \
+                                                                                                   \
+        void name##_pool_free(type *ptr) {                                                         \
+            if (ptr == NULL) return;                                                               \
+            if (!__CPROVER_same_object(ptr, name##_pool)) {                                        \
+                free(ptr);                                                                         \
+                return;                                                                            \
+            }                                                                                      \
+            size_t index = ptr - name##_pool;                                                      \
+            assert(ptr == &name##_pool[index] && name##_pool_in_use[index]); /* No double free. */ \
+            name##_pool_in_use[index] = false;                                                     \
+        }
+
+#else
+
+#    define DEFINE_MODEL_POOL(type, name)      \
+        type *name##_pool_alloc(void) {        \
+            return model_malloc(sizeof(type)); \
+        }                                      \
+                                               \
+        void name##_pool_free(type *ptr) {     \
+            model_free(ptr);                   \
+        }
+
+#endif
+
+#endif /* POOL_UTILS_H */
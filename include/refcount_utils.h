@@ -0,0 +1,70 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef REFCOUNT_UTILS_H
+#define REFCOUNT_UTILS_H
+
+#include <assert.h>
+#include <limits.h>
+#include <model_config.h>
+#include <stdbool.h>
+#include <thread_utils.h>
+
+/*
+ * Ownership tracking for the reference counted objects of the model (EVP_PKEY and EC_KEY). The overrides only
+ * manipulate reference counts through the functions below.
+ *
+ * With LIBCRYPTO_MODEL_SINGLE_OWNER (see model_config.h) the count is an 8-bit value: enough for an object held by
+ * its owner plus the few references the model takes internally (e.g. EVP_PKEY_CTX_new or EVP_PKEY_set1_EC_KEY), but
+ * without 32-bit counter arithmetic in the formula.
+ *
+ * With LIBCRYPTO_MODEL_THREADS every update is atomic, and the decision of refcount_release() that the last owner is
+ * gone is taken in the same atomic section as the decrement, like the atomic reference counts of OpenSSL. Taking a
+ * reference to an object whose last owner already released it fails an assertion, so a race between a new owner and
+ * the final release is reported rather than turned into a use after free.
+ */
+#ifdef LIBCRYPTO_MODEL_SINGLE_OWNER
+typedef unsigned char model_refcount;
+#    define MODEL_REFCOUNT_MAX UCHAR_MAX
+#else
+typedef int model_refcount;
+#    define MODEL_REFCOUNT_MAX INT_MAX
+#endif
+
+/* Sets up the count of a freshly created object, which is held by its creator. */
+static inline void refcount_init(model_refcount *count) {
+    *count = 1;
+}
+
+/* Returns whether the object still has at least one owner. */
+static inline bool refcount_is_live(model_refcount count) {
+    return count > 0;
+}
+
+/* Records one more owner of the object. */
+static inline void refcount_acquire(model_refcount *count) {
+    MODEL_ATOMIC_BEGIN();
+    assert(refcount_is_live(*count));
+    assert(*count < MODEL_REFCOUNT_MAX);
+    *count += 1;
+    MODEL_ATOMIC_END();
+}
+
+/*
+ * Drops one owner of the object and returns whether it was the last one, in which case the caller frees the object.
+ * Releasing an object without owners is ignored, to avoid spurious arithmetic underflows.
+ */
+static inline bool refcount_release(model_refcount *count) {
+    MODEL_ATOMIC_BEGIN();
+    bool last = false;
+    if (refcount_is_live(*count)) {
+        *count -= 1;
+        last = *count == 0;
+    }
+    MODEL_ATOMIC_END();
+    return last;
+}
+
+#endif /* REFCOUNT_UTILS_H */
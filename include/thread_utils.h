@@ -0,0 +1,30 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef THREAD_UTILS_H
+#define THREAD_UTILS_H
+
+#include <assert.h>
+#include <model_config.h>
+
+/*
+ * Synchronization of the model (see LIBCRYPTO_MODEL_THREADS in model_config.h). MODEL_ATOMIC_BEGIN() and
+ * MODEL_ATOMIC_END() delimit a section that no other thread interleaves with, and MODEL_WAIT_UNTIL(cond) blocks the
+ * calling thread until cond holds; use it at the start of an atomic section, so that cond still holds afterwards.
+ *
+ * Without LIBCRYPTO_MODEL_THREADS the model is single-threaded: atomic sections are plain code and waiting for a
+ * condition that does not hold, e.g. taking a lock that the thread already holds, is a deadlock and fails an assertion.
+ */
+#ifdef LIBCRYPTO_MODEL_THREADS
+#    define MODEL_ATOMIC_BEGIN() __CPROVER_atomic_begin()
+#    define MODEL_ATOMIC_END() __CPROVER_atomic_end()
+#    define MODEL_WAIT_UNTIL(cond) __CPROVER_assume(cond)
+#else
+#    define MODEL_ATOMIC_BEGIN() ((void)0)
+#    define MODEL_ATOMIC_END() ((void)0)
+#    define MODEL_WAIT_UNTIL(cond) assert(cond)
+#endif
+
+#endif /* THREAD_UTILS_H */
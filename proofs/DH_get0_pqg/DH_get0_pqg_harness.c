@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/dh.h>
+#include <stdlib.h>
+
+void harness() {
+    DH *dh           = DH_new();
+    const BIGNUM **p = nondet_bool() ? malloc(sizeof(*p)) : NULL;
+    const BIGNUM **q = nondet_bool() ? malloc(sizeof(*q)) : NULL;
+    const BIGNUM **g = nondet_bool() ? malloc(sizeof(*g)) : NULL;
+
+    DH_get0_pqg(dh, p, q, g);
+}
@@ -0,0 +1,15 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/dh.h>
+
+void harness() {
+    DH *dh           = DH_new();
+    BIGNUM *pub_key  = nondet_bool() ? BN_new() : NULL;
+    BIGNUM *priv_key = nondet_bool() ? BN_new() : NULL;
+
+    DH_set0_key(dh, pub_key, priv_key);
+}
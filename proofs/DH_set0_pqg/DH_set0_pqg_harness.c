@@ -0,0 +1,25 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/dh.h>
+
+void harness() {
+    DH *dh = DH_new();
+    if (dh != NULL && nondet_bool()) {
+        /* A duplicate shares the parameters of dh until they are replaced. */
+        DH_set0_pqg(dh, BN_new(), nondet_bool() ? BN_new() : NULL, BN_new());
+        DH *dup = DHparams_dup(dh);
+        DH_free(dh);
+        dh = dup;
+    }
+    if (dh == NULL) return;
+
+    BIGNUM *p = nondet_bool() ? BN_new() : NULL;
+    BIGNUM *q = nondet_bool() ? BN_new() : NULL;
+    BIGNUM *g = nondet_bool() ? BN_new() : NULL;
+
+    DH_set0_pqg(dh, p, q, g);
+}
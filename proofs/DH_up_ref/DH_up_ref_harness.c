@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <openssl/dh.h>
+
+void harness() {
+    DH *dh = DH_new();
+
+    DH_up_ref(dh);
+}
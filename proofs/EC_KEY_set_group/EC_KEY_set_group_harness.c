@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <ec_utils.h>
+
+void harness() {
+    /* A key without a group, or with a valid one that EC_KEY_set_group() frees. */
+    EC_KEY *key           = nondet_bool() ? EC_KEY_new() : ec_key_nondet_valid_alloc(0);
+    const EC_GROUP *group = ec_group_nondet_valid_alloc();
+
+    int rv = EC_KEY_set_group(key, group);
+
+    /* The success path, and with it every ensures clause about the new group, must be reachable. */
+    __CPROVER_cover(rv == 1);
+}
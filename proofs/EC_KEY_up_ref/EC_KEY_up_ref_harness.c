@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <ec_utils.h>
+
+void harness() {
+    EC_KEY *key = ec_key_nondet_valid_alloc(1);
+
+    EC_KEY_up_ref(key);
+}
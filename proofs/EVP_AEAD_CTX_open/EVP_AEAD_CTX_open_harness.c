@@ -0,0 +1,26 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_AEAD_CTX *ctx = malloc(sizeof(*ctx));
+    if (ctx != NULL) ctx->aead = nondet_bool() ? EVP_aead_aes_128_gcm() : EVP_aead_aes_256_gcm();
+    size_t *out_len  = malloc(sizeof(*out_len));
+    size_t nonce_len = nondet_size_t();
+    uint8_t *nonce   = malloc(nonce_len);
+    size_t ad_len    = nondet_size_t();
+    uint8_t *ad      = malloc(ad_len);
+    size_t in_len    = nondet_size_t();
+    uint8_t *in      = malloc(in_len);
+    /* Either in place or into a separate buffer. */
+    size_t max_out_len = nondet_size_t();
+    uint8_t *out       = nondet_bool() ? in : malloc(max_out_len);
+    if (out == in) __CPROVER_assume(max_out_len == in_len);
+
+    EVP_AEAD_CTX_open(ctx, out, out_len, max_out_len, nonce, nonce_len, in, in_len, ad, ad_len);
+}
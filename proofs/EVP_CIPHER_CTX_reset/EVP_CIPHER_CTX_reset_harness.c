@@ -0,0 +1,14 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    /* Any state, e.g. a context whose operation was finalized. */
+    EVP_CIPHER_CTX *ctx = malloc(sizeof(*ctx));
+
+    EVP_CIPHER_CTX_reset(ctx);
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <stdlib.h>
+
+void harness() {
+    int n = nondet_int();
+    __CPROVER_assume(0 <= n);
+    unsigned char *f = malloc(n);
+    unsigned char *t = malloc(n / 4 * 3);
+
+    EVP_DecodeBlock(t, f, n);
+}
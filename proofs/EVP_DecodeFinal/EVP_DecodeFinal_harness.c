@@ -0,0 +1,16 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_ENCODE_CTX *ctx = malloc(sizeof(*ctx));
+    __CPROVER_assume(evp_decode_ctx_is_valid(ctx));
+    unsigned char *out = malloc(ctx->num / 4 * 3);
+    int outl;
+
+    EVP_DecodeFinal(ctx, out, &outl);
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+/* Small enough to unwind the decoding loop, large enough to cross the 64-character group boundary. */
+#define MAX_INPUT_LEN 8
+
+void harness() {
+    EVP_ENCODE_CTX *ctx = malloc(sizeof(*ctx));
+    __CPROVER_assume(evp_decode_ctx_is_valid(ctx));
+    int inl = nondet_int();
+    __CPROVER_assume(0 <= inl && inl <= MAX_INPUT_LEN);
+    unsigned char *in  = malloc(inl);
+    unsigned char *out = malloc((ctx->num + inl) / 4 * 3);
+    int outl;
+
+    EVP_DecodeUpdate(ctx, out, &outl, in, inl);
+}
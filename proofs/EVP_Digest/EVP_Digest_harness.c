@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <stdlib.h>
+
+void harness() {
+    size_t count       = nondet_size_t();
+    void *data         = malloc(count);
+    unsigned char *md  = malloc(EVP_MAX_MD_SIZE);
+    unsigned int *size = nondet_bool() ? malloc(sizeof(*size)) : NULL;
+    const EVP_MD *type = nondet_bool() ? EVP_sha256() : EVP_sha512();
+
+    EVP_Digest(data, count, md, size, type, NULL);
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_MD_CTX *ctx = malloc(sizeof(*ctx));
+    if (ctx != NULL) ctx->digest = nondet_bool() ? EVP_sha256() : EVP_sha512();
+    unsigned char *md = malloc(EVP_MAX_MD_SIZE);
+    unsigned int *s   = nondet_bool() ? malloc(sizeof(*s)) : NULL;
+
+    EVP_DigestFinal_ex(ctx, md, s);
+}
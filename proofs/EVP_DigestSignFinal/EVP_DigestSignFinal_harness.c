@@ -0,0 +1,16 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_MD_CTX *ctx    = evp_md_ctx_nondet_valid_alloc(4, NULL);
+    size_t *siglen     = malloc(sizeof(*siglen));
+    unsigned char *sig = (siglen != NULL && nondet_bool()) ? malloc(*siglen) : NULL;
+
+    EVP_DigestSignFinal(ctx, sig, siglen);
+}
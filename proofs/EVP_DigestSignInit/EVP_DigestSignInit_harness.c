@@ -0,0 +1,21 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/crypto.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    if (pkey != NULL) evp_pkey_set0_ec_key(pkey, nondet_bool() ? ec_key_nondet_alloc() : NULL);
+    /* ctx may already carry a public key context, possibly of the same key. */
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx != NULL) ctx->pctx = nondet_bool() ? OPENSSL_malloc(sizeof(*ctx->pctx)) : NULL;
+    if (ctx != NULL && ctx->pctx != NULL) ctx->pctx->pkey = nondet_bool() ? pkey : NULL;
+    EVP_PKEY_CTX **pctx = nondet_bool() ? malloc(sizeof(*pctx)) : NULL;
+
+    EVP_DigestSignInit(ctx, pctx, nondet_bool() ? EVP_sha256() : EVP_sha384(), NULL, pkey);
+}
@@ -0,0 +1,21 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_ENCODE_CTX *ctx = malloc(sizeof(*ctx));
+    __CPROVER_assume(evp_encode_ctx_is_valid(ctx));
+    int inl = nondet_int();
+    __CPROVER_assume(0 <= inl && inl <= 1024);
+    unsigned char *in = malloc(inl);
+    /* 64 characters and a newline per complete line of 48 bytes, then the NUL terminator. */
+    unsigned char *out = malloc((ctx->num + inl) / 48 * 65 + 1);
+    int outl;
+
+    EVP_EncodeUpdate(ctx, out, &outl, in, inl);
+}
@@ -0,0 +1,19 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    if (ctx != NULL) ctx->cipher = nondet_bool() ? (EVP_CIPHER *)EVP_aes_256_gcm() : NULL;
+    int inl            = nondet_int();
+    unsigned char *in  = malloc(inl);
+    unsigned char *out = nondet_bool() ? malloc(inl) : NULL;
+    int *outl          = malloc(sizeof(*outl));
+
+    EVP_EncryptUpdate(ctx, out, outl, in, inl);
+}
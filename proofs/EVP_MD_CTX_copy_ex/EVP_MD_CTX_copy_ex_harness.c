@@ -0,0 +1,28 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/crypto.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_MD_CTX *out = EVP_MD_CTX_new();
+    if (out != NULL && nondet_bool()) {
+        out->digest  = nondet_bool() ? EVP_sha256() : EVP_sha512();
+        out->md_data = OPENSSL_malloc(out->digest->md_size);
+    }
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    if (pkey != NULL) evp_pkey_set0_ec_key(pkey, nondet_bool() ? ec_key_nondet_alloc() : NULL);
+    EVP_MD_CTX *in = malloc(sizeof(*in));
+    if (in != NULL) {
+        in->digest  = nondet_bool() ? EVP_sha256() : EVP_sha512();
+        in->md_data = nondet_bool() ? malloc(in->digest->md_size) : NULL;
+        in->pctx    = nondet_bool() ? malloc(sizeof(*in->pctx)) : NULL;
+        if (in->pctx != NULL) in->pctx->pkey = pkey;
+    }
+
+    if (out != NULL) EVP_MD_CTX_copy_ex(out, in);
+}
@@ -0,0 +1,20 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/crypto.h>
+#include <stdlib.h>
+
+/* Runs with the "no-pkey-digest" profile of the manifest: the context never carries a public key context. */
+void harness() {
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx != NULL && nondet_bool()) {
+        ctx->digest  = EVP_sha256();
+        ctx->md_data = OPENSSL_malloc(ctx->digest->md_size);
+    }
+
+    EVP_MD_CTX_free(ctx);
+}
@@ -0,0 +1,19 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/crypto.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    if (pkey != NULL) evp_pkey_set0_ec_key(pkey, nondet_bool() ? ec_key_nondet_alloc() : NULL);
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx != NULL) ctx->pctx = nondet_bool() ? OPENSSL_malloc(sizeof(*ctx->pctx)) : NULL;
+    if (ctx != NULL && ctx->pctx != NULL) ctx->pctx->pkey = pkey;
+
+    EVP_MD_CTX_reset(ctx);
+}
@@ -0,0 +1,26 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/kdf.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(nondet_bool() ? EVP_PKEY_HKDF : EVP_PKEY_EC, NULL);
+    if (ctx == NULL) return;
+    if (nondet_bool()) EVP_PKEY_derive_init(ctx);
+    int optype = nondet_bool() ? -1 : EVP_PKEY_OP_DERIVE;
+    int cmd    = nondet_int();
+    int p1     = nondet_int();
+    void *p2;
+    if (cmd == EVP_PKEY_CTRL_HKDF_MD) {
+        p2 = nondet_bool() ? (void *)EVP_sha256() : NULL;
+    } else {
+        __CPROVER_assume(p1 <= 64);
+        p2 = nondet_bool() ? malloc(p1 > 0 ? p1 : 0) : NULL;
+    }
+
+    EVP_PKEY_CTX_ctrl(ctx, -1, optype, cmd, p1, p2);
+}
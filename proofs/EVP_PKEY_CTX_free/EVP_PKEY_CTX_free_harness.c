@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/crypto.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    if (pkey != NULL) evp_pkey_set0_ec_key(pkey, nondet_bool() ? ec_key_nondet_alloc() : NULL);
+    EVP_PKEY_CTX *ctx = OPENSSL_malloc(sizeof(*ctx));
+    if (ctx != NULL) ctx->pkey = pkey;
+
+    EVP_PKEY_CTX_free(ctx);
+}
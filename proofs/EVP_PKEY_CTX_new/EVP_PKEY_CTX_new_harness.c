@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <evp_utils.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_valid_alloc(2, NULL);
+
+    EVP_PKEY_CTX_new(pkey, NULL);
+}
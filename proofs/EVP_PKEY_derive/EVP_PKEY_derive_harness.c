@@ -0,0 +1,23 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/kdf.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    if (pkey != NULL) evp_pkey_set0_ec_key(pkey, nondet_bool() ? ec_key_nondet_alloc() : NULL);
+    EVP_PKEY_CTX *ctx = malloc(sizeof(*ctx));
+    if (ctx != NULL) {
+        ctx->pkey = pkey;
+        if (ctx->id == EVP_PKEY_HKDF) ctx->hkdf.md = nondet_bool() ? EVP_sha256() : NULL;
+    }
+    size_t *keylen     = malloc(sizeof(*keylen));
+    unsigned char *key = (keylen != NULL && nondet_bool()) ? malloc(*keylen) : NULL;
+
+    EVP_PKEY_derive(ctx, key, keylen);
+}
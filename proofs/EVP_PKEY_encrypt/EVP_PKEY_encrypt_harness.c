@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY_CTX *ctx  = malloc(sizeof(*ctx));
+    size_t *outlen     = malloc(sizeof(*outlen));
+    unsigned char *out = (outlen != NULL && nondet_bool()) ? malloc(*outlen) : NULL;
+    size_t inlen       = nondet_size_t();
+    unsigned char *in  = malloc(inlen);
+
+    EVP_PKEY_encrypt(ctx, out, outlen, in, inlen);
+}
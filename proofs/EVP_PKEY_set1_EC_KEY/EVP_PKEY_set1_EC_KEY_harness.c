@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <evp_utils.h>
+
+void harness() {
+    EVP_PKEY *pkey = evp_pkey_nondet_alloc();
+    EC_KEY *key    = ec_key_nondet_alloc();
+
+    EVP_PKEY_set1_EC_KEY(pkey, key);
+}
@@ -0,0 +1,18 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EVP_PKEY_CTX *ctx  = evp_pkey_ctx_nondet_valid_alloc(3, NULL);
+    size_t *siglen     = malloc(sizeof(*siglen));
+    unsigned char *sig = (siglen != NULL && nondet_bool()) ? malloc(*siglen) : NULL;
+    size_t tbslen      = nondet_size_t();
+    unsigned char *tbs = malloc(tbslen);
+
+    EVP_PKEY_sign(ctx, sig, siglen, tbs, tbslen);
+}
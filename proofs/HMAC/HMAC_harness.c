@@ -0,0 +1,20 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <stdlib.h>
+
+void harness() {
+    int key_len          = nondet_int();
+    void *key            = malloc(key_len);
+    size_t n             = nondet_size_t();
+    unsigned char *d     = malloc(n);
+    unsigned char *md    = nondet_bool() ? malloc(EVP_MAX_MD_SIZE) : NULL;
+    unsigned int *md_len = malloc(sizeof(*md_len));
+
+    HMAC(EVP_sha256(), key, key_len, d, n, md, md_len);
+}
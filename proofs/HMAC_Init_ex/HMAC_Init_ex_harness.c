@@ -0,0 +1,22 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <evp_utils.h>
+#include <openssl/hmac.h>
+#include <stdlib.h>
+
+void harness() {
+    HMAC_CTX *ctx = HMAC_CTX_new();
+    if (ctx != NULL && nondet_bool()) {
+        ctx->md       = EVP_sha256();
+        ctx->is_keyed = true;
+    }
+    int len          = nondet_int();
+    const void *key  = nondet_bool() ? malloc(len) : NULL;
+    const EVP_MD *md = nondet_bool() ? (nondet_bool() ? EVP_sha256() : EVP_sha512()) : NULL;
+
+    if (ctx != NULL) HMAC_Init_ex(ctx, key, len, md, NULL);
+}
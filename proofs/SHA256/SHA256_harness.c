@@ -0,0 +1,16 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/sha.h>
+#include <stdlib.h>
+
+void harness() {
+    size_t n          = nondet_size_t();
+    unsigned char *d  = malloc(n);
+    unsigned char *md = nondet_bool() ? malloc(SHA256_DIGEST_LENGTH) : NULL;
+
+    SHA256(d, n, md);
+}
@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <openssl/sha.h>
+#include <stdlib.h>
+
+void harness() {
+    SHA256_CTX *c = malloc(sizeof(*c));
+
+    SHA256_Init(c);
+}
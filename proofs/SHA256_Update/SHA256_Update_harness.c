@@ -0,0 +1,16 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <openssl/sha.h>
+#include <stdlib.h>
+
+void harness() {
+    SHA256_CTX *c = malloc(sizeof(*c));
+    size_t len    = nondet_size_t();
+    void *data    = malloc(len);
+
+    SHA256_Update(c, data, len);
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <cbmc_proof/nondet.h>
+#include <ec_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    EC_KEY *key         = ec_key_nondet_valid_alloc(1);
+    unsigned char *buf  = nondet_bool() ? malloc(1 + 2 * 48) : NULL;
+    unsigned char **out = malloc(sizeof(*out));
+    if (out != NULL) *out = buf;
+
+    i2o_ECPublicKey(key, out);
+}
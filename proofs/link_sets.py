@@ -0,0 +1,303 @@
+#!/usr/bin/env python3
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+
+"""Computes the minimal set of model units (source/*.c) that a harness has to be linked with.
+
+source/dependencies.json declares, for every unit of the model, the other units whose functions or objects it uses.
+The link set of a harness is the set of units defining a symbol that the harness uses, closed under the uses of those
+units, so that e.g. a harness of a base64 function is not linked with, and goto-instrument does not process, the
+cipher, digest or DH overrides.
+
+The uses of a file are found on its preprocessed source, i.e. with the configuration macros of MODEL_FLAGS applied:
+the identifiers in the bodies and contracts of its external definitions, and transitively in those of the static
+functions and objects they use. A header declaration or an unused static inline helper is not a use. A link set that
+misses a unit would silently turn its functions into unconstrained ones, so --check verifies that every unit declares
+all units it uses in this configuration, which keeps new dependencies between the families deliberate; run_proofs.py
+runs the check for each model profile before linking. A proof of proofs/manifest.json may also bound its link set with
+"link_set", the units it may be linked with in the configuration of its profile (model_state.c, whose ghost state
+depends on MODEL_FLAGS, is always allowed). --check verifies these bounds as well, so that e.g. the EVP_PKEY family
+cannot creep back into the link set of a digest-only proof.
+
+Usage:
+  proofs/link_sets.py --check               verify source/dependencies.json and the link sets bounded by the manifest
+  proofs/link_sets.py <harness.c>...        print the link set of each harness
+
+CBMC_PROOF_INCLUDE and MODEL_FLAGS are used as in build_model.sh.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "source")
+DEPENDENCIES = os.path.join(SOURCE, "dependencies.json")
+MANIFEST = os.path.join(ROOT, "proofs", "manifest.json")
+
+# Units that any link set may contain: the ghost state that configuration macros such as LIBCRYPTO_MODEL_FAILURE_BUDGET
+# add to every unit that injects failures.
+GHOST_UNITS = {"model_state"}
+
+TOKEN = re.compile(
+    r"[A-Za-z_]\w*|\"(?:\\.|[^\"\\\n])*\"|'(?:\\.|[^'\\\n])*'|\d[\w.]*"
+    r"|<<=|>>=|->|\+\+|--|&&|\|\||<<|>>|[-+*/%&|^!<>=]=|\S"
+)
+LINE_MARKER = re.compile(r"#\s*(?:line\s+)?\d+\s+\"([^\"]*)\"")
+
+# Identifiers that cannot name a declared function, e.g. in int (*f)(void) or __attribute__((unused)).
+NOT_A_NAME = set(
+    "__attribute__ __attribute __asm__ __asm asm __typeof__ __typeof typeof __declspec sizeof _Alignas _Static_assert "
+    "__extension__ void char short int long float double signed unsigned _Bool const volatile restrict __restrict "
+    "struct union enum".split()
+)
+
+
+def preprocess(path, model_flags):
+    """Preprocessed source of path, compiled like build_model.sh compiles the model."""
+    cmd = ["goto-cc", "-E", "-I", os.path.join(ROOT, "include"), "-I", os.environ["CBMC_PROOF_INCLUDE"]]
+    cmd += shlex.split(model_flags) + [path]
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    if result.returncode != 0:
+        raise RuntimeError("cannot preprocess %s:\n%s" % (path, result.stderr))
+    return result.stdout
+
+
+def tokenize(text, path):
+    """Yields (token, in_main_file) for the preprocessed text of path, dropping line markers."""
+    main = os.path.realpath(path)
+    current = True
+    for line in text.split("\n"):
+        if line.startswith("#"):
+            marker = LINE_MARKER.match(line)
+            if marker:
+                current = os.path.realpath(marker.group(1)) == main
+            continue
+        for token in TOKEN.findall(line):
+            yield token, current
+
+
+def parse(text, path):
+    """Top-level definitions of a preprocessed file: {name: (is_static, in_main_file, identifiers used)}.
+
+    Function definitions use the identifiers of their contracts and body, object definitions those of their
+    initializer. Declarations define nothing.
+    """
+    definitions = {}
+    decl, used, in_main = [], set(), True
+    depth, parens = 0, 0  # Brace depth, and parenthesis depth outside of braces (assigns clauses contain ';').
+    initializer = False  # Whether decl reached the '=' of an initializer.
+    function = None  # Name of the function whose body is open.
+    for token, main in tokenize(text, path):
+        is_identifier = re.match(r"[A-Za-z_]", token) is not None
+        if depth > 0:
+            depth += {"{": 1, "}": -1}.get(token, 0)
+            if (function is not None or initializer) and is_identifier:
+                used.add(token)
+            if depth == 0:
+                if function is not None:
+                    definitions[function] = ("static" in decl, in_main, used)
+                    decl, used, function = [], set(), None
+                else:
+                    decl.append(token)
+            continue
+        if not decl:
+            in_main = main
+        parens += {"(": 1, ")": -1}.get(token, 0)
+        if token == ";" and parens == 0:
+            if decl and decl[0] not in ("typedef", "extern") and declared_function(decl) is None:
+                name = declared_object(decl)
+                if name is not None:
+                    definitions[name] = ("static" in decl, in_main, used)
+            decl, used, initializer = [], set(), False
+            continue
+        if token == "{" and parens == 0:
+            depth = 1
+            if not initializer and decl and decl[0] != "typedef":
+                function = declared_function(decl)
+                if function is not None:
+                    used = {t for t in decl if re.match(r"[A-Za-z_]", t)}
+        elif token == "=" and parens == 0:
+            initializer = True
+        elif is_identifier and initializer:
+            used.add(token)
+        decl.append(token)
+    return definitions
+
+
+def declared_function(decl):
+    """Name of the function that the declaration tokens decl declare, or None."""
+    parens = 0
+    for i, token in enumerate(decl):
+        if token == "(":
+            if parens == 0 and i > 0 and re.match(r"[A-Za-z_]", decl[i - 1]) and decl[i - 1] not in NOT_A_NAME:
+                return decl[i - 1]
+            parens += 1
+        elif token == ")":
+            parens -= 1
+        elif token == "=" and parens == 0:
+            return None
+    return None
+
+
+def declared_object(decl):
+    """Name of the object that the declaration tokens decl define, or None (e.g. for a struct definition)."""
+    if "{" in decl and "=" not in decl:
+        # struct s { ... } object; defines object, struct s { ... }; defines nothing.
+        decl = decl[len(decl) - decl[::-1].index("}") :]
+    end = len(decl)
+    for i, token in enumerate(decl):
+        if token in ("=", "[", ",", ":"):
+            end = i
+            break
+    names = [t for t in decl[:end] if re.match(r"[A-Za-z_]", t)]
+    if not names or (names[0] in ("struct", "union", "enum") and len(names) <= 2 and "{" not in decl[:end]):
+        return None
+    return names[-1]
+
+
+def uses(definitions):
+    """Identifiers that the external definitions of a file use, directly or through the file's static definitions."""
+    pending = [name for name, (is_static, in_main, _) in definitions.items() if in_main and not is_static]
+    seen, result = set(pending), set()
+    while pending:
+        for identifier in definitions[pending.pop()][2]:
+            if identifier in definitions:
+                if identifier not in seen:
+                    seen.add(identifier)
+                    pending.append(identifier)
+            else:
+                result.add(identifier)
+    return result
+
+
+def units():
+    return sorted(f[: -len(".c")] for f in os.listdir(SOURCE) if f.endswith(".c"))
+
+
+def load_dependencies(path=DEPENDENCIES):
+    with open(path) as f:
+        declared = {unit[: -len(".c")]: [d[: -len(".c")] for d in deps] for unit, deps in json.load(f).items()}
+    undeclared = sorted(set(units()) - set(declared))
+    unknown = sorted(({d for deps in declared.values() for d in deps} | set(declared)) - set(units()))
+    if undeclared or unknown:
+        sys.exit(
+            "%s does not match source/*.c: undeclared %s, unknown %s"
+            % (path, ", ".join(undeclared) or "-", ", ".join(unknown) or "-")
+        )
+    return declared
+
+
+class Model:
+    """Symbols of the model units in one configuration, and the declared dependencies between the units."""
+
+    def __init__(self, model_flags):
+        self.model_flags = model_flags
+        self.dependencies = load_dependencies()
+        self.owner, self.uses = {}, {}
+        duplicates = []
+        for unit in units():
+            path = os.path.join(SOURCE, unit + ".c")
+            definitions = parse(preprocess(path, model_flags), path)
+            for name, (is_static, in_main, _) in definitions.items():
+                if in_main and not is_static:
+                    if name in self.owner:
+                        duplicates.append("%s (%s, %s)" % (name, self.owner[name], unit))
+                    self.owner[name] = unit
+            self.uses[unit] = uses(definitions)
+        if duplicates:
+            raise RuntimeError("symbols defined by several units: " + ", ".join(duplicates))
+
+    def used_units(self, identifiers, exclude=None):
+        return {self.owner[i] for i in identifiers if i in self.owner and self.owner[i] != exclude}
+
+    def check(self):
+        """Errors for the units that use a unit they do not declare, in the configuration of the model."""
+        errors = []
+        for unit in units():
+            missing = sorted(self.used_units(self.uses[unit], unit) - set(self.dependencies[unit]))
+            for dependency in missing:
+                symbols = sorted(i for i in self.uses[unit] if self.owner.get(i) == dependency)
+                errors.append(
+                    "%s.c uses %s of %s.c, which source/dependencies.json does not declare"
+                    % (unit, ", ".join(symbols), dependency)
+                )
+        return errors
+
+    def link_set(self, harness):
+        """Sorted units that harness must be linked with: those it uses, and transitively those they use.
+
+        The units used in the configuration are a subset of the declared ones once check() passed, e.g. model_state.c
+        is only linked in configurations that keep ghost state in it, such as LIBCRYPTO_MODEL_FAILURE_BUDGET.
+        """
+        pending = sorted(self.used_units(uses(parse(preprocess(harness, self.model_flags), harness))))
+        result = set(pending)
+        while pending:
+            unit = pending.pop()
+            for dependency in self.used_units(self.uses[unit], unit):
+                if dependency not in result:
+                    result.add(dependency)
+                    pending.append(dependency)
+        return sorted(result)
+
+
+def unexpected_units(allowed, link_set):
+    """Sorted units of link_set outside of allowed, the "link_set" of a manifest entry (file names of units)."""
+    return sorted(set(link_set) - {unit[: -len(".c")] for unit in allowed} - GHOST_UNITS)
+
+
+def check_link_sets(model_flags, path=MANIFEST):
+    """Errors for the proofs of the manifest whose link set exceeds their "link_set", each in its profile."""
+    with open(path) as f:
+        manifest = json.load(f)
+    profiles = manifest.get("profiles", {})
+    models, errors = {}, []
+    for proof in manifest["proofs"]:
+        if "link_set" not in proof:
+            continue
+        flags = " ".join([model_flags] + profiles.get(proof.get("profile"), [])).strip()
+        if flags not in models:
+            models[flags] = Model(flags)
+        unexpected = unexpected_units(proof["link_set"], models[flags].link_set(os.path.join(ROOT, proof["harness"])))
+        if unexpected:
+            errors.append(
+                "%s links %s, which its \"link_set\" in %s does not allow"
+                % (proof["harness"], ", ".join(unit + ".c" for unit in unexpected), os.path.relpath(path, ROOT))
+            )
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("harnesses", nargs="*", help="harnesses to print the link sets of")
+    parser.add_argument("--check", action="store_true", help="check the declared dependencies of the units")
+    args = parser.parse_args()
+
+    if "CBMC_PROOF_INCLUDE" not in os.environ:
+        sys.exit("set CBMC_PROOF_INCLUDE to the directory of the proof helper headers")
+    try:
+        model = Model(os.environ.get("MODEL_FLAGS", ""))
+        if args.check:
+            errors = model.check()
+            if not errors:
+                # Link sets are only meaningful once the declared dependencies hold.
+                errors = check_link_sets(model.model_flags)
+            for error in errors:
+                print(error)
+            if errors:
+                return 1
+            print("All %d units declare their dependencies, and the bounded link sets hold" % len(units()))
+        for harness in args.harnesses:
+            print("%s: %s" % (harness, " ".join(unit + ".c" for unit in model.link_set(harness))))
+    except RuntimeError as e:
+        sys.exit(str(e))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,25 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <assert.h>
+#include <cbmc_proof/nondet.h>
+#include <ec_utils.h>
+#include <stdlib.h>
+
+void harness() {
+    bool valid  = nondet_bool();
+    EC_KEY *key = valid ? ec_key_nondet_valid_alloc(0) : ec_key_nondet_alloc();
+    long len    = nondet_long();
+    __CPROVER_assume(0 <= len && len <= 1 + 2 * 48);
+    const unsigned char *buf = malloc(len);
+    const unsigned char *in  = buf;
+    __CPROVER_assume(in != NULL);
+
+    EC_KEY **key_ptr = nondet_bool() ? &key : NULL;
+    EC_KEY *rv       = o2i_ECPublicKey(key_ptr, &in, len);
+
+    /* Parsing either encoding keeps a valid key valid. */
+    if (valid && rv != NULL) assert(ec_key_is_valid(rv));
+}
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# SPDX-License-Identifier: Apache-2.0.
+
+"""Checks the function contracts of the model against the override bodies, running the proofs in parallel.
+
+proofs/manifest.json lists every proof. An entry names the contracted function and its harness, whose entry point
+harness() calls the function once, and may add:
+  "unwindset"  value of CBMC's --unwindset, e.g. "OBJ_sn2nid.0:33"; --unwinding-assertions is added along with it
+  "profile"    name of a model profile from the "profiles" map of the manifest, e.g. "no-pkey-digest"
+  "cbmc_flags" extra CBMC options for this proof only
+  "link_set"   units the harness may be linked with, e.g. ["evp_digest_override.c", "model_havoc.c"] (see link_sets.py)
+A profile is a list of configuration macros (see include/model_config.h) that cheapens the model for proofs that do
+not need all of it. Each profile gets its own model build, under <build-dir>/model-<profile>, with the macros added to
+MODEL_FLAGS; proofs without a profile use the plain model. Each harness is linked with the goto binaries that
+build_model.sh compiles from the units of its link set (see link_sets.py): the units defining what the harness uses,
+along with their declared dependencies, after checking source/dependencies.json in the configuration of the profile.
+--full-model links the prelinked libcrypto_model.goto instead. The contract of the function is then enforced with
+goto-instrument --enforce-contract, and CBMC checks the result. As every function of a profile comes from the single
+model source, the link keeps exactly one definition per symbol: goto-cc rejects a harness that defines a function of
+the model again. A harness guards against vacuous proofs with __CPROVER_cover(condition): the proof fails when CBMC
+reports the cover goal UNSATISFIABLE, i.e. when no execution reaches the condition.
+
+Proofs run on --jobs workers (default: all cores), longest first according to the durations recorded by the
+previous run in <build-dir>/timings.json; proofs without a recorded duration start first. The results are written as a
+JSON summary and as a JUnit XML report for CI.
+
+CBMC_PROOF_INCLUDE and MODEL_FLAGS are used as in build_model.sh, and CBMC_FLAGS overrides the property checks.
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+import link_sets
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROOFS = os.path.join(ROOT, "proofs")
+
+# Result line of a __CPROVER_cover goal that no execution reaches, e.g. "[harness.cover.1] line 17 ...: UNSATISFIABLE".
+UNREACHED_COVER = re.compile(r"^\[[^\]]*\.cover\.\d+\].*: UNSATISFIABLE$", re.MULTILINE)
+
+CBMC_CHECKS = [
+    "--bounds-check",
+    "--pointer-check",
+    "--pointer-primitive-check",
+    "--div-by-zero-check",
+    "--signed-overflow-check",
+    "--undefined-shift-check",
+    "--malloc-may-fail",
+    "--malloc-fail-null",
+]
+
+
+def load_manifest(path):
+    with open(path) as f:
+        manifest = json.load(f)
+    proofs = manifest["proofs"]
+    profiles = manifest.get("profiles", {})
+    names = [p["function"] for p in proofs]
+    duplicates = sorted({n for n in names if names.count(n) > 1})
+    if duplicates:
+        sys.exit("duplicate manifest entries: " + ", ".join(duplicates))
+    # Every harness on disk must be listed, so that a new proof cannot silently drop out of CI.
+    harnesses = {p["harness"] for p in proofs}
+    missing = sorted(
+        d
+        for d in os.listdir(PROOFS)
+        if os.path.isfile(os.path.join(PROOFS, d, d + "_harness.c"))
+        and "proofs/%s/%s_harness.c" % (d, d) not in harnesses
+    )
+    if missing:
+        sys.exit("harnesses missing from %s: %s" % (path, ", ".join(missing)))
+    stubbed = sorted(p["function"] for p in proofs if "stubs" in p)
+    if stubbed:
+        sys.exit("stubs were replaced by model profiles, see include/model_config.h: " + ", ".join(stubbed))
+    unknown = sorted({p["profile"] for p in proofs if p.get("profile") not in (None, *profiles)})
+    if unknown:
+        sys.exit("unknown profiles: " + ", ".join(unknown))
+    return {p["function"]: p for p in proofs}, profiles
+
+
+def load_timings(path):
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+
+def run_step(cmd, log):
+    log.write("$ " + " ".join(shlex.quote(c) for c in cmd) + "\n")
+    log.flush()
+    return subprocess.run(cmd, stdout=log, stderr=subprocess.STDOUT).returncode
+
+
+def profile_flags(profiles, profile):
+    """MODEL_FLAGS of a model profile, or of the plain model when profile is None."""
+    return " ".join([os.environ.get("MODEL_FLAGS", "")] + (profiles[profile] if profile else [])).strip()
+
+
+def build_model(build_dir, profiles, profile):
+    """Builds the model of a profile with build_model.sh, returning the directory of its goto binaries."""
+    if profile:
+        model_dir = os.path.join(build_dir, "model-" + profile)
+    else:
+        model_dir = os.environ.get("BUILD_DIR", os.path.join(build_dir, "model"))
+    env = dict(os.environ, BUILD_DIR=model_dir, MODEL_FLAGS=profile_flags(profiles, profile))
+    subprocess.run([os.path.join(ROOT, "build_model.sh")], check=True, env=env)
+    return model_dir
+
+
+def load_units(model_flags):
+    """Symbols of the model units in a configuration, exiting if a unit does not declare what it uses."""
+    try:
+        units = link_sets.Model(model_flags)
+        errors = units.check()
+    except RuntimeError as e:
+        sys.exit(str(e))
+    if errors:
+        sys.exit("\n".join(errors))
+    return units
+
+
+def run_proof(proof, model_dir, model_flags, units, build_dir):
+    """Builds and checks one proof, returning its result record. Runs on a worker thread.
+
+    units is the link_sets.Model of model_flags, or None to link the whole model.
+    """
+    name = proof["function"]
+    work = os.path.join(build_dir, name)
+    os.makedirs(work, exist_ok=True)
+    log_path = os.path.join(work, "log.txt")
+    includes = ["-I", os.path.join(ROOT, "include"), "-I", os.environ["CBMC_PROOF_INCLUDE"]]
+    harness = os.path.join(ROOT, proof["harness"])
+    if units is None:
+        link_set = None
+        objects = [os.path.join(model_dir, "libcrypto_model.goto")]
+    else:
+        try:
+            link_set = units.link_set(harness)
+        except RuntimeError as e:
+            with open(log_path, "w") as log:
+                log.write(str(e))
+            return {"function": name, "status": "ERROR", "time": 0.0, "log": log_path, "output": str(e)[-4000:]}
+        unexpected = link_sets.unexpected_units(proof["link_set"], link_set) if "link_set" in proof else []
+        if unexpected:
+            output = "link set exceeds the manifest: " + ", ".join(unit + ".c" for unit in unexpected)
+            with open(log_path, "w") as log:
+                log.write(output)
+            return {"function": name, "status": "ERROR", "time": 0.0, "log": log_path, "output": output}
+        objects = [os.path.join(model_dir, unit + ".goto") for unit in link_set]
+    linked = os.path.join(work, name + ".goto")
+
+    steps = [
+        ["goto-cc", "--function", "harness"]
+        + includes
+        + shlex.split(model_flags)
+        + ["-o", linked, harness]
+        + objects
+    ]
+    enforced = os.path.join(work, name + ".enforced.goto")
+    steps.append(["goto-instrument", "--enforce-contract", name, linked, enforced])
+    cbmc = ["cbmc"] + (shlex.split(os.environ["CBMC_FLAGS"]) if "CBMC_FLAGS" in os.environ else CBMC_CHECKS)
+    if proof.get("unwindset"):
+        cbmc += ["--unwindset", proof["unwindset"], "--unwinding-assertions"]
+    steps.append(cbmc + proof.get("cbmc_flags", []) + [enforced])
+
+    start = time.monotonic()
+    status = "PASS"
+    with open(log_path, "w") as log:
+        for i, cmd in enumerate(steps):
+            code = run_step(cmd, log)
+            if code != 0:
+                # CBMC exits with 10 when a property fails; any other failure is a broken proof setup.
+                status = "FAIL" if i == len(steps) - 1 and code == 10 else "ERROR"
+                break
+    if status == "PASS":
+        with open(log_path) as log:
+            if UNREACHED_COVER.search(log.read()):
+                status = "FAIL"
+    result = {"function": name, "status": status, "time": round(time.monotonic() - start, 3), "log": log_path}
+    if link_set is not None:
+        result["link_set"] = [unit + ".c" for unit in link_set]
+    if status != "PASS":
+        with open(log_path) as log:
+            result["output"] = log.read()[-4000:]
+    return result
+
+
+def write_junit(results, path):
+    suite = ET.Element(
+        "testsuite",
+        name="libcrypto-model-proofs",
+        tests=str(len(results)),
+        failures=str(sum(r["status"] == "FAIL" for r in results)),
+        errors=str(sum(r["status"] == "ERROR" for r in results)),
+        time="%.3f" % sum(r["time"] for r in results),
+    )
+    for r in results:
+        case = ET.SubElement(suite, "testcase", classname="proofs", name=r["function"], time="%.3f" % r["time"])
+        if r["status"] != "PASS":
+            tag = "failure" if r["status"] == "FAIL" else "error"
+            element = ET.SubElement(case, tag, message="%s %s (see %s)" % (r["status"], r["function"], r["log"]))
+            element.text = r["output"]
+    ET.ElementTree(suite).write(path, encoding="utf-8", xml_declaration=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("functions", nargs="*", help="proofs to run (default: all proofs of the manifest)")
+    parser.add_argument("--manifest", default=os.path.join(PROOFS, "manifest.json"), help="proof manifest")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count() or 1, help="parallel proofs (default: cores)")
+    parser.add_argument("--build-dir", default=os.environ.get("BUILD", os.path.join(PROOFS, "build")))
+    parser.add_argument("--json", default=None, help="JSON summary path (default: <build-dir>/summary.json)")
+    parser.add_argument("--junit", default=None, help="JUnit XML report path (default: <build-dir>/junit.xml)")
+    parser.add_argument("--full-model", action="store_true", help="link every proof with the whole model")
+    args = parser.parse_args()
+
+    if "CBMC_PROOF_INCLUDE" not in os.environ:
+        sys.exit("set CBMC_PROOF_INCLUDE to the directory of the proof helper headers")
+    manifest, profiles = load_manifest(args.manifest)
+    unknown = sorted(set(args.functions) - set(manifest))
+    if unknown:
+        sys.exit("unknown proofs: " + ", ".join(unknown))
+
+    os.makedirs(args.build_dir, exist_ok=True)
+
+    # Longest processing time first: the slowest proofs must not be the last ones to start.
+    timings_path = os.path.join(args.build_dir, "timings.json")
+    timings = load_timings(timings_path)
+    selected = sorted(args.functions or manifest, key=lambda name: (-timings.get(name, float("inf")), name))
+    used = sorted({manifest[name].get("profile") for name in selected}, key=lambda profile: profile or "")
+    models = {profile: build_model(args.build_dir, profiles, profile) for profile in used}
+    units = {profile: None if args.full_model else load_units(profile_flags(profiles, profile)) for profile in used}
+
+    results = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        futures = []
+        for name in selected:
+            profile = manifest[name].get("profile")
+            futures.append(
+                pool.submit(
+                    run_proof,
+                    manifest[name],
+                    models[profile],
+                    profile_flags(profiles, profile),
+                    units[profile],
+                    args.build_dir,
+                )
+            )
+        for future in concurrent.futures.as_completed(futures):
+            result = future.result()
+            print("%-5s %-28s %8.1fs" % (result["status"], result["function"], result["time"]), flush=True)
+            results.append(result)
+    results.sort(key=lambda r: r["function"])
+
+    timings.update({r["function"]: r["time"] for r in results})
+    with open(timings_path, "w") as f:
+        json.dump(timings, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+    failed = [r["function"] for r in results if r["status"] != "PASS"]
+    summary = {
+        "model_flags": os.environ.get("MODEL_FLAGS", ""),
+        "jobs": args.jobs,
+        "passed": len(results) - len(failed),
+        "failed": len(failed),
+        "proofs": [{k: v for k, v in r.items() if k != "output"} for r in results],
+    }
+    json_path = args.json or os.path.join(args.build_dir, "summary.json")
+    with open(json_path, "w") as f:
+        json.dump(summary, f, indent=2, sort_keys=True)
+        f.write("\n")
+    write_junit(results, args.junit or os.path.join(args.build_dir, "junit.xml"))
+
+    if failed:
+        print("%d of %d proofs failed: %s" % (len(failed), len(results), " ".join(failed)))
+        return 1
+    print("All %d proofs passed" % len(results))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,24 @@
+#!/bin/bash
+
+# Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"). You may not use
+# this file except in compliance with the License. A copy of the License is
+# located at
+#
+#     http://aws.amazon.com/apache2.0/
+#
+# or in the "license" file accompanying this file. This file is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+# implied. See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Checks the function contracts of the model against the override bodies. Kept for existing callers: the proofs are
+# listed in proofs/manifest.json and run in parallel by proofs/run_proofs.py, which takes the same arguments and
+# environment (CBMC_PROOF_INCLUDE, MODEL_FLAGS, CBMC_FLAGS, BUILD and BUILD_DIR).
+#
+# Usage: proofs/run_proofs.sh [<function>...]
+
+set -euo pipefail
+
+exec python3 "$(dirname "${BASH_SOURCE[0]}")/run_proofs.py" "$@"
@@ -21,15 +21,26 @@
 #include <proof_helpers/nondet.h>
 
 #include <bn_utils.h>
-
-/* Abstraction of ASN1_STRING data structure */
-struct asn1_string_st {
-    bool is_valid;
-};
+#include <failure_utils.h>
+#include <havoc_utils.h>
+#include <heap_utils.h>
+
+#include <limits.h>
+
+/* Size in bytes of the DER encoding (tag, length and contents octets) of the INTEGER a. */
+static long asn1_integer_der_size(const ASN1_INTEGER *a) {
+    long content_size = a->length == 0 ? 1 : (long)a->length + (a->needs_leading_zero ? 1 : 0);
+    /* Short form below 128 octets, otherwise an initial octet followed by the length in big-endian order. */
+    int length_size = 1;
+    if (content_size >= 0x80) {
+        length_size += 1 + (content_size > 0xFF) + (content_size > 0xFFFF) + (content_size > 0xFFFFFF);
+    }
+    return 1 + length_size + content_size;
+}
 
 /* Could not find OpenSSL documentation */
 void ASN1_STRING_clear_free(ASN1_STRING *a) {
-    free(a);
+    model_free(a);
 }
 
 bool asn1_integer_is_valid(ASN1_INTEGER *ai);
@@ -44,11 +55,7 @@ BIGNUM *ASN1_INTEGER_to_BN(const ASN1_INTEGER *ai, BIGNUM *bn) {
     assert(asn1_integer_is_valid(ai));
     assert(!bn);  // Assuming is always called with bn == NULL
 
-    BIGNUM *rv = bignum_nondet_alloc();
-
-    __CPROVER_assume(!rv || bignum_is_valid(rv));
-
-    return rv;
+    return bignum_nondet_valid_alloc();
 }
 
 /*
@@ -61,9 +68,13 @@ ASN1_INTEGER *BN_to_ASN1_INTEGER(const BIGNUM *bn, ASN1_INTEGER *ai) {
     assert(bignum_is_valid(bn));
     assert(!ai);  // Assuming is always called with ai == NULL
 
-    ASN1_INTEGER *rv = malloc(sizeof(ASN1_INTEGER));
+    ASN1_INTEGER *rv = model_malloc(sizeof(ASN1_INTEGER));
 
-    if (rv) rv->is_valid = true;
+    if (rv) {
+        rv->is_valid = true;
+        rv->length   = BN_num_bytes(bn);
+        __CPROVER_assume(0 <= rv->length);
+    }
 
     return rv;
 }
@@ -85,15 +96,17 @@ ASN1_INTEGER *d2i_ASN1_INTEGER(ASN1_INTEGER **a, unsigned char **ppin, long leng
     assert(*ppin);
     assert(__CPROVER_r_ok(*ppin, length));
 
-    *a = malloc(sizeof(ASN1_INTEGER));
+    *a = model_malloc(sizeof(ASN1_INTEGER));
 
     /* If *a is not NULL it might be in an invalid state */
-    if (*a == NULL || nondet_bool()) {
+    if (*a == NULL || inject_failure(LIBCRYPTO_MODEL_ASN1)) {
         return NULL;
     }
 
-    long offset;
-    __CPROVER_assume(0 <= offset && offset <= length);
+    /* Exactly the DER encoding of the decoded integer is consumed, so that re-encoding it yields the same size. */
+    __CPROVER_assume(0 <= (*a)->length);
+    long offset = asn1_integer_der_size(*a);
+    __CPROVER_assume(offset <= length && offset <= INT_MAX);
     *ppin += offset;
     (*a)->is_valid = true;
     return *a;
@@ -104,18 +117,32 @@ ASN1_INTEGER *d2i_ASN1_INTEGER(ASN1_INTEGER **a, unsigned char **ppin, long leng
  * DER encoded data to the buffer at *ppout, and increments it to point after the data just written. If the return value
  * is negative an error occurred, otherwise it returns the length of the encoded data. Return values: i2d_TYPE() returns
  * the number of bytes successfully encoded or a negative value if an error occurs.
+ * If *ppout is NULL then memory is allocated for a buffer and the encoded data written to it. In this case *ppout is
+ * not incremented and it points to the start of the data just written. The length of the encoding follows from the
+ * length of a, so a call with ppout == NULL returns the size of the buffer the next call writes to.
  */
 int i2d_ASN1_INTEGER(ASN1_INTEGER *a, unsigned char **ppout) {
     assert(asn1_integer_is_valid(a));
-    assert(ppout);
-    assert(!*ppout);  // Assuming is always called with *ppout == NULL, therefore needs to allocated the buffer
 
-    int buf_size;
-    __CPROVER_assume(0 < buf_size);
-    *ppout = malloc(buf_size);
+    int buf_size = asn1_integer_der_size(a);
+    if (ppout == NULL) return buf_size;  // Only the length is requested
+
+    if (*ppout != NULL) {
+        if (inject_failure(LIBCRYPTO_MODEL_ASN1)) {
+            int error_code = nondet_int();
+            __CPROVER_assume(error_code < 0);
+            return error_code;
+        }
+        assert(__CPROVER_w_ok(*ppout, buf_size));
+        write_unconstrained_data(*ppout, buf_size);
+        *ppout += buf_size;
+        return buf_size;
+    }
+
+    *ppout = model_malloc(buf_size);
 
     if (!*ppout) {
-        int error_code;
+        int error_code = nondet_int();
         __CPROVER_assume(error_code < 0);
         return error_code;
     }
@@ -128,5 +155,5 @@ int i2d_ASN1_INTEGER(ASN1_INTEGER *a, unsigned char **ppout) {
 /* CBMC helper functions */
 
 bool asn1_integer_is_valid(ASN1_INTEGER *ai) {
-    return ai && ai->is_valid;
+    return ai && ai->is_valid && 0 <= ai->length && asn1_integer_der_size(ai) <= INT_MAX;
 }
@@ -13,16 +13,136 @@
  * permissions and limitations under the License.
  */
 
+#include <assert.h>
+#include <cbmc_proof/nondet.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <model_config.h>
 #include <openssl/bio.h>
 #include <openssl/evp.h>
 #include <proof_helpers/proof_allocators.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
-/* Abstraction of the BIO struct */
-
+/*
+ * Abstraction of the BIO struct: a memory BIO holding length bytes at buf, of which the first read_offset have been
+ * read. A read-only BIO (see BIO_new_mem_buf) references the caller's buffer without copying it; a writable one (see
+ * BIO_new) owns its buffer, which is also pointed to by data.
+ */
 struct bio_st {
-    size_t key_len;
+    const unsigned char *buf;
+    unsigned char *data;
+    size_t length;
+    size_t read_offset;
+    bool is_read_only;
+};
+
+/* Abstraction of the BIO_METHOD struct. Memory BIOs are the only kind of BIO of the model. */
+struct bio_method_st {
+    int type;
 };
 
+static const BIO_METHOD mem_method = { BIO_TYPE_MEM };
+
+/* Number of bytes that have been written to bio but not read yet. */
+static size_t bio_pending(const BIO *bio) {
+    assert(bio->read_offset <= bio->length);
+    return bio->length - bio->read_offset;
+}
+
+/*
+ * Checks that the unread bytes of bio are still readable, which for a read-only BIO means that the caller's buffer
+ * outlives the BIO, and returns a pointer to them.
+ */
+static const unsigned char *bio_unread_data(const BIO *bio) {
+    const unsigned char *unread = bio->buf + bio->read_offset;
+    assert(bio_pending(bio) == 0 || __CPROVER_r_ok(unread, bio_pending(bio)));
+    return unread;
+}
+
+/* Reads one PEM block from bp: a nondeterministic prefix of its unread bytes. */
+static void bio_read_pem_block(BIO *bp) {
+    if (bp == NULL) return;
+
+    bio_unread_data(bp);
+    size_t consumed = nondet_size_t();
+    __CPROVER_assume(consumed <= bio_pending(bp));
+    bp->read_offset += consumed;
+}
+
+#ifdef LIBCRYPTO_MODEL_PARSE_CACHE
+/*
+ * Most recent successful PEM read of one kind of key (see LIBCRYPTO_MODEL_PARSE_CACHE in model_config.h): the unread
+ * bytes of the memory BIO it read from, the number of bytes it consumed, and the resulting key, of which the cache
+ * holds one reference.
+ */
+struct pem_key_cache {
+    const unsigned char *in;
+    size_t pending;
+    size_t consumed;
+    EVP_PKEY *pkey;
+};
+
+static struct pem_key_cache pem_pubkey_cache;
+static struct pem_key_cache pem_private_key_cache;
+
+/* Returns the cached key of the unread bytes of bp with one more reference, or reads a fresh key and caches it. */
+static EVP_PKEY *pem_key_cache_read(struct pem_key_cache *cache, BIO *bp) {
+    if (bp != NULL && cache->pkey != NULL && bio_unread_data(bp) == cache->in && bio_pending(bp) == cache->pending) {
+        bp->read_offset += cache->consumed;
+        EVP_PKEY_up_ref(cache->pkey);
+        return cache->pkey;
+    }
+
+    size_t read_offset = bp != NULL ? bp->read_offset : 0;
+    bio_read_pem_block(bp);
+    EVP_PKEY *pkey = EVP_PKEY_new();
+    if (bp != NULL && pkey != NULL) {
+        EVP_PKEY_free(cache->pkey);
+        EVP_PKEY_up_ref(pkey);
+        cache->in       = bp->buf + read_offset;
+        cache->pending  = bp->length - read_offset;
+        cache->consumed = bp->read_offset - read_offset;
+        cache->pkey     = pkey;
+    }
+    return pkey;
+}
+
+#    define PEM_READ_KEY(cache, bp) pem_key_cache_read(&(cache), (bp))
+#else
+#    define PEM_READ_KEY(cache, bp) (bio_read_pem_block(bp), EVP_PKEY_new())
+#endif
+
+/*
+ * Description: BIO_s_mem() returns the memory BIO method function. A memory BIO is a source/sink BIO which uses memory
+ * for its I/O. Data written to a memory BIO is stored in a BUF_MEM structure which is extended as appropriate to
+ * accommodate the stored data.
+ */
+const BIO_METHOD *BIO_s_mem(void) {
+    return &mem_method;
+}
+
+/*
+ * Description: The BIO_new() function returns a new BIO using method type.
+ * Return values: BIO_new() returns a newly created BIO or NULL if the call fails.
+ */
+BIO *BIO_new(const BIO_METHOD *type) {
+    assert(type == &mem_method);
+
+    if (inject_failure(LIBCRYPTO_MODEL_BIO)) return NULL;
+
+    BIO *bio = model_malloc(sizeof(BIO));
+    if (bio) {
+        bio->buf          = NULL;
+        bio->data         = NULL;
+        bio->length       = 0;
+        bio->read_offset  = 0;
+        bio->is_read_only = false;
+    }
+    return bio;
+}
+
 /*
  * Decription: BIO_new_mem_buf() creates a memory BIO using len bytes of data at buf, if len is -1 then the buf is
  * assumed to be null terminated and its length is determined by strlen. The BIO is set to a read only state and as a
@@ -31,28 +151,94 @@ struct bio_st {
  * supplied area of memory must be unchanged until the BIO is freed.
  */
 BIO *BIO_new_mem_buf(const void *buf, signed int len) {
-    BIO *bio = malloc(sizeof(BIO));
+    if (buf == NULL) return NULL;
+
+    size_t length = len < 0 ? strlen(buf) : (size_t)len;
+    assert(length == 0 || __CPROVER_r_ok(buf, length));
+
+    if (inject_failure(LIBCRYPTO_MODEL_BIO)) return NULL;
+
+    BIO *bio = model_malloc(sizeof(BIO));
     if (bio) {
-        bio->key_len = len;
+        bio->buf          = buf;
+        bio->data         = NULL;
+        bio->length       = length;
+        bio->read_offset  = 0;
+        bio->is_read_only = true;
     }
     return bio;
 }
 
+/*
+ * Description: BIO_read() attempts to read dlen bytes from BIO b and places the data in data.
+ * Return values: BIO_read() returns the amount of data successfully read. If the return value is 0 or -1, no data
+ * could be read: a read-only memory BIO returns 0 once all of its data has been read and a writable one returns -1.
+ * -2 indicates that the operation is not supported by b.
+ */
+int BIO_read(BIO *b, void *data, int dlen) {
+    if (b == NULL) return -2;
+    if (dlen < 0) return -1;
+
+    size_t pending = bio_pending(b);
+    if (pending == 0) return b->is_read_only ? 0 : -1;
+    if (dlen == 0) return 0;
+
+    size_t amount = pending < (size_t)dlen ? pending : (size_t)dlen;
+    assert(__CPROVER_w_ok(data, amount));
+    memcpy(data, bio_unread_data(b), amount);
+    b->read_offset += amount;
+    return (int)amount;
+}
+
+/*
+ * Description: BIO_write() attempts to write dlen bytes from data to BIO b.
+ * Return values: BIO_write() returns the amount of data successfully written, or -1 on error. Writing to a read-only
+ * memory BIO always fails.
+ */
+int BIO_write(BIO *b, const void *data, int dlen) {
+    if (b == NULL) return -2;
+    if (dlen < 0 || b->is_read_only) return -1;
+    if (dlen == 0) return 0;
+
+    assert(__CPROVER_r_ok(data, dlen));
+    if (b->length > SIZE_MAX - dlen || inject_failure(LIBCRYPTO_MODEL_BIO)) return -1;
+
+    unsigned char *grown = model_realloc(b->data, b->length + dlen);
+    if (grown == NULL) return -1;
+
+    memcpy(grown + b->length, data, dlen);
+    b->length += dlen;
+
+    b->data = grown;
+    b->buf  = grown;
+    return dlen;
+}
+
+/*
+ * Description: BIO_ctrl_pending() returns the number of pending characters in the BIO's read buffer.
+ */
+size_t BIO_ctrl_pending(BIO *b) {
+    assert(b != NULL);
+    return bio_pending(b);
+}
+
 /*
  * The PUBKEY functions process a public key using an EVP_PKEY structure. The public key is encoded as a
  * SubjectPublicKeyInfo structure.
  */
 EVP_PKEY *PEM_read_bio_PUBKEY(BIO *bp, EVP_PKEY **x, pem_password_cb *cb, void *u) {
-    *x = EVP_PKEY_new();
-    return *x;
+    EVP_PKEY *pkey = PEM_READ_KEY(pem_pubkey_cache, bp);
+    if (x != NULL) *x = pkey;
+    return pkey;
 }
 
 /*
  * Read a private key from a BIO.
  */
 EVP_PKEY *PEM_read_bio_PrivateKey(BIO *bp, EVP_PKEY **x, pem_password_cb *cb, void *u) {
-    *x = EVP_PKEY_new();
-    return *x;
+    EVP_PKEY *pkey = PEM_READ_KEY(pem_private_key_cache, bp);
+    if (x != NULL) *x = pkey;
+    return pkey;
 }
 
 /*
@@ -60,9 +246,13 @@ EVP_PKEY *PEM_read_bio_PrivateKey(BIO *bp, EVP_PKEY **x, pem_password_cb *cb, vo
  * If a is NULL nothing is done. Calling BIO_free() may also have some effect on the underlying I/O structure,
  * for example it may close the file being referred to under certain circumstances. For more details see the individual
  * BIO_METHOD descriptions.
+ * Return values: BIO_free() returns 1 for success and 0 for failure.
  */
 int BIO_free(BIO *a) {
-    if (a != NULL) {
-        free(a);
-    }
+    if (a == NULL) return 0;
+
+    // The buffer of a read-only BIO belongs to the caller.
+    model_free(a->data);
+    model_free(a);
+    return 1;
 }
@@ -14,10 +14,20 @@
  */
 
 #include <bn_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
 
 #include <assert.h>
+#include <limits.h>
 #include <math.h>
 
+DEFINE_MODEL_POOL(BIGNUM, bignum)
+
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+/* Largest number of bits a BIGNUM may have, so that BN_num_bytes() cannot overflow. */
+#    define BN_MODEL_MAX_BITS (INT_MAX - 7)
+#endif
+
 /*
  * Description: BN_new() allocates and initializes a BIGNUM structure.
  * Return values: BN_new() and BN_secure_new() return a pointer to the
@@ -25,10 +35,16 @@
  * return NULL and set an error code that can be obtained by ERR_get_error(3).
  */
 BIGNUM *BN_new(void) {
-    BIGNUM *rv = malloc(sizeof(BIGNUM));
+    BIGNUM *rv = bignum_pool_alloc();
     if (rv) {
         rv->is_initialized = true;
-        rv->d              = malloc(sizeof(*(rv->d)));
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+        rv->is_zero  = true;
+        rv->num_bits = 0;
+#else
+        rv->d   = model_malloc(sizeof(*(rv->d)));
+        rv->top = 0;
+#endif
     }
 
     /* Assuming error codes can be safely ignored. */
@@ -47,7 +63,14 @@ BIGNUM *BN_dup(const BIGNUM *from) {
     /* *dup = *from; */
 
     /* Guarantees that return value will be either NULL or initialized. */
-    return BN_new();
+    BIGNUM *dup = BN_new();
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    if (dup) {
+        dup->is_zero  = from->is_zero;
+        dup->num_bits = from->num_bits;
+    }
+#endif
+    return dup;
 }
 
 /*
@@ -62,7 +85,10 @@ int BN_sub(BIGNUM *r, const BIGNUM *a, const BIGNUM *b) {
     assert(bignum_is_valid(a));
     assert(bignum_is_valid(b));
 
-    r->is_initialized = nondet_bool();
+    r->is_initialized = !inject_failure(LIBCRYPTO_MODEL_BN);
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    bignum_havoc_value(r);
+#endif
 
     return r->is_initialized;
 }
@@ -73,8 +99,10 @@ int BN_sub(BIGNUM *r, const BIGNUM *a, const BIGNUM *b) {
  */
 void BN_free(BIGNUM *a) {
     if (a != NULL) {
-        free(a->d);
-        free(a);
+#ifndef LIBCRYPTO_MODEL_BIGNUM_LITE
+        model_free(a->d);
+#endif
+        bignum_pool_free(a);
     }
 }
 
@@ -88,17 +116,53 @@ void BN_clear_free(BIGNUM *a) {
 }
 
 int BN_is_zero(BIGNUM *a) {
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    return a->is_zero;
+#else
     return (a->top == 0);
+#endif
 }
 
 /* CBMC helper functions */
 
 bool bignum_is_valid(BIGNUM *a) {
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    return a && a->is_initialized && (a->is_zero == (a->num_bits == 0)) && 0 <= a->num_bits &&
+           a->num_bits <= BN_MODEL_MAX_BITS;
+#else
     return a && a->is_initialized;
+#endif
 }
 
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+/* Helper function for CBMC proofs: makes the abstract value of a unconstrained but consistent. */
+void bignum_havoc_value(BIGNUM *a) {
+    int num_bits = nondet_int();
+    __CPROVER_assume(0 <= num_bits && num_bits <= BN_MODEL_MAX_BITS);
+    a->num_bits = num_bits;
+    a->is_zero  = (num_bits == 0);
+}
+#endif
+
 BIGNUM *bignum_nondet_alloc() {
-    return malloc(sizeof(BIGNUM));
+    return bignum_pool_alloc();
+}
+
+/*
+ * Helper function for CBMC proofs: allocates a BIGNUM that satisfies bignum_is_valid() by construction, with an
+ * unconstrained value, or returns NULL when the allocation fails.
+ */
+BIGNUM *bignum_nondet_valid_alloc() {
+    BIGNUM *bn = bignum_pool_alloc();
+    if (bn != NULL) {
+        bn->is_initialized = true;
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+        bignum_havoc_value(bn);
+#else
+        bn->d = NULL; /* The value is abstract: top is left unconstrained. */
+#endif
+    }
+    return bn;
 }
 
 BIGNUM *BN_bin2bn(const unsigned char *s, int len, BIGNUM *ret) {
@@ -106,19 +170,36 @@ BIGNUM *BN_bin2bn(const unsigned char *s, int len, BIGNUM *ret) {
     if (ret == NULL) {
         ret = BN_new();
     }
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    if (ret != NULL) {
+        bignum_havoc_value(ret);
+        __CPROVER_assume(ret->num_bits <= 8 * (long)len);
+    }
+#endif
     return ret;
 }
 
 int BN_num_bits(const BIGNUM *a) {
     assert(a != NULL);
-    unsigned int w;
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    return a->num_bits;
+#else
+    unsigned int w = nondet_uint();
     /* Basically, except for a zero, it returns floor(log2(w))+1. */
     __CPROVER_assume(w <= 65 /* floor(log2(SIZE_MAX))+1 */);
     return w;
+#endif
 }
 
 int BN_bn2bin(const BIGNUM *a, unsigned char *to) {
     assert(a != NULL);
     assert(to != NULL);
+#ifdef LIBCRYPTO_MODEL_BIGNUM_LITE
+    int len = BN_num_bytes(a);
+    assert(__CPROVER_w_ok(to, len));
+    __CPROVER_havoc_slice(to, len);
+    return len;
+#else
     return nondet_int();
+#endif
 }
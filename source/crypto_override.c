@@ -0,0 +1,90 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <assert.h>
+#include <heap_utils.h>
+#include <openssl/crypto.h>
+#include <thread_utils.h>
+
+/*
+ * Description: CRYPTO_THREAD_lock_new() allocates, initializes and returns a new read/write lock.
+ * Return values: The new lock, or NULL on allocation failure.
+ */
+CRYPTO_RWLOCK *CRYPTO_THREAD_lock_new(void) {
+    CRYPTO_RWLOCK *lock = model_malloc(sizeof(CRYPTO_RWLOCK));
+    if (lock != NULL) {
+        lock->readers = 0;
+        lock->writer  = false;
+    }
+    return lock;
+}
+
+/*
+ * Description: CRYPTO_THREAD_read_lock() locks the provided lock for reading, waiting while a writer holds it.
+ * Return values: 1 on success. The model never fails.
+ */
+int CRYPTO_THREAD_read_lock(CRYPTO_RWLOCK *lock) {
+    assert(lock != NULL);
+    MODEL_ATOMIC_BEGIN();
+    MODEL_WAIT_UNTIL(!lock->writer);
+    lock->readers += 1;
+    MODEL_ATOMIC_END();
+    return 1;
+}
+
+/*
+ * Description: CRYPTO_THREAD_write_lock() locks the provided lock for writing, waiting while any reader or writer
+ * holds it.
+ * Return values: 1 on success. The model never fails.
+ */
+int CRYPTO_THREAD_write_lock(CRYPTO_RWLOCK *lock) {
+    assert(lock != NULL);
+    MODEL_ATOMIC_BEGIN();
+    MODEL_WAIT_UNTIL(!lock->writer && lock->readers == 0);
+    lock->writer = true;
+    MODEL_ATOMIC_END();
+    return 1;
+}
+
+/*
+ * Description: CRYPTO_THREAD_unlock() unlocks a lock that the calling thread holds for reading or writing. The model
+ * does not track which thread holds a lock, only that it is held.
+ * Return values: 1 on success.
+ */
+int CRYPTO_THREAD_unlock(CRYPTO_RWLOCK *lock) {
+    assert(lock != NULL);
+    MODEL_ATOMIC_BEGIN();
+    if (lock->writer) {
+        lock->writer = false;
+    } else {
+        assert(lock->readers > 0); /* Unlocking a lock that is not held. */
+        lock->readers -= 1;
+    }
+    MODEL_ATOMIC_END();
+    return 1;
+}
+
+/*
+ * Description: CRYPTO_THREAD_lock_free() frees the provided lock, which must not be held. NULL is ignored.
+ */
+void CRYPTO_THREAD_lock_free(CRYPTO_RWLOCK *lock) {
+    if (lock == NULL) return;
+    assert(!lock->writer && lock->readers == 0);
+    model_free(lock);
+}
+
+/*
+ * Description: CRYPTO_atomic_add() atomically adds amount to *val and returns the result of the operation in *ret.
+ * lock will be locked, unless atomic operations are supported on the specific platform, which the model assumes.
+ * Return values: 1 on success.
+ */
+int CRYPTO_atomic_add(int *val, int amount, int *ret, CRYPTO_RWLOCK *lock) {
+    assert(val != NULL && ret != NULL);
+    MODEL_ATOMIC_BEGIN();
+    *val += amount;
+    *ret = *val;
+    MODEL_ATOMIC_END();
+    return 1;
+}
@@ -15,71 +15,172 @@
  * permissions and limitations under the License.
  */
 
+#include <bn_utils.h>
+#include <failure_utils.h>
 #include <openssl/dh.h>
 #include <openssl/ossl_typ.h>
+#include <pool_utils.h>
+#include <refcount_utils.h>
 
 #include <assert.h>
 
+DEFINE_MODEL_POOL(DH, dh)
+
+#ifdef LIBCRYPTO_MODEL_PARSE_CACHE
+/*
+ * Most recent successful d2i_DHparams() call (see LIBCRYPTO_MODEL_PARSE_CACHE in model_config.h): its input, the
+ * number of bytes it consumed, and the resulting DH, of which the cache holds one reference.
+ */
+static struct {
+    const unsigned char *in;
+    long length;
+    long consumed;
+    DH *dh;
+} dh_params_cache;
+#endif
+
+/*
+ * Frees clause targets of DH_free(dh), for function contracts: the objects that are released when cond holds. A DH is
+ * only released together with its last reference, and only frees the parameters it does not share.
+ */
+#define DH_FREES(cond, dh)                                                                                \
+    (cond) && (dh) != NULL && (dh)->references == 1: (dh);                                                \
+    BIGNUM_FREES((cond) && (dh) != NULL && (dh)->references == 1, (dh)->pub_key);                         \
+    BIGNUM_FREES((cond) && (dh) != NULL && (dh)->references == 1, (dh)->priv_key);                        \
+    BIGNUM_FREES((cond) && (dh) != NULL && (dh)->references == 1 && (dh)->params_owner == NULL, (dh)->p); \
+    BIGNUM_FREES((cond) && (dh) != NULL && (dh)->references == 1 && (dh)->params_owner == NULL, (dh)->q); \
+    BIGNUM_FREES((cond) && (dh) != NULL && (dh)->references == 1 && (dh)->params_owner == NULL, (dh)->g)
+
+/* Assigns clause targets of DH_free(dh) when cond holds, for function contracts. */
+#define DH_RELEASE_ASSIGNS(cond, dh) (cond) && (dh) != NULL: (dh)->references
+
 bool openssl_DH_is_valid(const DH *dh) {
     return __CPROVER_w_ok(dh, sizeof(*dh));
 }
 
 DH *DH_new(void) {
-    DH *dh = malloc(sizeof(*dh));
+    DH *dh = dh_pool_alloc();
     if (dh != NULL) {
-        dh->pub_key  = BN_new();
-        dh->priv_key = BN_new();
-        dh->p        = BN_new();
-        dh->q        = BN_new();
-        dh->g        = BN_new();
+        refcount_init(&dh->references);
+        dh->pub_key      = BN_new();
+        dh->priv_key     = BN_new();
+        dh->p            = BN_new();
+        dh->q            = BN_new();
+        dh->g            = BN_new();
+        dh->params_owner = NULL;
+        dh->params_dups  = 0;
     }
     return dh;
 }
 
-int DH_size(const DH *dh) {
+int DH_size(const DH *dh)
+    __CPROVER_requires(__CPROVER_w_ok(dh, sizeof(*dh)) && dh->p != NULL)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value > 0)
+{
     /**
      * Both dh and dh->p must not be NULL.
      * Per https://www.openssl.org/docs/man1.1.0/man3/DH_size.html.
      */
     assert(openssl_DH_is_valid(dh));
     assert(dh->p != NULL);
-    int size;
+    int size = nondet_int();
     __CPROVER_assume(0 < size);
     return size;
 }
 
-void DH_free(DH *dh) {
-    assert(dh == NULL || openssl_DH_is_valid(dh));
-    if (dh != NULL) {
-        BN_free(dh->pub_key);
-        BN_free(dh->priv_key);
+/* Frees dh, whose last reference was released, along with its keys and the parameters it does not share. */
+static void dh_destroy(DH *dh) {
+    BN_free(dh->pub_key);
+    BN_free(dh->priv_key);
+    if (dh->params_owner == NULL) {
         BN_free(dh->p);
         BN_free(dh->q);
         BN_free(dh->g);
-        free(dh);
     }
-    return;
+    dh_pool_free(dh);
+}
+
+void DH_free(DH *dh) {
+    assert(dh == NULL || openssl_DH_is_valid(dh));
+    if (dh == NULL || !refcount_release(&dh->references)) return;
+
+    /* Releasing a duplicate releases its reference to the owner of its parameters, which may be the last one. */
+    DH *params_owner = dh->params_owner;
+    dh_destroy(dh);
+    if (params_owner != NULL) {
+        params_owner->params_dups -= 1;
+        if (refcount_release(&params_owner->references)) dh_destroy(params_owner);
+    }
 }
 
-/* Returns a dummy DH that can't be dereferenced. */
+/*
+ * Description: DH_up_ref() increments the reference count for the dh object.
+ * Return values: DH_up_ref() returns 1 for success and 0 for failure.
+ */
+int DH_up_ref(DH *dh)
+    __CPROVER_requires(openssl_DH_is_valid(dh) && refcount_is_live(dh->references))
+    __CPROVER_requires(dh->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_assigns(dh->references)
+    __CPROVER_ensures(dh->references == __CPROVER_old(dh->references) + 1)
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+{
+    assert(openssl_DH_is_valid(dh));
+
+    refcount_acquire(&dh->references);
+    return 1;
+}
+
+/*
+ * Returns a new refcounted DH with fresh bignums, or NULL. The input isn't parsed.
+ * With LIBCRYPTO_MODEL_PARSE_CACHE, the cache keeps a reference to the DH of the last successful call, and parsing the
+ * same input again returns that DH with one more reference.
+ */
 DH *d2i_DHparams(DH **a, const unsigned char **pp, long length) {
     assert(pp != NULL);
-    DH *dummy_dh = malloc(sizeof(*dummy_dh));
-    if (dummy_dh != NULL) {
-        dummy_dh->pub_key  = BN_new();
-        dummy_dh->priv_key = BN_new();
-        dummy_dh->p        = BN_new();
-        dummy_dh->g        = BN_new();
-        dummy_dh->q        = BN_new();
-        if (a != NULL) *a = dummy_dh;
+#ifdef LIBCRYPTO_MODEL_PARSE_CACHE
+    if (dh_params_cache.dh != NULL && *pp == dh_params_cache.in && length == dh_params_cache.length) {
+        refcount_acquire(&dh_params_cache.dh->references);
+        if (a != NULL) *a = dh_params_cache.dh;
+        *pp += dh_params_cache.consumed;
+        return dh_params_cache.dh;
+    }
+    const unsigned char *in = *pp;
+#endif
+    DH *dh = dh_pool_alloc();
+    if (dh != NULL) {
+        refcount_init(&dh->references);
+        dh->pub_key      = BN_new();
+        dh->priv_key     = BN_new();
+        dh->p            = BN_new();
+        dh->g            = BN_new();
+        dh->q            = BN_new();
+        dh->params_owner = NULL;
+        dh->params_dups  = 0;
+        if (a != NULL) *a = dh;
     }
     if (nondet_bool() && *pp != NULL) {
         *pp = *pp + length;
     }
-    return dummy_dh;
+#ifdef LIBCRYPTO_MODEL_PARSE_CACHE
+    if (dh != NULL && in != NULL) {
+        DH_free(dh_params_cache.dh);
+        refcount_acquire(&dh->references);
+        dh_params_cache.in       = in;
+        dh_params_cache.length   = length;
+        dh_params_cache.consumed = *pp - in;
+        dh_params_cache.dh       = dh;
+    }
+#endif
+    return dh;
 }
 
-int DH_check(DH *dh, int *codes) {
+int DH_check(DH *dh, int *codes)
+    __CPROVER_requires(dh != NULL)
+    __CPROVER_requires(__CPROVER_w_ok(codes, sizeof(*codes)))
+    __CPROVER_assigns(*codes)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
     /**
      * Only check for nullness at this point, since we need to re-evaluate all validty functions.
      * See https://github.com/awslabs/aws-verification-model-for-libcrypto/issues/17.
@@ -87,7 +188,7 @@ int DH_check(DH *dh, int *codes) {
     assert(dh != NULL);
     assert(codes != NULL);
     *codes = nondet_int();
-    return (int)nondet_bool();
+    return inject_failure(LIBCRYPTO_MODEL_DH) ? 0 : 1;
 }
 
 /**
@@ -96,7 +197,16 @@ int DH_check(DH *dh, int *codes) {
  * *p, *q and *g will be set to NULL.
  * Per https://www.openssl.org/docs/man1.1.0/man3/DH_get0_pqg.html.
  */
-void DH_get0_pqg(const DH *dh, BIGNUM **p, const BIGNUM **q, const BIGNUM **g) {
+void DH_get0_pqg(const DH *dh, const BIGNUM **p, const BIGNUM **q, const BIGNUM **g)
+    __CPROVER_requires(__CPROVER_w_ok(dh, sizeof(*dh)))
+    __CPROVER_requires(p == NULL || __CPROVER_w_ok(p, sizeof(*p)))
+    __CPROVER_requires(q == NULL || __CPROVER_w_ok(q, sizeof(*q)))
+    __CPROVER_requires(g == NULL || __CPROVER_w_ok(g, sizeof(*g)))
+    __CPROVER_assigns(p != NULL: *p; q != NULL: *q; g != NULL: *g)
+    __CPROVER_ensures(p == NULL || *p == dh->p)
+    __CPROVER_ensures(q == NULL || *q == dh->q)
+    __CPROVER_ensures(g == NULL || *g == dh->g)
+{
     assert(openssl_DH_is_valid(dh));
     if (p != NULL) {
         if (dh->p != NULL) {
@@ -121,13 +231,22 @@ void DH_get0_pqg(const DH *dh, BIGNUM **p, const BIGNUM **q, const BIGNUM **g) {
     }
 }
 
-int DH_compute_key(unsigned char *key, const BIGNUM *pub_key, DH *dh) {
+int DH_compute_key(unsigned char *key, const BIGNUM *pub_key, DH *dh)
+    __CPROVER_requires(pub_key != NULL)
+    __CPROVER_requires(__CPROVER_w_ok(dh, sizeof(*dh)) && dh->p != NULL)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == -1 || __CPROVER_return_value > 0)
+{
     assert(pub_key != NULL);
     assert(dh != NULL);
-    return nondet_bool() ? DH_size(dh) : -1;
+    return inject_failure(LIBCRYPTO_MODEL_DH) ? -1 : DH_size(dh);
 }
 
-int DH_generate_key(DH *dh) {
+int DH_generate_key(DH *dh)
+    __CPROVER_requires(dh != NULL && dh->p != NULL && dh->g != NULL)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
     /**
      * DH_generate_key() expects dh to contain the shared parameters dh->p and dh->g.
      * Per https://www.openssl.org/docs/man1.1.0/man3/DH_generate_key.html.
@@ -135,41 +254,156 @@ int DH_generate_key(DH *dh) {
     assert(dh != NULL);
     assert(dh->p != NULL);
     assert(dh->g != NULL);
-    return (int)nondet_bool();
+    return inject_failure(LIBCRYPTO_MODEL_DH) ? 0 : 1;
+}
+
+/**
+ * The public and private key can be obtained by calling DH_get0_key(). If the keys have not yet been set then
+ * *pub_key and *priv_key will be set to NULL.
+ * Per https://www.openssl.org/docs/man1.1.1/man3/DH_get0_key.html.
+ */
+void DH_get0_key(const DH *dh, const BIGNUM **pub_key, const BIGNUM **priv_key)
+    __CPROVER_requires(__CPROVER_r_ok(dh, sizeof(*dh)))
+    __CPROVER_requires(pub_key == NULL || __CPROVER_w_ok(pub_key, sizeof(*pub_key)))
+    __CPROVER_requires(priv_key == NULL || __CPROVER_w_ok(priv_key, sizeof(*priv_key)))
+    __CPROVER_assigns(pub_key != NULL: *pub_key; priv_key != NULL: *priv_key)
+    __CPROVER_ensures(pub_key == NULL || *pub_key == dh->pub_key)
+    __CPROVER_ensures(priv_key == NULL || *priv_key == dh->priv_key)
+{
+    assert(dh != NULL);
+    if (pub_key != NULL) *pub_key = dh->pub_key;
+    if (priv_key != NULL) *priv_key = dh->priv_key;
 }
 
+/*
+ * Gives the duplicate dh its own copies of the shared parameters that are not replaced (the NULL ones among p, q and
+ * g), and releases the owner of the shared ones. Returns false, leaving dh unchanged, if a copy cannot be allocated.
+ */
+static bool dh_unshare_params(DH *dh, const BIGNUM *p, const BIGNUM *q, const BIGNUM *g) {
+    DH *owner     = dh->params_owner;
+    BIGNUM *own_p = (p == NULL && owner->p != NULL) ? BN_dup(owner->p) : NULL;
+    BIGNUM *own_q = (q == NULL && owner->q != NULL) ? BN_dup(owner->q) : NULL;
+    BIGNUM *own_g = (g == NULL && owner->g != NULL) ? BN_dup(owner->g) : NULL;
+    if ((p == NULL && owner->p != NULL && own_p == NULL) || (q == NULL && owner->q != NULL && own_q == NULL) ||
+        (g == NULL && owner->g != NULL && own_g == NULL)) {
+        BN_free(own_p);
+        BN_free(own_q);
+        BN_free(own_g);
+        return false;
+    }
+
+    /* The replaced parameters are set by the caller. */
+    dh->p            = own_p;
+    dh->q            = own_q;
+    dh->g            = own_g;
+    dh->params_owner = NULL;
+    owner->params_dups -= 1;
+    DH_free(owner);
+    return true;
+}
+
+/**
+ * The p, q and g parameters can be set by calling DH_set0_pqg() and freed along with dh. p and g must be non-NULL
+ * unless dh already has them, the NULL ones are kept. A duplicate of DHparams_dup() gets its own parameters. The
+ * parameters of a DH that duplicates still share cannot be replaced, since the duplicates would keep using the freed
+ * ones: dh must have no duplicates left.
+ * Returns 1 on success or 0 on failure, in which case the caller keeps the ownership of p, q and g.
+ * Per https://www.openssl.org/docs/man1.1.1/man3/DH_set0_pqg.html.
+ */
+int DH_set0_pqg(DH *dh, BIGNUM *p, BIGNUM *q, BIGNUM *g)
+    __CPROVER_requires(openssl_DH_is_valid(dh) && dh->params_dups == 0)
+    __CPROVER_requires(dh->params_owner == NULL || openssl_DH_is_valid(dh->params_owner))
+    __CPROVER_requires(p == NULL || (bignum_is_valid(p) && p != dh->p))
+    __CPROVER_requires(q == NULL || (bignum_is_valid(q) && q != dh->q))
+    __CPROVER_requires(g == NULL || (bignum_is_valid(g) && g != dh->g))
+    __CPROVER_assigns(p != NULL: dh->p; q != NULL: dh->q, dh->length; g != NULL: dh->g;
+                      dh->params_owner != NULL: dh->p, dh->q, dh->g, dh->params_owner, dh->params_owner->params_dups;
+                      DH_RELEASE_ASSIGNS(dh->params_owner != NULL, dh->params_owner))
+    __CPROVER_frees(BIGNUM_FREES(p != NULL && dh->params_owner == NULL, dh->p);
+                    BIGNUM_FREES(q != NULL && dh->params_owner == NULL, dh->q);
+                    BIGNUM_FREES(g != NULL && dh->params_owner == NULL, dh->g);
+                    DH_FREES(dh->params_owner != NULL, dh->params_owner))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || dh->params_owner == NULL)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || ((p == NULL || dh->p == p) && (q == NULL || dh->q == q) &&
+                                                      (g == NULL || dh->g == g)))
+{
+    assert(openssl_DH_is_valid(dh));
+    assert(dh->params_dups == 0);
+    assert(p == NULL || bignum_is_valid(p));
+    assert(q == NULL || bignum_is_valid(q));
+    assert(g == NULL || bignum_is_valid(g));
+
+    if ((dh->p == NULL && p == NULL) || (dh->g == NULL && g == NULL)) return 0;
+    if (dh->params_owner != NULL && !dh_unshare_params(dh, p, q, g)) return 0;
+
+    if (p != NULL) {
+        BN_free(dh->p);
+        dh->p = p;
+    }
+    if (q != NULL) {
+        BN_free(dh->q);
+        dh->q      = q;
+        dh->length = BN_num_bits(q);
+    }
+    if (g != NULL) {
+        BN_free(dh->g);
+        dh->g = g;
+    }
+    return 1;
+}
+
+/**
+ * The public and private key can be set by calling DH_set0_key() and freed along with dh. The NULL ones are kept.
+ * Per https://www.openssl.org/docs/man1.1.1/man3/DH_set0_key.html.
+ */
+int DH_set0_key(DH *dh, BIGNUM *pub_key, BIGNUM *priv_key)
+    __CPROVER_requires(__CPROVER_rw_ok(dh, sizeof(*dh)))
+    __CPROVER_requires(pub_key == NULL || pub_key != dh->pub_key)
+    __CPROVER_requires(priv_key == NULL || priv_key != dh->priv_key)
+    __CPROVER_assigns(pub_key != NULL: dh->pub_key; priv_key != NULL: dh->priv_key)
+    __CPROVER_frees(BIGNUM_FREES(pub_key != NULL, dh->pub_key); BIGNUM_FREES(priv_key != NULL, dh->priv_key))
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+    __CPROVER_ensures(pub_key == NULL || dh->pub_key == pub_key)
+    __CPROVER_ensures(priv_key == NULL || dh->priv_key == priv_key)
+{
+    assert(dh != NULL);
+    if (pub_key != NULL) {
+        BN_clear_free(dh->pub_key);
+        dh->pub_key = pub_key;
+    }
+    if (priv_key != NULL) {
+        BN_clear_free(dh->priv_key);
+        dh->priv_key = priv_key;
+    }
+    return 1;
+}
+
+/*
+ * Returns a DH with the parameters of dh and a fresh key pair. The parameters are not copied but shared with dh (or
+ * with the DH that dh shares them with), of which the duplicate holds a reference: see params_owner in dh.h.
+ */
 DH *DHparams_dup(const DH *dh) {
-    DH *ret;
-    ret = DH_new();
+    assert(openssl_DH_is_valid(dh));
+    DH *owner = dh->params_owner != NULL ? dh->params_owner : (DH *)dh;
+
+    DH *ret = dh_pool_alloc();
     if (ret == NULL) return NULL;
-    ret->pad     = dh->pad;
-    ret->version = dh->version;
-    ret->params  = dh->params;
-    ret->length  = dh->length;
-    ret->flags   = dh->flags;
-    if (dh->pub_key != NULL) {
-        __CPROVER_assume(ret->pub_key != NULL);
-        *ret->pub_key = *dh->pub_key;
-    } else {
-        ret->pub_key = NULL;
-    }
-    if (dh->priv_key != NULL) {
-        __CPROVER_assume(ret->priv_key != NULL);
-        *ret->priv_key = *dh->priv_key;
-    } else {
-        ret->priv_key = NULL;
-    }
-    if (dh->p != NULL) {
-        __CPROVER_assume(ret->p != NULL);
-        *ret->p = *dh->p;
-    } else {
-        ret->p = NULL;
-    }
-    if (dh->g != NULL) {
-        __CPROVER_assume(ret->g != NULL);
-        *ret->g = *dh->g;
-    } else {
-        ret->g = NULL;
-    }
+    refcount_init(&ret->references);
+    ret->pad          = dh->pad;
+    ret->version      = dh->version;
+    ret->params       = dh->params;
+    ret->length       = dh->length;
+    ret->flags        = dh->flags;
+    ret->dirty_cnt    = 0;
+    ret->pub_key      = BN_new();
+    ret->priv_key     = BN_new();
+    ret->p            = owner->p;
+    ret->q            = owner->q;
+    ret->g            = owner->g;
+    ret->params_owner = owner;
+    ret->params_dups  = 0;
+    refcount_acquire(&owner->references);
+    owner->params_dups += 1;
     return ret;
 }
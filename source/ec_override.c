@@ -14,24 +14,44 @@
  */
 
 #include <ec_utils.h>
+#include <failure_utils.h>
+#include <havoc_utils.h>
+#include <heap_utils.h>
 
 #include <assert.h>
 
+DEFINE_MODEL_POOL(EC_KEY, ec_key)
+
 /*
  * Description: In order to construct a builtin curve use the function EC_GROUP_new_by_curve_name and provide the nid of
  * the curve to be constructed. Return values: All EC_GROUP_new* functions return a pointer to the newly constructed
  * group, or NULL on error.
  */
-EC_GROUP *EC_GROUP_new_by_curve_name(int nid) {
+EC_GROUP *EC_GROUP_new_by_curve_name(int nid)
+    __CPROVER_requires(nid == NID_X9_62_prime256v1 || nid == NID_secp384r1)
+    __CPROVER_assigns()
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_is_fresh(__CPROVER_return_value, sizeof(EC_GROUP)) &&
+         __CPROVER_is_fresh(__CPROVER_return_value->order, sizeof(BIGNUM))))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->curve_name == nid &&
+         __CPROVER_return_value->asn1_form == POINT_CONVERSION_UNCOMPRESSED &&
+         bignum_is_valid(__CPROVER_return_value->order)))
+{
     assert(nid == NID_X9_62_prime256v1 || nid == NID_secp384r1);
 
-    EC_GROUP *group = malloc(sizeof(EC_GROUP));
+    EC_GROUP *group = model_malloc(sizeof(EC_GROUP));
 
     if (group) {
         group->curve_name = nid;
         group->asn1_form  = POINT_CONVERSION_UNCOMPRESSED;
-        group->order      = bignum_nondet_alloc();
-        __CPROVER_assume(bignum_is_valid(group->order));
+        group->order      = bignum_nondet_valid_alloc();
+        if (group->order == NULL) {
+            model_free(group);
+            return NULL;
+        }
     }
 
     return group;
@@ -41,7 +61,11 @@ EC_GROUP *EC_GROUP_new_by_curve_name(int nid) {
  * Description: The functions EC_GROUP_set_point_conversion_form and EC_GROUP_get_point_conversion_form set and get the
  * point_conversion_form for the curve respectively.
  */
-void EC_GROUP_set_point_conversion_form(EC_GROUP *group, point_conversion_form_t form) {
+void EC_GROUP_set_point_conversion_form(EC_GROUP *group, point_conversion_form_t form)
+    __CPROVER_requires(__CPROVER_rw_ok(group, sizeof(*group)))
+    __CPROVER_assigns(group->asn1_form)
+    __CPROVER_ensures(group->asn1_form == form)
+{
     assert(group);
     group->asn1_form = form;
 }
@@ -51,7 +75,11 @@ bool ec_group_is_valid(EC_GROUP *group);
 /*
  * Return values: EC_GROUP_get0_order() returns an internal pointer to the group order.
  */
-const BIGNUM *EC_GROUP_get0_order(const EC_GROUP *group) {
+const BIGNUM *EC_GROUP_get0_order(const EC_GROUP *group)
+    __CPROVER_requires(ec_group_is_valid(group))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == group->order)
+{
     assert(ec_group_is_valid(group));
     return group->order;
 }
@@ -59,10 +87,14 @@ const BIGNUM *EC_GROUP_get0_order(const EC_GROUP *group) {
 /*
  * Description: EC_GROUP_free frees the memory associated with the EC_GROUP. If group is NULL nothing is done.
  */
-void EC_GROUP_free(EC_GROUP *group) {
+void EC_GROUP_free(EC_GROUP *group)
+    __CPROVER_requires(group == NULL || __CPROVER_r_ok(group, sizeof(*group)))
+    __CPROVER_assigns()
+    __CPROVER_frees(EC_GROUP_FREES(true, group))
+{
     if (group != NULL) {
         BN_free(group->order);
-        free(group);
+        model_free(group);
     }
 }
 
@@ -71,13 +103,21 @@ void EC_GROUP_free(EC_GROUP *group) {
  * for the newly created EC_KEY is initially set to 1. Return value: EC_KEY_new(), EC_KEY_new_by_curve_name() and
  * EC_KEY_dup() return a pointer to the newly created EC_KEY object, or NULL on error.
  */
-EC_KEY *EC_KEY_new() {
-    EC_KEY *key = malloc(sizeof(EC_KEY));
+EC_KEY *EC_KEY_new()
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EC_KEY)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->references == 1 && __CPROVER_return_value->group == NULL &&
+         __CPROVER_return_value->conv_form == POINT_CONVERSION_UNCOMPRESSED &&
+         __CPROVER_return_value->priv_key == NULL && !__CPROVER_return_value->pub_key_is_set))
+{
+    EC_KEY *key = ec_key_pool_alloc();
 
     if (key) {
-        key->references = 1;
-        key->group      = NULL;  // no associated curve
-        key->conv_form  = POINT_CONVERSION_UNCOMPRESSED;
+        refcount_init(&key->references);
+        key->group     = NULL;  // no associated curve
+        key->conv_form = POINT_CONVERSION_UNCOMPRESSED;
         // Can we assume that initially the keys are not set?
         key->priv_key       = NULL;
         key->pub_key_is_set = false;
@@ -90,7 +130,11 @@ EC_KEY *EC_KEY_new() {
  * Description: The function EC_KEY_get0_group() gets the EC_GROUP object for the key.
  * Return values: EC_KEY_get0_group() returns the EC_GROUP associated with the EC_KEY.
  */
-const EC_GROUP *EC_KEY_get0_group(const EC_KEY *key) {
+const EC_GROUP *EC_KEY_get0_group(const EC_KEY *key)
+    __CPROVER_requires(ec_key_is_valid(key))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == key->group)
+{
     assert(ec_key_is_valid(key));
     return key->group;
 }
@@ -99,13 +143,28 @@ const EC_GROUP *EC_KEY_get0_group(const EC_KEY *key) {
  * Description: The function EC_KEY_set_group() sets the EC_GROUP object for the key.
  * Return values: Returns 1 on success or 0 on error.
  */
-int EC_KEY_set_group(EC_KEY *key, const EC_GROUP *group) {
+int EC_KEY_set_group(EC_KEY *key, const EC_GROUP *group)
+    __CPROVER_requires(__CPROVER_rw_ok(key, sizeof(*key)))
+    __CPROVER_requires(key->group == NULL || __CPROVER_r_ok(key->group, sizeof(*key->group)))
+    __CPROVER_requires(group == NULL || (__CPROVER_r_ok(group, sizeof(*group)) && bignum_is_valid(group->order)))
+    __CPROVER_assigns(key->group)
+    __CPROVER_frees(EC_GROUP_FREES(group != NULL, key->group))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (__CPROVER_is_fresh(key->group, sizeof(EC_GROUP)) &&
+                                        __CPROVER_is_fresh(key->group->order, sizeof(BIGNUM))))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (key->group->curve_name == group->curve_name && key->group->asn1_form == group->asn1_form &&
+         ec_group_is_valid(key->group)))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || key->group == NULL || key->group == __CPROVER_old(key->group))
+{
     assert(key);
 
-    if (!group || nondet_bool()) return 0;
+    if (!group || inject_failure(LIBCRYPTO_MODEL_EC)) return 0;
 
     EC_GROUP_free(key->group);
-    key->group = malloc(sizeof(EC_GROUP));
+    key->group = model_malloc(sizeof(EC_GROUP));
 
     if (!key->group) return 0;
 
@@ -121,7 +180,13 @@ int EC_KEY_set_group(EC_KEY *key, const EC_GROUP *group) {
  * Description: The functions EC_KEY_get_conv_form() and EC_KEY_set_conv_form() get and set the point_conversion_form
  * for the key.
  */
-void EC_KEY_set_conv_form(EC_KEY *key, point_conversion_form_t cform) {
+void EC_KEY_set_conv_form(EC_KEY *key, point_conversion_form_t cform)
+    __CPROVER_requires(__CPROVER_rw_ok(key, sizeof(*key)))
+    __CPROVER_requires(key->group == NULL || __CPROVER_rw_ok(key->group, sizeof(*key->group)))
+    __CPROVER_assigns(key->conv_form; key->group != NULL: key->group->asn1_form)
+    __CPROVER_ensures(key->conv_form == cform)
+    __CPROVER_ensures(key->group == NULL || key->group->asn1_form == cform)
+{
     assert(key);
     key->conv_form = cform;
     if (key->group != NULL) EC_GROUP_set_point_conversion_form(key->group, cform);
@@ -131,11 +196,19 @@ void EC_KEY_set_conv_form(EC_KEY *key, point_conversion_form_t cform) {
  * Description: The function EC_KEY_set_private_key() sets the private key for the key.
  * Return values: Returns 1 on success or 0 on error.
  */
-int EC_KEY_set_private_key(EC_KEY *key, const BIGNUM *prv) {
+int EC_KEY_set_private_key(EC_KEY *key, const BIGNUM *prv)
+    __CPROVER_requires(__CPROVER_rw_ok(key, sizeof(*key)))
+    __CPROVER_requires(bignum_is_valid(prv))
+    __CPROVER_assigns(key->group != NULL: key->priv_key)
+    __CPROVER_frees(BIGNUM_FREES(key->group != NULL, key->priv_key))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_is_fresh(key->priv_key, sizeof(BIGNUM)))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || bignum_is_valid(key->priv_key))
+{
     assert(key);
     assert(bignum_is_valid(prv));
 
-    if (key->group == NULL || nondet_bool()) {
+    if (key->group == NULL || inject_failure(LIBCRYPTO_MODEL_EC)) {
         return 0;
     }
 
@@ -148,7 +221,11 @@ int EC_KEY_set_private_key(EC_KEY *key, const BIGNUM *prv) {
  * Description: The function EC_KEY_get0_private_key gets the private key for the key.
  * Return values: EC_KEY_get0_private_key() returns the private key associated with the EC_KEY.
  */
-const BIGNUM *EC_KEY_get0_private_key(const EC_KEY *key) {
+const BIGNUM *EC_KEY_get0_private_key(const EC_KEY *key)
+    __CPROVER_requires(__CPROVER_r_ok(key, sizeof(*key)))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == key->priv_key)
+{
     assert(key);
     return key->priv_key;
 }
@@ -160,14 +237,19 @@ const BIGNUM *EC_KEY_get0_private_key(const EC_KEY *key) {
  * calculated by multiplying the generator for the curve by the private key. Return value: Returns 1 on success or 0 on
  * error.
  */
-int EC_KEY_generate_key(EC_KEY *key) {
+int EC_KEY_generate_key(EC_KEY *key)
+    __CPROVER_requires(__CPROVER_rw_ok(key, sizeof(*key)))
+    __CPROVER_requires(ec_group_is_valid(key->group))
+    __CPROVER_assigns(key->priv_key, key->pub_key_is_set)
+    __CPROVER_ensures(key->priv_key == NULL || __CPROVER_is_fresh(key->priv_key, sizeof(BIGNUM)))
+    __CPROVER_ensures(key->priv_key == NULL || bignum_is_valid(key->priv_key))
+    __CPROVER_ensures(__CPROVER_return_value == (key->priv_key != NULL && key->pub_key_is_set))
+{
     assert(key);
     assert(ec_group_is_valid(key->group));
 
-    key->priv_key       = bignum_nondet_alloc();
-    key->pub_key_is_set = nondet_bool();
-
-    __CPROVER_assume(!key->priv_key || bignum_is_valid(key->priv_key));
+    key->priv_key       = bignum_nondet_valid_alloc();
+    key->pub_key_is_set = !inject_failure(LIBCRYPTO_MODEL_EC);
 
     return key->priv_key && key->pub_key_is_set;
 }
@@ -176,10 +258,16 @@ int EC_KEY_generate_key(EC_KEY *key) {
  * Description: EC_KEY_up_ref() increments the reference count associated with the EC_KEY object.
  * Return values: EC_KEY_up_ref() returns 1 on success or 0 on error.
  */
-int EC_KEY_up_ref(EC_KEY *key) {
+int EC_KEY_up_ref(EC_KEY *key)
+    __CPROVER_requires(ec_key_is_valid(key))
+    __CPROVER_requires(key->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_assigns(key->references)
+    __CPROVER_ensures(key->references == __CPROVER_old(key->references) + 1)
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+{
     assert(ec_key_is_valid(key));
 
-    key->references += 1;
+    refcount_acquire(&key->references);
     return 1;  // Can we assume that this never fails?
 }
 
@@ -187,16 +275,15 @@ int EC_KEY_up_ref(EC_KEY *key) {
  * Description: Calling EC_KEY_free() decrements the reference count for the EC_KEY object, and if it has dropped to
  * zero then frees the memory associated with it. If key is NULL nothing is done.
  */
-void EC_KEY_free(EC_KEY *key) {
-    if (key != NULL &&
-        /* We must include this extra guard to avoid spurious arithmetic underflows. */
-        key->references > 0) {
-        key->references -= 1;
-        if (key->references == 0) {
-            EC_GROUP_free(key->group);
-            BN_clear_free(key->priv_key);
-            free(key);
-        }
+void EC_KEY_free(EC_KEY *key)
+    __CPROVER_requires(key == NULL || __CPROVER_rw_ok(key, sizeof(*key)))
+    __CPROVER_assigns(EC_KEY_RELEASE_ASSIGNS(true, key))
+    __CPROVER_frees(EC_KEY_FREES(true, key))
+{
+    if (key != NULL && refcount_release(&key->references)) {
+        EC_GROUP_free(key->group);
+        BN_clear_free(key->priv_key);
+        ec_key_pool_free(key);
     }
 }
 
@@ -208,24 +295,46 @@ void EC_KEY_free(EC_KEY *key) {
  *  \return EC_KEY object with decoded public key or NULL if an error
  *          occurred.
  */
-EC_KEY *o2i_ECPublicKey(EC_KEY **key, const unsigned char **in, long len) {
+EC_KEY *o2i_ECPublicKey(EC_KEY **key, const unsigned char **in, long len)
+    __CPROVER_requires(__CPROVER_rw_ok(in, sizeof(*in)) && *in != NULL && __CPROVER_r_ok(*in, len))
+    __CPROVER_requires(key == NULL || __CPROVER_r_ok(key, sizeof(*key)))
+    __CPROVER_requires(key == NULL || *key == NULL || __CPROVER_rw_ok(*key, sizeof(**key)))
+    __CPROVER_assigns(
+        *in; key != NULL && *key != NULL: (*key)->pub_key_is_set, (*key)->conv_form;
+        key != NULL && *key != NULL && (*key)->group != NULL: (*key)->group->asn1_form)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || (__CPROVER_return_value == *key && (*key)->pub_key_is_set))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (((*key)->conv_form == POINT_CONVERSION_COMPRESSED || (*key)->conv_form == POINT_CONVERSION_UNCOMPRESSED) &&
+         (*key)->group->asn1_form == (*key)->conv_form))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (len == EC_PUBLIC_KEY_ENCODING_SIZE(*key) && *in == __CPROVER_old(*in) + len))
+    __CPROVER_ensures(__CPROVER_return_value != NULL || *in == __CPROVER_old(*in))
+{
     assert(in);
     assert(*in);
     assert(__CPROVER_r_ok(*in, len));
 
-    if (!key || !(*key) || !(*key)->group || nondet_bool()) {
+    if (!key || !(*key) || !ec_group_is_valid((*key)->group) || inject_failure(LIBCRYPTO_MODEL_EC)) {
         return NULL;
     }
 
-    (*key)->pub_key_is_set = true;
-
-    // o2i_ECPublicKey calls EC_KEY_oct2key, which in some cases sets the conversion form.
-    // Can we guarantee that this never happens in our use cases?
-    // Any other possible changes to the EC_KEY?
+    // o2i_ECPublicKey calls EC_KEY_oct2key, which sets the conversion form of the key from the encoding.
+    // As in EC_POINT_oct2point, anything but the exact size of a compressed or uncompressed point of the curve is
+    // rejected, and the conversion form is the one whose size matched. As EC_KEY_set_conv_form does, the form of the
+    // group follows, so that the key stays consistent with it.
+    int field_size = EC_CURVE_FIELD_SIZE((*key)->group->curve_name);
+    if (len == 1 + field_size) {
+        EC_KEY_set_conv_form(*key, POINT_CONVERSION_COMPRESSED);
+    } else if (len == 1 + 2 * field_size) {
+        EC_KEY_set_conv_form(*key, POINT_CONVERSION_UNCOMPRESSED);
+    } else {
+        return NULL;
+    }
 
-    long offset;
-    __CPROVER_assume(0 <= offset && offset <= len);  // public key can be shorter than length
-    *in += offset;
+    (*key)->pub_key_is_set = true;
+    *in += len;
 
     return *key;
 }
@@ -236,26 +345,50 @@ EC_KEY *o2i_ECPublicKey(EC_KEY **key, const unsigned char **in, long len) {
  *  \param  out  the buffer for the result (if NULL the function returns number
  *               of bytes needed).
  *  \return 1 on success and 0 if an error occurred
+ *
+ *  As in OpenSSL, the length of the encoding is actually returned on success, which follows from the curve and the
+ *  conversion form of key. If *out is NULL a buffer is allocated for the encoding, otherwise the encoding is written
+ *  to *out, which is then advanced past it, so that several fields can be encoded back to back into one buffer.
  */
-int i2o_ECPublicKey(const EC_KEY *key, unsigned char **out) {
+int i2o_ECPublicKey(const EC_KEY *key, unsigned char **out)
+    __CPROVER_requires(ec_key_is_valid(key))
+    __CPROVER_requires(__CPROVER_rw_ok(out, sizeof(*out)))
+    __CPROVER_requires(*out == NULL || __CPROVER_w_ok(*out, EC_PUBLIC_KEY_ENCODING_SIZE(key)))
+    __CPROVER_assigns(*out; *out != NULL: UNCONSTRAINED_DATA(*out, EC_PUBLIC_KEY_ENCODING_SIZE(key)))
+    __CPROVER_ensures(__CPROVER_return_value <= 0 || __CPROVER_return_value == EC_PUBLIC_KEY_ENCODING_SIZE(key))
+    __CPROVER_ensures(
+        __CPROVER_old(*out) != NULL ||
+        (__CPROVER_return_value <= 0 ? *out == NULL : __CPROVER_is_fresh(*out, __CPROVER_return_value)))
+    __CPROVER_ensures(
+        __CPROVER_old(*out) == NULL ||
+        *out == __CPROVER_old(*out) + (__CPROVER_return_value > 0 ? __CPROVER_return_value : 0))
+{
     assert(ec_key_is_valid(key));
-    assert(out);           // Assuming that it's always called in ESDK with non-NULL out
-    assert(*out == NULL);  // Assuming that it's always called with NULL *out, so buffer needs to be allocated
 
-    if (!key) return 0;
+    int buf_len = EC_PUBLIC_KEY_ENCODING_SIZE(key);
+    if (out == NULL) return buf_len;  // Only the length is requested
 
-    int buf_len;
-    __CPROVER_assume(0 < buf_len);
-    *out = malloc(buf_len);
+    if (*out != NULL) {
+        if (inject_failure(LIBCRYPTO_MODEL_EC)) {
+            int error_code = nondet_int();
+            __CPROVER_assume(error_code <= 0);
+            return error_code;  // Retuns 0 or negative value on error
+        }
+        assert(__CPROVER_w_ok(*out, buf_len));
+        write_unconstrained_data(*out, buf_len);
+        *out += buf_len;
+        return buf_len;
+    }
+
+    *out = model_malloc(buf_len);
 
     if (*out == NULL) {
-        int error_code;
+        int error_code = nondet_int();
         __CPROVER_assume(error_code <= 0);
         return error_code;  // Retuns 0 or negative value on error
     }
 
-    // Should *out be incremented?
-
+    // A freshly allocated buffer is returned as is, not advanced
     return buf_len;
 }
 
@@ -271,7 +404,12 @@ bool ecdsa_sig_is_valid(ECDSA_SIG *sig);
  * Description: ECDSA_SIG_get0() returns internal pointers the r and s values contained in sig and stores them in *pr
  * and *ps, respectively. The pointer pr or ps can be NULL, in which case the corresponding value is not returned.
  */
-void ECDSA_SIG_get0(const ECDSA_SIG *sig, const BIGNUM **pr, const BIGNUM **ps) {
+void ECDSA_SIG_get0(const ECDSA_SIG *sig, const BIGNUM **pr, const BIGNUM **ps)
+    __CPROVER_requires(ecdsa_sig_is_valid(sig))
+    __CPROVER_requires(__CPROVER_w_ok(pr, sizeof(*pr)) && __CPROVER_w_ok(ps, sizeof(*ps)))
+    __CPROVER_assigns(*pr, *ps)
+    __CPROVER_ensures(*pr == sig->r && *ps == sig->s)
+{
     assert(ecdsa_sig_is_valid(sig));
     assert(pr);
     assert(ps);
@@ -286,7 +424,14 @@ void ECDSA_SIG_get0(const ECDSA_SIG *sig, const BIGNUM **pr, const BIGNUM **ps)
  * object, and therefore the values that have been passed in should not be freed directly after this function has been
  * called. Return values: ECDSA_SIG_set0() returns 1 on success or 0 on failure.
  */
-int ECDSA_SIG_set0(ECDSA_SIG *sig, BIGNUM *r, BIGNUM *s) {
+int ECDSA_SIG_set0(ECDSA_SIG *sig, BIGNUM *r, BIGNUM *s)
+    __CPROVER_requires(__CPROVER_rw_ok(sig, sizeof(*sig)))
+    __CPROVER_requires(bignum_is_valid(r) && bignum_is_valid(s))
+    __CPROVER_assigns(sig->r, sig->s)
+    __CPROVER_frees(BIGNUM_FREES(true, sig->r); BIGNUM_FREES(true, sig->s))
+    __CPROVER_ensures(sig->r == r && sig->s == s)
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+{
     assert(sig);
     assert(bignum_is_valid(r));
     assert(bignum_is_valid(s));
@@ -301,11 +446,15 @@ int ECDSA_SIG_set0(ECDSA_SIG *sig, BIGNUM *r, BIGNUM *s) {
 /*
  * Description: ECDSA_SIG_free() frees the ECDSA_SIG structure sig.
  */
-void ECDSA_SIG_free(ECDSA_SIG *sig) {
+void ECDSA_SIG_free(ECDSA_SIG *sig)
+    __CPROVER_requires(sig == NULL || __CPROVER_r_ok(sig, sizeof(*sig)))
+    __CPROVER_assigns()
+    __CPROVER_frees(sig != NULL: sig; BIGNUM_FREES(sig != NULL, sig->r); BIGNUM_FREES(sig != NULL, sig->s))
+{
     if (sig) {
         BN_clear_free(sig->r);
         BN_clear_free(sig->s);
-        free(sig);
+        model_free(sig);
     }
 }
 
@@ -313,7 +462,18 @@ void ECDSA_SIG_free(ECDSA_SIG *sig) {
  * Description: d2i_ECDSA_SIG() decodes a DER encoded ECDSA signature and returns the decoded signature in a newly
  * allocated ECDSA_SIG structure. *sig points to the buffer containing the DER encoded signature of size len.
  */
-ECDSA_SIG *d2i_ECDSA_SIG(ECDSA_SIG **sig, const unsigned char **pp, long len) {
+ECDSA_SIG *d2i_ECDSA_SIG(ECDSA_SIG **sig, const unsigned char **pp, long len)
+    __CPROVER_requires(__CPROVER_rw_ok(sig, sizeof(*sig)) && *sig == NULL)
+    __CPROVER_requires(__CPROVER_r_ok(pp, sizeof(*pp)) && *pp != NULL && 0 <= len && __CPROVER_r_ok(*pp, len))
+    __CPROVER_assigns(*sig)
+    __CPROVER_ensures(__CPROVER_return_value == *sig)
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_is_fresh(__CPROVER_return_value, sizeof(ECDSA_SIG)) &&
+         __CPROVER_is_fresh(__CPROVER_return_value->r, sizeof(BIGNUM)) &&
+         __CPROVER_is_fresh(__CPROVER_return_value->s, sizeof(BIGNUM))))
+    __CPROVER_ensures(__CPROVER_return_value == NULL || ecdsa_sig_is_valid(__CPROVER_return_value))
+{
     assert(sig);
     assert(!*sig);
     assert(pp);
@@ -321,12 +481,15 @@ ECDSA_SIG *d2i_ECDSA_SIG(ECDSA_SIG **sig, const unsigned char **pp, long len) {
     assert(0 <= len);
     assert(__CPROVER_r_ok(*pp, len));
 
-    *sig = malloc(sizeof(ECDSA_SIG));
+    *sig = model_malloc(sizeof(ECDSA_SIG));
 
     if (*sig) {
-        (*sig)->r = bignum_nondet_alloc();
-        (*sig)->s = bignum_nondet_alloc();
-        __CPROVER_assume(ecdsa_sig_is_valid(*sig));  // Assuming that on a success both r and s are initialized
+        (*sig)->r = bignum_nondet_valid_alloc();
+        (*sig)->s = bignum_nondet_valid_alloc();
+        if ((*sig)->r == NULL || (*sig)->s == NULL) {
+            ECDSA_SIG_free(*sig);
+            *sig = NULL;
+        }
     }
 
     return *sig;
@@ -337,7 +500,20 @@ ECDSA_SIG *d2i_ECDSA_SIG(ECDSA_SIG **sig, const unsigned char **pp, long len) {
  * *pp (note: if pp is NULL i2d_ECDSA_SIG() returns the expected length in bytes of the DER encoded signature).
  * i2d_ECDSA_SIG() returns the length of the DER encoded signature (or 0 on error).
  */
-int i2d_ECDSA_SIG(const ECDSA_SIG *sig, unsigned char **pp) {
+int i2d_ECDSA_SIG(const ECDSA_SIG *sig, unsigned char **pp)
+    __CPROVER_requires(ecdsa_sig_is_valid(sig))
+    __CPROVER_requires(__CPROVER_rw_ok(pp, sizeof(*pp)) && *pp != NULL)
+    __CPROVER_requires(__CPROVER_w_ok(*pp, SIZE_BOUND_UPPER(SIGNATURE_SIZE_BOUND)))
+    __CPROVER_assigns(
+        *pp, UNCONSTRAINED_DATA(*pp, SIZE_BOUND_UPPER(SIGNATURE_SIZE_BOUND)), SIZE_BOUND_ASSIGNS(SIGNATURE_SIZE_BOUND))
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(SIGNATURE_SIZE_BOUND))
+    __CPROVER_ensures(output_size_bound_is_initialized[SIGNATURE_SIZE_BOUND])
+    __CPROVER_ensures(
+        __CPROVER_return_value <= 0 ||
+        (__CPROVER_return_value <= output_size_bounds[SIGNATURE_SIZE_BOUND] &&
+         __CPROVER_return_value <= ECDSA_SIG_MAX_DER_SIZE && *pp == __CPROVER_old(*pp) + __CPROVER_return_value))
+    __CPROVER_ensures(__CPROVER_return_value > 0 || *pp == __CPROVER_old(*pp))
+{
     assert(ecdsa_sig_is_valid(sig));
     assert(pp != NULL);
     assert(*pp != NULL);                                // Assuming is never called with *pp == NULL
@@ -345,14 +521,15 @@ int i2d_ECDSA_SIG(const ECDSA_SIG *sig, unsigned char **pp) {
 
     // Documentation says 0 is returned on error, but OpenSSL implementation returns -1
     // To be safe, we return a number <= 0
-    if (nondet_bool()) {
-        int error_code;
+    if (inject_failure(LIBCRYPTO_MODEL_EC)) {
+        int error_code = nondet_int();
         __CPROVER_assume(error_code <= 0);
         return error_code;
     }
 
-    int sig_len;
-    __CPROVER_assume(0 < sig_len && sig_len <= max_signature_size());
+    // The curve of sig is unknown, but no ECDSA signature of the model is longer than ECDSA_SIG_MAX_DER_SIZE
+    int sig_len = nondet_int();
+    __CPROVER_assume(0 < sig_len && sig_len <= max_signature_size() && sig_len <= ECDSA_SIG_MAX_DER_SIZE);
     write_unconstrained_data(*pp, sig_len);
     *pp += sig_len;  // Unclear from the documentation if *pp should really be incremented
 
@@ -363,13 +540,14 @@ int i2d_ECDSA_SIG(const ECDSA_SIG *sig, unsigned char **pp) {
 
 /* Helper function for CBMC proofs: check validity of an EC_GROUP. */
 bool ec_group_is_valid(EC_GROUP *group) {
-    return group && (group->curve_name != NID_undef) && (group->asn1_form == POINT_CONVERSION_COMPRESSED) &&
+    return group && (group->curve_name == NID_X9_62_prime256v1 || group->curve_name == NID_secp384r1) &&
+           (group->asn1_form == POINT_CONVERSION_COMPRESSED || group->asn1_form == POINT_CONVERSION_UNCOMPRESSED) &&
            bignum_is_valid(group->order);
 }
 
 /* Helper function for CBMC proofs: allocates an EC_GROUP nondeterministically. */
 EC_GROUP *ec_group_nondet_alloc() {
-    EC_GROUP *group = malloc(sizeof(EC_GROUP));
+    EC_GROUP *group = model_malloc(sizeof(EC_GROUP));
 
     if (group) group->order = bignum_nondet_alloc();
 
@@ -378,13 +556,14 @@ EC_GROUP *ec_group_nondet_alloc() {
 
 /* Helper function for CBMC proofs: check validity of an EC_KEY. */
 bool ec_key_is_valid(EC_KEY *key) {
-    return key && (0 < key->references) && ec_group_is_valid(key->group) && (key->group->asn1_form == key->conv_form) &&
-           key->pub_key_is_set && (!key->priv_key || bignum_is_valid(key->priv_key));
+    return key && refcount_is_live(key->references) && ec_group_is_valid(key->group) &&
+           (key->group->asn1_form == key->conv_form) && key->pub_key_is_set &&
+           (!key->priv_key || bignum_is_valid(key->priv_key));
 }
 
 /* Helper function for CBMC proofs: allocates an EC_KEY nondeterministically. */
 EC_KEY *ec_key_nondet_alloc() {
-    EC_KEY *key = malloc(sizeof(EC_KEY));
+    EC_KEY *key = ec_key_pool_alloc();
 
     if (key) {
         key->group    = ec_group_nondet_alloc();
@@ -394,6 +573,46 @@ EC_KEY *ec_key_nondet_alloc() {
     return key;
 }
 
+/*
+ * Helper function for CBMC proofs: allocates an EC_GROUP that satisfies ec_group_is_valid() by construction, on either
+ * curve of the model, or returns NULL when an allocation fails.
+ */
+EC_GROUP *ec_group_nondet_valid_alloc() {
+    EC_GROUP *group = model_malloc(sizeof(EC_GROUP));
+    if (group == NULL) return NULL;
+
+    group->curve_name = nondet_bool() ? NID_X9_62_prime256v1 : NID_secp384r1;
+    group->asn1_form  = nondet_bool() ? POINT_CONVERSION_COMPRESSED : POINT_CONVERSION_UNCOMPRESSED;
+    group->order      = bignum_nondet_valid_alloc();
+    if (group->order == NULL) {
+        model_free(group);
+        return NULL;
+    }
+    return group;
+}
+
+/*
+ * Helper function for CBMC proofs: allocates an EC_KEY that satisfies ec_key_is_valid() by construction, with a fresh
+ * group and any live reference count, or returns NULL when an allocation fails. depth bounds the optional objects
+ * below the key: with depth > 0 the key may also have a private key.
+ */
+EC_KEY *ec_key_nondet_valid_alloc(int depth) {
+    EC_KEY *key = ec_key_pool_alloc();
+    if (key == NULL) return NULL;
+
+    key->group = ec_group_nondet_valid_alloc();
+    if (key->group == NULL) {
+        ec_key_pool_free(key);
+        return NULL;
+    }
+    key->references = nondet_int();
+    __CPROVER_assume(refcount_is_live(key->references));
+    key->conv_form      = key->group->asn1_form;
+    key->pub_key_is_set = true;
+    key->priv_key       = (depth > 0 && nondet_bool()) ? bignum_nondet_valid_alloc() : NULL;
+    return key;
+}
+
 /* Helper function for CBMC proofs: returns the reference count. */
 int ec_key_get_reference_count(EC_KEY *key) {
     return key ? key->references : 0;
@@ -403,7 +622,7 @@ int ec_key_get_reference_count(EC_KEY *key) {
 void ec_key_unconditional_free(EC_KEY *key) {
     EC_GROUP_free(key->group);
     BN_clear_free(key->priv_key);
-    free(key);
+    ec_key_pool_free(key);
 }
 
 /* Helper function for CBMC proofs: check validity of an ECDSA_SIG. */
@@ -411,66 +630,65 @@ bool ecdsa_sig_is_valid(ECDSA_SIG *sig) {
     return sig && bignum_is_valid(sig->r) && bignum_is_valid(sig->s);
 }
 
-static size_t signature_size;
+#if LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE > INT_MAX
+#    error "LIBCRYPTO_MODEL_MAX_OUTPUT_SIZE must fit in an int"
+#endif
 
-void initialize_max_signature_size() {
-    size_t size;
+size_t output_size_bounds[NUM_SIZE_BOUNDS];
+bool output_size_bound_is_initialized[NUM_SIZE_BOUNDS];
+
+void initialize_size_bound(enum output_size_bound which) {
+    assert(0 <= which && which < NUM_SIZE_BOUNDS);
+    size_t size = nondet_size_t();
     // At different times, this value is stored in a size_t, a long and an int
-    __CPROVER_assume(0 < size && size <= INT_MAX);
-    signature_size = size;
+    __CPROVER_assume(0 < size && size <= SIZE_BOUND_CAP(which));
+    output_size_bounds[which]               = size;
+    output_size_bound_is_initialized[which] = true;
+}
+
+size_t size_bound(enum output_size_bound which)
+    __CPROVER_requires(0 <= which && which < NUM_SIZE_BOUNDS)
+    __CPROVER_assigns(SIZE_BOUND_ASSIGNS(which))
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(which))
+    __CPROVER_ensures(output_size_bound_is_initialized[which])
+    __CPROVER_ensures(__CPROVER_return_value == output_size_bounds[which])
+{
+    assert(0 <= which && which < NUM_SIZE_BOUNDS);
+    if (!output_size_bound_is_initialized[which]) initialize_size_bound(which);
+    return output_size_bounds[which];
+}
+
+void initialize_max_signature_size() {
+    initialize_size_bound(SIGNATURE_SIZE_BOUND);
 }
 
 /* This function returns a fixed nondeterministic value meant to represent the maximum possible size of the DER encoding
  * of a signature. This value is obtained from EVP_PKEY_sign and restricts the size of the buffers in d2i_ECDSA_SIG and
  * i2d_ECDSA_SIG. */
 size_t max_signature_size() {
-    return signature_size;
+    return size_bound(SIGNATURE_SIZE_BOUND);
 }
 
-static size_t derivation_size;
-
 void initialize_max_derivation_size() {
-    size_t size;
-    // At different times, this value is stored in a size_t, a long and an int
-    __CPROVER_assume(0 < size && size <= INT_MAX);
-    derivation_size = size;
+    initialize_size_bound(DERIVATION_SIZE_BOUND);
 }
 
 size_t max_derivation_size() {
-    return derivation_size;
+    return size_bound(DERIVATION_SIZE_BOUND);
 }
 
-static size_t encryption_size;
-
 void initialize_max_encryption_size() {
-    size_t size;
-    // At different times, this value is stored in a size_t, a long and an int
-    __CPROVER_assume(0 < size && size <= INT_MAX);
-    encryption_size = size;
+    initialize_size_bound(ENCRYPTION_SIZE_BOUND);
 }
 
 size_t max_encryption_size() {
-    return encryption_size;
+    return size_bound(ENCRYPTION_SIZE_BOUND);
 }
 
-static size_t decryption_size;
-
 void initialize_max_decryption_size() {
-    size_t size;
-    // At different times, this value is stored in a size_t, a long and an int
-    __CPROVER_assume(0 < size && size <= INT_MAX);
-    encryption_size = size;
+    initialize_size_bound(DECRYPTION_SIZE_BOUND);
 }
 
 size_t max_decryption_size() {
-    return encryption_size;
-}
-
-/* Writes arbitrary data into the buffer out. */
-void write_unconstrained_data(unsigned char *out, size_t len) {
-    assert(__CPROVER_w_ok(out, len));
-
-    // Currently we ignore the len parameter and just fill the entire buffer with unconstrained data.
-    // This is fine because it is strictly more general behavior than writing only len bytes.
-    __CPROVER_havoc_object(out);
+    return size_bound(DECRYPTION_SIZE_BOUND);
 }
@@ -14,17 +14,111 @@
  */
 
 #include <assert.h>
+#include <failure_utils.h>
 #include <openssl/err.h>
 
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+/*
+ * Error queue of the model: a ring buffer holding err_queue_count error codes, the oldest of which is at
+ * err_queue_head. See LIBCRYPTO_MODEL_ERR_QUEUE_SIZE in model_config.h.
+ */
+static unsigned long err_queue[LIBCRYPTO_MODEL_ERR_QUEUE_SIZE];
+static size_t err_queue_head  = 0;
+static size_t err_queue_count = 0;
+
+/* OpenSSL library code of the errors raised by the given subsystem of failure_utils.h. */
+static int err_lib_of_subsystem(unsigned int subsystem) {
+    switch (subsystem) {
+        case LIBCRYPTO_MODEL_ASN1: return ERR_LIB_ASN1;
+        case LIBCRYPTO_MODEL_BIO: return ERR_LIB_BIO;
+        case LIBCRYPTO_MODEL_BN: return ERR_LIB_BN;
+        case LIBCRYPTO_MODEL_DH: return ERR_LIB_DH;
+        case LIBCRYPTO_MODEL_EC: return ERR_LIB_EC;
+        case LIBCRYPTO_MODEL_RAND: return ERR_LIB_RAND;
+        case LIBCRYPTO_MODEL_ALLOC: return ERR_LIB_CRYPTO;
+        default: return ERR_LIB_EVP;  // EVP, HMAC and the low-level digests all report through EVP.
+    }
+}
+
+bool err_queue_push_failure(unsigned int subsystem) {
+    // The reason is unconstrained, but never 0 so that the error code is a valid one for ERR_GET_REASON() users.
+    int reason = nondet_int();
+    __CPROVER_assume(0 < reason && reason <= 0xFFF);
+    unsigned long error = ERR_PACK(err_lib_of_subsystem(subsystem), 0, reason);
+
+    if (err_queue_count == LIBCRYPTO_MODEL_ERR_QUEUE_SIZE) {
+        // Like OpenSSL, drop the oldest error when the queue is full.
+        err_queue[err_queue_head] = error;
+        err_queue_head            = (err_queue_head + 1) % LIBCRYPTO_MODEL_ERR_QUEUE_SIZE;
+    } else {
+        err_queue[(err_queue_head + err_queue_count) % LIBCRYPTO_MODEL_ERR_QUEUE_SIZE] = error;
+        err_queue_count += 1;
+    }
+    return true;
+}
+
+size_t err_queue_length(void) {
+    return err_queue_count;
+}
+#endif
+
+/*
+ * Description: ERR_print_errors_fp() prints the error strings for all errors that OpenSSL has recorded to fp, thus
+ * emptying the error queue.
+ */
 void ERR_print_errors_fp(FILE *fp) {
     assert(fp == stderr);
+    ERR_clear_error();
 }
 
-signed int ERR_get_error() {
+/*
+ * Description: ERR_get_error() returns the earliest error code from the thread's error queue and removes the entry.
+ * Return values: The error code, or 0 if there is no error in the queue.
+ */
+unsigned long ERR_get_error(void) {
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+    if (err_queue_count == 0) return 0;
+
+    unsigned long error = err_queue[err_queue_head];
+    err_queue_head      = (err_queue_head + 1) % LIBCRYPTO_MODEL_ERR_QUEUE_SIZE;
+    err_queue_count -= 1;
+    return error;
+#else
     return 0;
+#endif
 }
 
-unsigned long ERR_peek_last_error() {
-    unsigned long err;
-    return err;
+/*
+ * Description: ERR_peek_error() returns the earliest error code from the thread's error queue without modifying it.
+ * Return values: The error code, or 0 if there is no error in the queue.
+ */
+unsigned long ERR_peek_error(void) {
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+    return err_queue_count == 0 ? 0 : err_queue[err_queue_head];
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Description: ERR_peek_last_error() returns the latest error code from the thread's error queue without modifying it.
+ * Return values: The error code, or 0 if there is no error in the queue.
+ */
+unsigned long ERR_peek_last_error(void) {
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+    if (err_queue_count == 0) return 0;
+    return err_queue[(err_queue_head + err_queue_count - 1) % LIBCRYPTO_MODEL_ERR_QUEUE_SIZE];
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Description: ERR_clear_error() empties the current thread's error queue.
+ */
+void ERR_clear_error(void) {
+#ifdef LIBCRYPTO_MODEL_ERR_QUEUE_SIZE
+    err_queue_head  = 0;
+    err_queue_count = 0;
+#endif
 }
@@ -0,0 +1,879 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <call_count_utils.h>
+#include <evp_utils.h>
+#include <failure_utils.h>
+#include <openssl/evp.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+
+#define DEFAULT_IV_LEN 12  // For GCM AES and OCB AES the default is 12 (i.e. 96 bits).
+#define AES_BLOCK_SIZE 16
+#define DEFAULT_KEY_LEN 32
+
+DEFINE_MODEL_POOL(EVP_CIPHER_CTX, evp_cipher_ctx)
+
+/*
+ * Description: AES for 128, 192 and 256 bit keys in Galois Counter Mode (GCM). These ciphers require additional control
+ * operations to function correctly, see the "AEAD Interface" in EVP_EncryptInit(3) section for details. Return values:
+ * These functions return an EVP_CIPHER structure that contains the implementation of the symmetric cipher.
+ */
+const EVP_CIPHER *EVP_aes_128_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_cipher_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_128_GCM)
+{
+    static const EVP_CIPHER cipher = { EVP_AES_128_GCM, 1 };
+    return &cipher;
+}
+const EVP_CIPHER *EVP_aes_192_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_cipher_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_192_GCM)
+{
+    static const EVP_CIPHER cipher = { EVP_AES_192_GCM, 1 };
+    return &cipher;
+}
+const EVP_CIPHER *EVP_aes_256_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_cipher_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_256_GCM)
+{
+    static const EVP_CIPHER cipher = { EVP_AES_256_GCM, 1 };
+    return &cipher;
+}
+const EVP_CIPHER *EVP_aes_128_ecb(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_cipher_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_128_ECB)
+{
+    static const EVP_CIPHER cipher = { EVP_AES_128_ECB, AES_BLOCK_SIZE };
+    return &cipher;
+}
+
+/* Starts a new cipher operation on ctx: nothing is buffered and no AAD or data has been processed yet. */
+static void evp_cipher_ctx_start_operation(EVP_CIPHER_CTX *ctx) {
+    ctx->data_remaining = 0;
+    ctx->data_processed = false;
+    ctx->phase          = EVP_CIPHER_PHASE_AAD;
+    ctx->aad_len        = 0;
+    ctx->data_len       = 0;
+}
+
+/* Puts ctx in the state of a freshly created context: no cipher, default parameters and no operation in progress. */
+static void evp_cipher_ctx_set_defaults(EVP_CIPHER_CTX *ctx) {
+    ctx->iv_len  = DEFAULT_IV_LEN;
+    ctx->iv_set  = false;
+    ctx->key_len = DEFAULT_KEY_LEN;
+    ctx->padding = true;
+    ctx->cipher  = NULL;
+    evp_cipher_ctx_start_operation(ctx);
+}
+
+/* Whether ctx is in the state set by evp_cipher_ctx_set_defaults(), for function contracts. */
+#define EVP_CIPHER_CTX_HAS_DEFAULTS(ctx)                                                                         \
+    ((ctx)->iv_len == DEFAULT_IV_LEN && !(ctx)->iv_set && (ctx)->key_len == DEFAULT_KEY_LEN && (ctx)->padding && \
+     EVP_CIPHER_CTX_OPERATION_IS_FRESH(ctx) && (ctx)->cipher == NULL)
+
+/*
+ * EVP_CIPHER_CTX_reset() clears all information from a cipher context and frees up any allocated memory associated
+ * with it, except the ctx itself. This function should be called anytime ctx is reused by another
+ * EVP_CipherInit() / EVP_CipherUpdate() / EVP_CipherFinal() series of calls. The model puts ctx back in the state of
+ * EVP_CIPHER_CTX_new() without allocating, so that a context can be reused after EVP_EncryptFinal_ex() or
+ * EVP_DecryptFinal_ex(). Return values: Always returns 1.
+ */
+int EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX *ctx)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(
+        ctx->iv_len, ctx->iv_set, ctx->key_len, ctx->padding, ctx->cipher, EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx))
+    __CPROVER_ensures(EVP_CIPHER_CTX_HAS_DEFAULTS(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    evp_cipher_ctx_set_defaults(ctx);
+    return 1;
+}
+
+/*
+ * From MAN pages: EVP_CIPHER_CTX_init() initializes cipher context ctx. In OpenSSL 1.1 it is EVP_CIPHER_CTX_reset(),
+ * which the model also uses to initialize a context that was not created by EVP_CIPHER_CTX_new().
+ */
+void EVP_CIPHER_CTX_init(EVP_CIPHER_CTX *ctx)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(
+        ctx->iv_len, ctx->iv_set, ctx->key_len, ctx->padding, ctx->cipher, EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx))
+    __CPROVER_ensures(EVP_CIPHER_CTX_HAS_DEFAULTS(ctx))
+{
+    EVP_CIPHER_CTX_reset(ctx);
+}
+
+/*
+ * EVP_CIPHER_CTX_new() creates a cipher context.
+ */
+EVP_CIPHER_CTX *EVP_CIPHER_CTX_new()
+    __CPROVER_assigns()
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_CIPHER_CTX)))
+    __CPROVER_ensures(__CPROVER_return_value == NULL || EVP_CIPHER_CTX_HAS_DEFAULTS(__CPROVER_return_value))
+{
+    EVP_CIPHER_CTX *cipher_ctx = evp_cipher_ctx_pool_alloc();
+    if (cipher_ctx) evp_cipher_ctx_set_defaults(cipher_ctx);
+    return cipher_ctx;
+}
+
+/*
+ * EVP_CipherInit_ex(), EVP_CipherUpdate() and EVP_CipherFinal_ex() are functions that can be used for
+ * decryption or encryption. The operation performed depends on the value of the enc parameter.
+ * It should be set to 1 for encryption, 0 for decryption and -1 to leave the value unchanged (the actual value of 'enc'
+ * being supplied in a previous call). Return 1 for success and 0 for failure.
+ */
+int EVP_CipherInit_ex(
+    EVP_CIPHER_CTX *ctx,
+    const EVP_CIPHER *cipher,
+    ENGINE *impl,
+    const unsigned char *key,
+    const unsigned char *iv,
+    int enc)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(enc == 0 || enc == 1 || enc == -1)
+    __CPROVER_requires(cipher == NULL || evp_cipher_is_valid((EVP_CIPHER *)cipher))
+    __CPROVER_assigns(ctx->encrypt, ctx->cipher, ctx->iv_set, EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx))
+    __CPROVER_ensures(ctx->encrypt == (enc == -1 ? __CPROVER_old(ctx->encrypt) : enc))
+    __CPROVER_ensures(ctx->cipher == (cipher == NULL ? __CPROVER_old(ctx->cipher) : cipher))
+    __CPROVER_ensures(ctx->iv_set == (iv != NULL || __CPROVER_old(ctx->iv_set)))
+    __CPROVER_ensures(EVP_CIPHER_CTX_OPERATION_IS_FRESH(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    assert(enc == 0 || enc == 1 || enc == -1);
+    if (enc != -1) {
+        ctx->encrypt = enc;
+    }
+    if (cipher) {
+        ctx->cipher = cipher;
+    }
+    if (iv) {
+        ctx->iv_set = true;
+    }
+    /* Like OpenSSL, every call (e.g. setting a new IV) discards buffered data and starts over. */
+    evp_cipher_ctx_start_operation(ctx);
+    int rv = inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER) ? 0 : 1;
+    return rv;
+}
+
+/*
+ * EVP_CIPHER_CTX_ctrl() allows various cipher specific parameters to be determined and set.
+ */
+int EVP_CIPHER_CTX_ctrl(EVP_CIPHER_CTX *ctx, int type, int arg, void *ptr)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(
+        IMPLIES(type == EVP_CTRL_GCM_SET_IVLEN || type == EVP_CTRL_AEAD_SET_IVLEN, !ctx->iv_set && arg > 0))
+    __CPROVER_requires(
+        IMPLIES(type == EVP_CTRL_GCM_GET_TAG, ctx->encrypt == 1 && ctx->data_processed && __CPROVER_w_ok(ptr, arg)))
+    __CPROVER_requires(IMPLIES(type == EVP_CTRL_GCM_SET_TAG, ctx->encrypt == 0 && __CPROVER_w_ok(ptr, arg)))
+    __CPROVER_assigns(type == EVP_CTRL_GCM_SET_IVLEN || type == EVP_CTRL_AEAD_SET_IVLEN: ctx->iv_len)
+    __CPROVER_ensures(IMPLIES(type == EVP_CTRL_GCM_SET_IVLEN || type == EVP_CTRL_AEAD_SET_IVLEN, ctx->iv_len == arg))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    if (type == EVP_CTRL_GCM_SET_IVLEN || type == EVP_CTRL_AEAD_SET_IVLEN) {
+        assert(ctx->iv_set == false);
+        /* iv length must be positive */
+        assert(arg > 0);
+        ctx->iv_len = arg;
+    }
+
+    /* Only legal when encrypting data. */
+    assert(IMPLIES(type == EVP_CTRL_GCM_GET_TAG, ctx->encrypt == 1));
+    assert(IMPLIES(type == EVP_CTRL_GCM_GET_TAG, ctx->data_processed == true));
+    /* Need to be able to write taglen (arg) bytes to buffer ptr. */
+    assert(IMPLIES(type == EVP_CTRL_GCM_GET_TAG, __CPROVER_w_ok(ptr, arg)));
+
+    /* Only legal when decrypting data. */
+    assert(IMPLIES(type == EVP_CTRL_GCM_SET_TAG, ctx->encrypt == 0));
+    /* Need to be able to write taglen (arg) bytes to buffer ptr. */
+    assert(IMPLIES(type == EVP_CTRL_GCM_SET_TAG, __CPROVER_w_ok(ptr, arg)));
+
+    int rv = inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER) ? 0 : 1;
+    return rv;
+}
+
+/*
+ * EVP_CIPHER_CTX_free() clears all information from a cipher context and free up any allocated memory associate with
+ * it, including ctx itself. This function should be called after all operations using a cipher are complete so
+ * sensitive information does not remain in memory.
+ */
+void EVP_CIPHER_CTX_free(EVP_CIPHER_CTX *ctx)
+    __CPROVER_assigns()
+    __CPROVER_frees(ctx)
+{
+    if (ctx) {
+        evp_cipher_ctx_pool_free(ctx);
+    }
+}
+
+/*
+ * EVP_EncryptInit_ex() sets up cipher context ctx for encryption with cipher type from ENGINE impl.
+ * ctx must be created before calling this function. type is normally supplied by a function such as EVP_aes_256_cbc().
+ * If impl is NULL then the default implementation is used. key is the symmetric key to use and iv is the IV to use (if
+ * necessary), the actual number of bytes used for the key and IV depends on the cipher. It is possible to set all
+ * parameters to NULL except type in an initial call and supply the remaining parameters in subsequent calls, all of
+ * which have type set to NULL. This is done when the default cipher parameters are not appropriate.
+ * Every call starts a new operation, so a context that finished one (e.g. with EVP_EncryptFinal_ex()) is rekeyed in
+ * place by EVP_EncryptInit_ex(ctx, NULL, NULL, key, iv).
+ */
+int EVP_EncryptInit_ex(
+    EVP_CIPHER_CTX *ctx, const EVP_CIPHER *type, ENGINE *impl, const unsigned char *key, const unsigned char *iv)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(type == NULL || evp_cipher_is_valid((EVP_CIPHER *)type))
+    __CPROVER_assigns(ctx->encrypt, ctx->cipher, ctx->iv_set, EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx))
+    __CPROVER_ensures(ctx->encrypt == 1)
+    __CPROVER_ensures(ctx->cipher == (type == NULL ? __CPROVER_old(ctx->cipher) : type))
+    __CPROVER_ensures(ctx->iv_set == (iv != NULL || __CPROVER_old(ctx->iv_set)))
+    __CPROVER_ensures(EVP_CIPHER_CTX_OPERATION_IS_FRESH(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    return EVP_CipherInit_ex(ctx, type, impl, key, iv, 1);
+}
+
+/*
+ * EVP_DecryptInit_ex() is the corresponding decryption operation. As with EVP_EncryptInit_ex(), a NULL type keeps the
+ * cipher of ctx, e.g. to rekey a context that was used before: every call starts a new operation.
+ */
+int EVP_DecryptInit_ex(
+    EVP_CIPHER_CTX *ctx, const EVP_CIPHER *type, ENGINE *impl, const unsigned char *key, const unsigned char *iv)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(type != NULL ? evp_cipher_is_valid((EVP_CIPHER *)type) : ctx->cipher != NULL)
+    __CPROVER_assigns(ctx->encrypt, ctx->cipher, ctx->iv_set, EVP_CIPHER_CTX_OPERATION_ASSIGNS(ctx))
+    __CPROVER_ensures(ctx->encrypt == 0)
+    __CPROVER_ensures(ctx->cipher == (type == NULL ? __CPROVER_old(ctx->cipher) : type))
+    __CPROVER_ensures(ctx->iv_set == (iv != NULL || __CPROVER_old(ctx->iv_set)))
+    __CPROVER_ensures(EVP_CIPHER_CTX_OPERATION_IS_FRESH(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    assert(type != NULL || ctx->cipher != NULL);
+    return EVP_CipherInit_ex(ctx, type, impl, key, iv, 0);
+}
+
+/*
+ * Number of bytes EVP_EncryptUpdate() and EVP_DecryptUpdate() write when inl bytes of input follow the buffered bytes
+ * of a cipher with the given block size: all whole blocks, except that a padded decryption holds the last block back
+ * for EVP_DecryptFinal_ex(), as it may be all padding. Stream modes (block size 1) write exactly inl bytes.
+ */
+static size_t evp_cipher_update_size(size_t block_size, int buffered, bool hold_back_last_block, int inl) {
+    size_t available = (size_t)buffered + (size_t)inl;
+    if (hold_back_last_block && block_size > 1 && available > 0) available -= 1;
+    return available - available % block_size;
+}
+
+#define EVP_CIPHER_UPDATE_SIZE(ctx, hold_back_last_block, inl) \
+    evp_cipher_update_size((ctx)->cipher->block_size, (ctx)->data_remaining, (hold_back_last_block), (inl))
+
+/* Size of the padded last block that EVP_EncryptFinal_ex() writes, or 0 without padding or in a stream mode. */
+#define EVP_CIPHER_FINAL_BLOCK_SIZE(ctx) \
+    ((ctx)->padding && (ctx)->cipher->block_size > 1 ? (ctx)->cipher->block_size : 0)
+
+/*
+ * Shared implementation of EVP_EncryptUpdate() and EVP_DecryptUpdate(). A NULL out passes additional authenticated
+ * data, which must come before the first byte of data.
+ */
+static int evp_cipher_update(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl, int inl, bool hold_back_last_block) {
+    assert(ctx != NULL);
+    assert(ctx->data_processed == false);
+    assert(0 <= inl);
+    if (out == NULL) {  // specifying aad
+        assert(ctx->cipher == NULL || ctx->phase == EVP_CIPHER_PHASE_AAD);
+        if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+        ctx->aad_len += inl;
+        return 1;
+    }
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+
+    size_t out_size;
+    if (ctx->cipher) {
+        /* Exact, so that the output offsets of a chunked operation fold to constants. */
+        out_size = EVP_CIPHER_UPDATE_SIZE(ctx, hold_back_last_block, inl);
+        ctx->data_remaining = ctx->data_remaining + inl - (int)out_size;
+    } else {
+        /* Unknown cipher: up to inl bytes are written, the rest is left for the final call. */
+        out_size = nondet_size_t();
+        __CPROVER_assume(out_size <= inl);
+        ctx->data_remaining = inl - out_size;
+    }
+    ctx->phase = EVP_CIPHER_PHASE_DATA;
+    ctx->data_len += inl;
+    /*
+     * This check is redundant with the following __CPROVER_w_ok.
+     * __CPROVER_w_ok is a macro for __CPROVER_w_ok primitive, which
+     * should return true if out is writable upt to out_size bytes;
+     * however, __CPROVER_w_ok has been replaced by a simple nullness check for now.
+     * Thus, we also include an additional check using __CPROVER_OBJECT_SIZE.
+     */
+    assert(__CPROVER_OBJECT_SIZE(out) >= out_size);
+    assert(__CPROVER_w_ok(out, out_size));
+    *outl = out_size;
+    return 1;
+}
+
+/*
+ * EVP_CipherInit_ex(), EVP_CipherUpdate() and EVP_CipherFinal_ex() are functions that can be used for decryption
+ * or encryption. The operation performed depends on the value of the enc parameter. It should be set to 1 for
+ * encryption, 0 for decryption and -1 to leave the value unchanged (the actual value of 'enc' being supplied in a
+ * previous call). Return 1 for success and 0 for failure.
+ * To specify any additional authenticated data (AAD) a call to EVP_CipherUpdate(), EVP_EncryptUpdate() or
+ * EVP_DecryptUpdate() should be made with the output parameter out set to NULL.
+ */
+int EVP_CipherUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && !ctx->data_processed && 0 <= inl)
+    __CPROVER_requires(evp_cipher_ctx_is_valid(ctx))
+    __CPROVER_requires(out != NULL || ctx->cipher == NULL || ctx->phase == EVP_CIPHER_PHASE_AAD)
+    __CPROVER_requires(
+        out == NULL ||
+        (__CPROVER_w_ok(outl, sizeof(*outl)) &&
+         (ctx->cipher == NULL
+              ? __CPROVER_w_ok(out, inl)
+              : inl <= INT_MAX - ctx->data_remaining &&
+                    __CPROVER_w_ok(out, EVP_CIPHER_UPDATE_SIZE(ctx, !ctx->encrypt && ctx->padding, inl)))))
+    __CPROVER_assigns(out == NULL: ctx->aad_len; out != NULL: *outl, ctx->data_remaining, ctx->phase, ctx->data_len)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || out != NULL || ctx->aad_len == __CPROVER_old(ctx->aad_len) + inl)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL ||
+        (ctx->phase == EVP_CIPHER_PHASE_DATA && ctx->data_len == __CPROVER_old(ctx->data_len) + inl && 0 <= *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher == NULL ||
+        (*outl == evp_cipher_update_size(
+                      ctx->cipher->block_size,
+                      __CPROVER_old(ctx->data_remaining),
+                      !ctx->encrypt && ctx->padding,
+                      inl) &&
+         ctx->data_remaining == __CPROVER_old(ctx->data_remaining) + inl - *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher != NULL ||
+        (*outl <= inl && ctx->data_remaining == inl - *outl))
+{
+    assert(ctx != NULL);
+    if (ctx->encrypt) {
+        return EVP_EncryptUpdate(ctx, out, outl, in, inl);
+    } else
+        return EVP_DecryptUpdate(ctx, out, outl, in, inl);
+}
+
+/*
+ * EVP_EncryptUpdate() encrypts inl bytes from the buffer in and writes the encrypted version to out.
+ * This function can be called multiple times to encrypt successive blocks of data. The amount of data written depends
+ * on the block alignment of the encrypted data: as a result the amount of data written may be anything from zero bytes
+ * to (inl + cipher_block_size - 1) so out should contain sufficient room. The actual number of bytes written is placed
+ * in outl. It also checks if in and out are partially overlapping, and if they are 0 is returned to indicate failure.
+ * The model writes exactly the whole blocks available (all inl bytes for GCM) and requires out to have room for them.
+ */
+int EVP_EncryptUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && !ctx->data_processed && 0 <= inl)
+    __CPROVER_requires(evp_cipher_ctx_is_valid(ctx))
+    __CPROVER_requires(out != NULL || ctx->cipher == NULL || ctx->phase == EVP_CIPHER_PHASE_AAD)
+    __CPROVER_requires(
+        out == NULL ||
+        (__CPROVER_w_ok(outl, sizeof(*outl)) &&
+         (ctx->cipher == NULL ? __CPROVER_w_ok(out, inl)
+                              : inl <= INT_MAX - ctx->data_remaining &&
+                                    __CPROVER_w_ok(out, EVP_CIPHER_UPDATE_SIZE(ctx, false, inl)))))
+    __CPROVER_assigns(out == NULL: ctx->aad_len; out != NULL: *outl, ctx->data_remaining, ctx->phase, ctx->data_len)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || out != NULL || ctx->aad_len == __CPROVER_old(ctx->aad_len) + inl)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL ||
+        (ctx->phase == EVP_CIPHER_PHASE_DATA && ctx->data_len == __CPROVER_old(ctx->data_len) + inl && 0 <= *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher == NULL ||
+        (*outl == evp_cipher_update_size(ctx->cipher->block_size, __CPROVER_old(ctx->data_remaining), false, inl) &&
+         ctx->data_remaining == __CPROVER_old(ctx->data_remaining) + inl - *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher != NULL ||
+        (*outl <= inl && ctx->data_remaining == inl - *outl))
+{
+    COUNT_CALL(MODEL_CALL_EVP_ENCRYPT_UPDATE, inl);
+    return evp_cipher_update(ctx, out, outl, inl, false);
+}
+
+/*
+ * EVP_DecryptUpdate() is the corresponding decryption operation.
+ * EVP_DecryptFinal() will return an error code if padding is enabled and the final block is not correctly formatted.
+ * The parameters and restrictions are identical to the encryption operations except that if padding is enabled the
+ * decrypted data buffer out passed to EVP_DecryptUpdate() should have sufficient room for (inl + cipher_block_size)
+ * bytes unless the cipher block size is 1 in which case inl bytes is sufficient.
+ * With padding, the model holds the last whole block back for EVP_DecryptFinal_ex(), as OpenSSL does.
+ */
+int EVP_DecryptUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && !ctx->data_processed && 0 <= inl)
+    __CPROVER_requires(evp_cipher_ctx_is_valid(ctx))
+    __CPROVER_requires(out != NULL || ctx->cipher == NULL || ctx->phase == EVP_CIPHER_PHASE_AAD)
+    __CPROVER_requires(
+        out == NULL ||
+        (__CPROVER_w_ok(outl, sizeof(*outl)) &&
+         (ctx->cipher == NULL ? __CPROVER_w_ok(out, inl)
+                              : inl <= INT_MAX - ctx->data_remaining &&
+                                    __CPROVER_w_ok(out, EVP_CIPHER_UPDATE_SIZE(ctx, ctx->padding, inl)))))
+    __CPROVER_assigns(out == NULL: ctx->aad_len; out != NULL: *outl, ctx->data_remaining, ctx->phase, ctx->data_len)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || out != NULL || ctx->aad_len == __CPROVER_old(ctx->aad_len) + inl)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL ||
+        (ctx->phase == EVP_CIPHER_PHASE_DATA && ctx->data_len == __CPROVER_old(ctx->data_len) + inl && 0 <= *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher == NULL ||
+        (*outl == evp_cipher_update_size(
+                      ctx->cipher->block_size, __CPROVER_old(ctx->data_remaining), ctx->padding, inl) &&
+         ctx->data_remaining == __CPROVER_old(ctx->data_remaining) + inl - *outl))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || out == NULL || ctx->cipher != NULL ||
+        (*outl <= inl && ctx->data_remaining == inl - *outl))
+{
+    COUNT_CALL(MODEL_CALL_EVP_DECRYPT_UPDATE, inl);
+    return evp_cipher_update(ctx, out, outl, inl, ctx->padding);
+}
+
+/*
+ * If padding is enabled (the default) then EVP_EncryptFinal_ex() encrypts the "final" data, that is any data that
+ * remains in a partial block. It uses standard block padding (aka PKCS padding).
+ * The encrypted final data is written to out which should have sufficient space for one cipher block.
+ * The number of bytes written is placed in outl. After this function is called the encryption operation is finished and
+ * no further calls to EVP_EncryptUpdate() should be made.
+ * If padding is disabled, an error is returned unless the data was a whole number of blocks. Stream modes such as GCM
+ * write nothing.
+ */
+int EVP_EncryptFinal_ex(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(evp_cipher_ctx_is_valid(ctx))
+    __CPROVER_requires(
+        ctx->cipher == NULL
+            ? !ctx->padding || (__CPROVER_w_ok(outl, sizeof(*outl)) && __CPROVER_w_ok(out, ctx->data_remaining))
+            : __CPROVER_w_ok(outl, sizeof(*outl)) && __CPROVER_w_ok(out, EVP_CIPHER_FINAL_BLOCK_SIZE(ctx)))
+    __CPROVER_assigns(
+        ctx->data_processed, ctx->phase; ctx->cipher != NULL: ctx->data_remaining;
+        ctx->padding || ctx->cipher != NULL: *outl)
+    __CPROVER_ensures(ctx->data_processed && ctx->phase == EVP_CIPHER_PHASE_FINAL)
+    __CPROVER_ensures(ctx->cipher != NULL || !ctx->padding || *outl == ctx->data_remaining)
+    __CPROVER_ensures(
+        ctx->cipher == NULL || __CPROVER_return_value == 0 || *outl == EVP_CIPHER_FINAL_BLOCK_SIZE(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    ctx->data_processed = true;
+    ctx->phase          = EVP_CIPHER_PHASE_FINAL;
+    if (ctx->cipher == NULL) {
+        if (ctx->padding == true) {
+            *outl = ctx->data_remaining;
+            assert(__CPROVER_w_ok(out, ctx->data_remaining));
+        }
+        int rv = inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER) ? 0 : 1;
+        return rv;
+    }
+
+    int buffered        = ctx->data_remaining;
+    ctx->data_remaining = 0;
+    *outl               = 0;
+    /* Without padding, the input must have been a whole number of blocks. */
+    if (EVP_CIPHER_FINAL_BLOCK_SIZE(ctx) == 0 && buffered != 0) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+    /* The padded last block is always a whole block, however many bytes of it are data. */
+    assert(__CPROVER_w_ok(out, EVP_CIPHER_FINAL_BLOCK_SIZE(ctx)));
+    *outl = EVP_CIPHER_FINAL_BLOCK_SIZE(ctx);
+    return 1;
+}
+/*
+ * EVP_DecryptFinal_ex() is the corresponding decryption operation.
+ * EVP_DecryptFinal() will return an error code if padding is enabled and the final block is not correctly formatted.
+ * The parameters and restrictions are identical to the encryption operations except that if padding is enabled the
+ * decrypted data buffer out passed to EVP_DecryptUpdate() should have sufficient room for (inl + cipher_block_size)
+ * bytes unless the cipher block size is 1 in which case inl bytes is sufficient.
+ * With padding, the held back block is written without its padding, i.e. less than one block. For GCM this is where a
+ * tag mismatch is reported.
+ */
+int EVP_DecryptFinal_ex(EVP_CIPHER_CTX *ctx, unsigned char *outm, int *outl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(evp_cipher_ctx_is_valid(ctx))
+    __CPROVER_requires(
+        ctx->cipher == NULL
+            ? !ctx->padding || (__CPROVER_w_ok(outl, sizeof(*outl)) && __CPROVER_w_ok(outm, ctx->data_remaining))
+            : __CPROVER_w_ok(outl, sizeof(*outl)) && __CPROVER_w_ok(outm, EVP_CIPHER_FINAL_BLOCK_SIZE(ctx)))
+    __CPROVER_assigns(
+        ctx->data_processed, ctx->phase; ctx->cipher != NULL: ctx->data_remaining;
+        ctx->padding || ctx->cipher != NULL: *outl)
+    __CPROVER_ensures(ctx->data_processed && ctx->phase == EVP_CIPHER_PHASE_FINAL)
+    __CPROVER_ensures(ctx->cipher != NULL || !ctx->padding || *outl == ctx->data_remaining)
+    __CPROVER_ensures(
+        ctx->cipher == NULL || __CPROVER_return_value == 0 ||
+        (EVP_CIPHER_FINAL_BLOCK_SIZE(ctx) == 0 ? *outl == 0
+                                               : 0 <= *outl && *outl < EVP_CIPHER_FINAL_BLOCK_SIZE(ctx)))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+    ctx->data_processed = true;
+    ctx->phase          = EVP_CIPHER_PHASE_FINAL;
+    if (ctx->cipher == NULL) {
+        if (ctx->padding == true) {
+            *outl = ctx->data_remaining;
+            assert(__CPROVER_w_ok(outm, ctx->data_remaining));
+        }
+        int rv = inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER) ? 0 : 1;
+        return rv;
+    }
+
+    int buffered        = ctx->data_remaining;
+    size_t block_size   = EVP_CIPHER_FINAL_BLOCK_SIZE(ctx);
+    ctx->data_remaining = 0;
+    *outl               = 0;
+    /* With padding, EVP_DecryptUpdate() must have held back a whole block; without, nothing may be left over. */
+    if ((size_t)buffered != block_size) return 0;
+    /* Also covers a malformed padding or, for GCM, a tag mismatch. */
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+    if (block_size > 0) {
+        size_t padding_size = nondet_size_t();
+        __CPROVER_assume(1 <= padding_size && padding_size <= block_size);
+        assert(__CPROVER_w_ok(outm, block_size - padding_size));
+        *outl = block_size - padding_size;
+    }
+    return 1;
+}
+
+bool evp_aead_is_valid(const EVP_AEAD *aead);
+bool evp_aead_ctx_is_valid(const EVP_AEAD_CTX *ctx);
+
+/*
+ * Description: AES for 128, 192 and 256 bit keys in Galois Counter Mode (GCM) as AEADs for the EVP_AEAD_CTX
+ * interface, with 96-bit nonces and tags of up to 16 bytes. Return values: These functions return an EVP_AEAD
+ * structure that contains the implementation of the AEAD.
+ */
+const EVP_AEAD *EVP_aead_aes_128_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_aead_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_128_GCM)
+{
+    static const EVP_AEAD aead = {
+        EVP_AES_128_GCM, 16, DEFAULT_IV_LEN, EVP_AEAD_AES_GCM_TAG_LEN, EVP_AEAD_AES_GCM_TAG_LEN
+    };
+    return &aead;
+}
+const EVP_AEAD *EVP_aead_aes_192_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_aead_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_192_GCM)
+{
+    static const EVP_AEAD aead = {
+        EVP_AES_192_GCM, 24, DEFAULT_IV_LEN, EVP_AEAD_AES_GCM_TAG_LEN, EVP_AEAD_AES_GCM_TAG_LEN
+    };
+    return &aead;
+}
+const EVP_AEAD *EVP_aead_aes_256_gcm(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_aead_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_AES_256_GCM)
+{
+    static const EVP_AEAD aead = {
+        EVP_AES_256_GCM, 32, DEFAULT_IV_LEN, EVP_AEAD_AES_GCM_TAG_LEN, EVP_AEAD_AES_GCM_TAG_LEN
+    };
+    return &aead;
+}
+
+/*
+ * Description: EVP_AEAD_key_length() returns the length, in bytes, of the keys used by aead. EVP_AEAD_nonce_length()
+ * returns the length, in bytes, of the per-message nonce for aead. EVP_AEAD_max_overhead() returns the maximum number
+ * of additional bytes added by the act of sealing data with aead. EVP_AEAD_max_tag_len() returns the maximum tag
+ * length when using aead.
+ */
+size_t EVP_AEAD_key_length(const EVP_AEAD *aead)
+    __CPROVER_requires(evp_aead_is_valid(aead))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == aead->key_len)
+{
+    return aead->key_len;
+}
+size_t EVP_AEAD_nonce_length(const EVP_AEAD *aead)
+    __CPROVER_requires(evp_aead_is_valid(aead))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == aead->nonce_len)
+{
+    return aead->nonce_len;
+}
+size_t EVP_AEAD_max_overhead(const EVP_AEAD *aead)
+    __CPROVER_requires(evp_aead_is_valid(aead))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == aead->overhead)
+{
+    return aead->overhead;
+}
+size_t EVP_AEAD_max_tag_len(const EVP_AEAD *aead)
+    __CPROVER_requires(evp_aead_is_valid(aead))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == aead->max_tag_len)
+{
+    return aead->max_tag_len;
+}
+
+/*
+ * Whether the len_a bytes at a and the len_b bytes at b overlap. Sealing and opening may work in place, with the
+ * output at the very address of the input, but fail on any other overlap.
+ */
+static bool evp_aead_buffers_alias(const uint8_t *a, size_t len_a, const uint8_t *b, size_t len_b) {
+    return len_a > 0 && len_b > 0 && __CPROVER_same_object(a, b) &&
+           __CPROVER_POINTER_OFFSET(a) < __CPROVER_POINTER_OFFSET(b) + len_b &&
+           __CPROVER_POINTER_OFFSET(b) < __CPROVER_POINTER_OFFSET(a) + len_a;
+}
+
+#define EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, out_len) \
+    ((in) == (out) || !evp_aead_buffers_alias((in), (in_len), (out), (out_len)))
+
+/* Whether a sealed message of in_len bytes (ciphertext and tag) fits in max_out_len bytes, without overflow. */
+#define EVP_AEAD_SEALED_FITS(ctx, in_len, max_out_len) \
+    ((ctx)->tag_len <= (max_out_len) && (in_len) <= (max_out_len) - (ctx)->tag_len)
+
+/* Whether a sealed message of in_len bytes holds a tag and its plaintext fits in max_out_len bytes. */
+#define EVP_AEAD_OPENED_FITS(ctx, in_len, max_out_len) \
+    ((ctx)->tag_len <= (in_len) && (in_len) - (ctx)->tag_len <= (max_out_len))
+
+/*
+ * Description: EVP_AEAD_CTX_init() initializes ctx for the given AEAD algorithm. The impl argument is ignored and
+ * should be NULL. The key must be EVP_AEAD_key_length() bytes. tag_len is the desired tag length, at most
+ * EVP_AEAD_max_tag_len(), of which EVP_AEAD_DEFAULT_TAG_LENGTH selects the longest. The model does not keep the key:
+ * ciphertexts and plaintexts are unconstrained.
+ * Return values: Returns 1 on success. Otherwise returns 0 and leaves ctx uninitialized.
+ */
+int EVP_AEAD_CTX_init(
+    EVP_AEAD_CTX *ctx, const EVP_AEAD *aead, const uint8_t *key, size_t key_len, size_t tag_len, ENGINE *impl)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(evp_aead_is_valid(aead))
+    __CPROVER_requires(key_len == 0 || __CPROVER_r_ok(key, key_len))
+    __CPROVER_requires(impl == NULL)
+    __CPROVER_assigns(*ctx)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || (key_len == aead->key_len && tag_len <= aead->max_tag_len))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? ctx->aead == NULL
+            : ctx->aead == aead &&
+                  ctx->tag_len == (tag_len == EVP_AEAD_DEFAULT_TAG_LENGTH ? aead->max_tag_len : tag_len))
+{
+    assert(ctx != NULL);
+    assert(evp_aead_is_valid(aead));
+    assert(key_len == 0 || __CPROVER_r_ok(key, key_len));
+    assert(impl == NULL);  // Assuming that this function is always called with impl == NULL
+
+    ctx->aead    = NULL;
+    ctx->tag_len = 0;
+    if (key_len != aead->key_len || tag_len > aead->max_tag_len) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+
+    ctx->aead    = aead;
+    ctx->tag_len = tag_len == EVP_AEAD_DEFAULT_TAG_LENGTH ? aead->max_tag_len : tag_len;
+    return 1;
+}
+
+/*
+ * Description: EVP_AEAD_CTX_cleanup() frees any data allocated by ctx. It is a no-op to call it on a ctx that was
+ * never initialized or already cleaned up.
+ */
+void EVP_AEAD_CTX_cleanup(EVP_AEAD_CTX *ctx)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(ctx->aead)
+    __CPROVER_ensures(ctx->aead == NULL)
+{
+    assert(ctx != NULL);
+    ctx->aead = NULL;
+}
+
+/*
+ * Description: EVP_AEAD_CTX_seal() encrypts and authenticates in_len bytes from in and authenticates ad_len bytes
+ * from ad, and writes the result (ciphertext followed by tag, i.e. in_len + ctx->tag_len bytes) to out. At most
+ * max_out_len bytes are written to out, and the number of bytes written is placed in *out_len. The nonce must be
+ * nonce_len bytes long; AES-GCM accepts any non-empty nonce, EVP_AEAD_nonce_length() bytes being the usual length.
+ * out may be in (in-place encryption) but must not otherwise overlap it. On failure nothing is written to out (unlike
+ * BoringSSL, which clears it) and *out_len is set to 0.
+ * Return values: Returns 1 on success and 0 on error.
+ */
+int EVP_AEAD_CTX_seal(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    size_t *out_len,
+    size_t max_out_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *ad,
+    size_t ad_len)
+    __CPROVER_requires(evp_aead_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(out_len, sizeof(*out_len)))
+    __CPROVER_requires(__CPROVER_w_ok(out, max_out_len))
+    __CPROVER_requires(nonce_len == 0 || __CPROVER_r_ok(nonce, nonce_len))
+    __CPROVER_requires(in_len == 0 || __CPROVER_r_ok(in, in_len))
+    __CPROVER_requires(ad_len == 0 || __CPROVER_r_ok(ad, ad_len))
+    __CPROVER_assigns(
+        *out_len; EVP_AEAD_SEALED_FITS(ctx, in_len, max_out_len): UNCONSTRAINED_DATA(out, in_len + ctx->tag_len))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (nonce_len != 0 && EVP_AEAD_SEALED_FITS(ctx, in_len, max_out_len) &&
+         EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, max_out_len)))
+    __CPROVER_ensures(*out_len == (__CPROVER_return_value == 0 ? 0 : in_len + ctx->tag_len))
+{
+    assert(evp_aead_ctx_is_valid(ctx));
+    assert(out_len != NULL);
+    COUNT_CALL(MODEL_CALL_EVP_AEAD_CTX_SEAL, in_len);
+
+    *out_len = 0;
+    if (nonce_len == 0 || !EVP_AEAD_SEALED_FITS(ctx, in_len, max_out_len) ||
+        !EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, max_out_len))
+        return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+
+    write_unconstrained_data(out, in_len + ctx->tag_len);
+    *out_len = in_len + ctx->tag_len;
+    return 1;
+}
+
+/*
+ * Description: EVP_AEAD_CTX_open() authenticates in_len bytes from in and ad_len bytes from ad and decrypts at most
+ * in_len bytes into out: the ciphertext without its ctx->tag_len bytes of tag. At most max_out_len bytes are written
+ * to out, and the number of bytes written is placed in *out_len. out may be in (in-place decryption) but must not
+ * otherwise overlap it. An authentication failure (tag mismatch) is a nondeterministic failure. On failure nothing is
+ * written to out and *out_len is set to 0.
+ * Return values: Returns 1 on success and 0 on error.
+ */
+int EVP_AEAD_CTX_open(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    size_t *out_len,
+    size_t max_out_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *ad,
+    size_t ad_len)
+    __CPROVER_requires(evp_aead_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(out_len, sizeof(*out_len)))
+    __CPROVER_requires(__CPROVER_w_ok(out, max_out_len))
+    __CPROVER_requires(nonce_len == 0 || __CPROVER_r_ok(nonce, nonce_len))
+    __CPROVER_requires(in_len == 0 || __CPROVER_r_ok(in, in_len))
+    __CPROVER_requires(ad_len == 0 || __CPROVER_r_ok(ad, ad_len))
+    __CPROVER_assigns(
+        *out_len; EVP_AEAD_OPENED_FITS(ctx, in_len, max_out_len): UNCONSTRAINED_DATA(out, in_len - ctx->tag_len))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (nonce_len != 0 && EVP_AEAD_OPENED_FITS(ctx, in_len, max_out_len) &&
+         EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, max_out_len)))
+    __CPROVER_ensures(*out_len == (__CPROVER_return_value == 0 ? 0 : in_len - ctx->tag_len))
+{
+    assert(evp_aead_ctx_is_valid(ctx));
+    assert(out_len != NULL);
+    COUNT_CALL(MODEL_CALL_EVP_AEAD_CTX_OPEN, in_len);
+
+    *out_len = 0;
+    if (nonce_len == 0 || !EVP_AEAD_OPENED_FITS(ctx, in_len, max_out_len) ||
+        !EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, max_out_len))
+        return 0;
+    /* Also covers a tag mismatch. */
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+
+    write_unconstrained_data(out, in_len - ctx->tag_len);
+    *out_len = in_len - ctx->tag_len;
+    return 1;
+}
+
+/*
+ * Description: EVP_AEAD_CTX_seal_scatter() encrypts and authenticates in_len bytes from in and authenticates ad_len
+ * bytes from ad. It writes in_len bytes of ciphertext to out and the authentication tag to out_tag. For AES-GCM, the
+ * extra_in_len bytes at extra_in are encrypted as well, and their ciphertext is written to out_tag before the tag:
+ * out_tag receives extra_in_len + ctx->tag_len bytes, at most max_out_tag_len, and *out_tag_len is set to the number
+ * of bytes written. out may be in but must not otherwise overlap it. On failure nothing is written to out and out_tag,
+ * and *out_tag_len is set to 0.
+ * Return values: Returns 1 on success and 0 on error.
+ */
+int EVP_AEAD_CTX_seal_scatter(
+    const EVP_AEAD_CTX *ctx,
+    uint8_t *out,
+    uint8_t *out_tag,
+    size_t *out_tag_len,
+    size_t max_out_tag_len,
+    const uint8_t *nonce,
+    size_t nonce_len,
+    const uint8_t *in,
+    size_t in_len,
+    const uint8_t *extra_in,
+    size_t extra_in_len,
+    const uint8_t *ad,
+    size_t ad_len)
+    __CPROVER_requires(evp_aead_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(out_tag_len, sizeof(*out_tag_len)))
+    __CPROVER_requires(__CPROVER_w_ok(out, in_len))
+    __CPROVER_requires(__CPROVER_w_ok(out_tag, max_out_tag_len))
+    __CPROVER_requires(nonce_len == 0 || __CPROVER_r_ok(nonce, nonce_len))
+    __CPROVER_requires(in_len == 0 || __CPROVER_r_ok(in, in_len))
+    __CPROVER_requires(extra_in_len == 0 || __CPROVER_r_ok(extra_in, extra_in_len))
+    __CPROVER_requires(ad_len == 0 || __CPROVER_r_ok(ad, ad_len))
+    __CPROVER_assigns(
+        *out_tag_len; EVP_AEAD_SEALED_FITS(ctx, extra_in_len, max_out_tag_len): UNCONSTRAINED_DATA(out, in_len),
+        UNCONSTRAINED_DATA(out_tag, extra_in_len + ctx->tag_len))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (nonce_len != 0 && EVP_AEAD_SEALED_FITS(ctx, extra_in_len, max_out_tag_len) &&
+         in_len <= SIZE_MAX - ctx->aead->overhead && EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, in_len)))
+    __CPROVER_ensures(*out_tag_len == (__CPROVER_return_value == 0 ? 0 : extra_in_len + ctx->tag_len))
+{
+    assert(evp_aead_ctx_is_valid(ctx));
+    assert(out_tag_len != NULL);
+    COUNT_CALL(MODEL_CALL_EVP_AEAD_CTX_SEAL, in_len);
+
+    *out_tag_len = 0;
+    if (nonce_len == 0 || !EVP_AEAD_SEALED_FITS(ctx, extra_in_len, max_out_tag_len) ||
+        in_len > SIZE_MAX - ctx->aead->overhead || !EVP_AEAD_IN_PLACE_OR_DISJOINT(in, in_len, out, in_len))
+        return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_CIPHER)) return 0;
+
+    write_unconstrained_data(out, in_len);
+    write_unconstrained_data(out_tag, extra_in_len + ctx->tag_len);
+    *out_tag_len = extra_in_len + ctx->tag_len;
+    return 1;
+}
+
+/* CBMC helper functions */
+
+bool evp_cipher_is_valid(EVP_CIPHER *cipher) {
+    return cipher && (cipher->from == EVP_AES_128_GCM || cipher->from == EVP_AES_192_GCM ||
+                      cipher->from == EVP_AES_256_GCM || cipher->from == EVP_AES_128_ECB);
+}
+
+/*
+ * Helper function for CBMC proofs: checks if EVP_CIPHER_CTX is valid. Once a cipher is set, at most one block of input
+ * is buffered.
+ */
+bool evp_cipher_ctx_is_valid(EVP_CIPHER_CTX *ctx) {
+    return ctx && (ctx->cipher == NULL || (evp_cipher_is_valid(ctx->cipher) && 0 <= ctx->data_remaining &&
+                                           ctx->data_remaining <= ctx->cipher->block_size));
+}
+
+/* Helper function for CBMC proofs: checks if aead is one of the AES-GCM AEADs. */
+bool evp_aead_is_valid(const EVP_AEAD *aead) {
+    return aead &&
+           ((aead->from == EVP_AES_128_GCM && aead->key_len == 16) ||
+            (aead->from == EVP_AES_192_GCM && aead->key_len == 24) ||
+            (aead->from == EVP_AES_256_GCM && aead->key_len == 32)) &&
+           aead->nonce_len == DEFAULT_IV_LEN && aead->overhead == EVP_AEAD_AES_GCM_TAG_LEN &&
+           aead->max_tag_len == EVP_AEAD_AES_GCM_TAG_LEN;
+}
+
+/* Helper function for CBMC proofs: checks if an EVP_AEAD_CTX was initialized by EVP_AEAD_CTX_init(). */
+bool evp_aead_ctx_is_valid(const EVP_AEAD_CTX *ctx) {
+    return ctx && evp_aead_is_valid(ctx->aead) && 0 < ctx->tag_len && ctx->tag_len <= ctx->aead->max_tag_len;
+}
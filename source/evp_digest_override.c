@@ -0,0 +1,574 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <call_count_utils.h>
+#include <evp_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <openssl/evp.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_MODEL_POOL(EVP_MD_CTX, evp_md_ctx)
+
+const EVP_MD evp_md_table[EVP_MD_TABLE_SIZE] = {
+    [EVP_MD5]    = { EVP_MD5, 0, 0, 16 /* Digest length. */, 0, 0, 16 },
+    [EVP_SHA1]   = { EVP_SHA1, 0, 0, 20 /* Digest length. */, 0, 0, 20 },
+    [EVP_SHA224] = { EVP_SHA224, 0, 0, 28 /* Digest length. */, 0, 0, 28 },
+    [EVP_SHA256] = { EVP_SHA256, 0, 0, 32 /* Digest length. */, 0, 0, 32 },
+    [EVP_SHA384] = { EVP_SHA384, 0, 0, 48 /* Digest length. */, 0, 0, 48 },
+    [EVP_SHA512] = { EVP_SHA512, 0, 0, 64 /* Digest length. */, 0, 0, 64 },
+};
+
+/*
+ * Description: The SHA-2 SHA-224, SHA-256, SHA-512/224, SHA512/256, SHA-384 and SHA-512 algorithms, which generate 224,
+ * 256, 224, 256, 384 and 512 bits respectively of output from a given input. Return values: These functions return a
+ * EVP_MD structure that contains the implementation of the symmetric cipher.
+ */
+const EVP_MD *EVP_md5()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_MD5)
+{
+    return &evp_md_table[EVP_MD5];
+}
+const EVP_MD *EVP_sha1()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_SHA1)
+{
+    return &evp_md_table[EVP_SHA1];
+}
+const EVP_MD *EVP_sha224()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_SHA224)
+{
+    return &evp_md_table[EVP_SHA224];
+}
+const EVP_MD *EVP_sha256()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_SHA256)
+{
+    return &evp_md_table[EVP_SHA256];
+}
+const EVP_MD *EVP_sha384()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_SHA384)
+{
+    return &evp_md_table[EVP_SHA384];
+}
+const EVP_MD *EVP_sha512()
+    __CPROVER_assigns()
+    __CPROVER_ensures(evp_md_is_valid(__CPROVER_return_value) && __CPROVER_return_value->from == EVP_SHA512)
+{
+    return &evp_md_table[EVP_SHA512];
+}
+
+/* Description: Return the size of the message digest when passed an EVP_MD or an EVP_MD_CTX structure, i.e. the size of
+ * the hash.
+ */
+int EVP_MD_size(const EVP_MD *md)
+    __CPROVER_requires(__CPROVER_r_ok(md, sizeof(*md)) && 0 <= md->from && md->from < EVP_MD_TABLE_SIZE)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == evp_md_table[md->from].md_size)
+{
+    assert(md != NULL);
+    assert(0 <= md->from && md->from < EVP_MD_TABLE_SIZE);
+    return evp_md_table[md->from].md_size;
+}
+
+/*
+ * Releases the public key context of ctx. Compiled out with LIBCRYPTO_MODEL_MD_CTX_NO_PKEY, where ctx->pctx is always
+ * NULL, so that this unit does not use the EVP_PKEY family in that configuration.
+ */
+static void evp_md_ctx_free_pctx(EVP_MD_CTX *ctx) {
+#ifndef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    EVP_PKEY_CTX_free(ctx->pctx);
+#endif
+}
+
+/* Helper function for CBMC proofs: checks if EVP_MD_CTX is valid. */
+bool evp_md_ctx_is_valid(EVP_MD_CTX *ctx) {
+    return ctx && ctx->digest != NULL && ctx->digest->md_size <= EVP_MAX_MD_SIZE && EVP_MD_CTX_PCTX_IS_VALID(ctx->pctx);
+}
+
+/*
+ * Description: Allocates and returns a digest context.
+ */
+EVP_MD_CTX *EVP_MD_CTX_new()
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_MD_CTX)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->digest == NULL && __CPROVER_return_value->md_data == NULL &&
+         __CPROVER_return_value->pctx == NULL && __CPROVER_return_value->bytes_absorbed == 0 &&
+         !__CPROVER_return_value->is_finalized))
+{
+    EVP_MD_CTX *ctx = evp_md_ctx_pool_alloc();
+
+    if (ctx != NULL) {
+        ctx->digest         = NULL;
+        ctx->md_data        = NULL;
+        ctx->pctx           = NULL;
+        ctx->bytes_absorbed = 0;
+        ctx->is_finalized   = false;
+    }
+
+    return ctx;
+}
+
+/*
+ * Description: Return the size of the message digest when passed an EVP_MD or an EVP_MD_CTX structure, i.e. the size of
+ * the hash. Return values: Returns the digest or block size in bytes.
+ */
+int EVP_MD_CTX_size(const EVP_MD_CTX *ctx)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(
+        __CPROVER_r_ok(ctx->digest, sizeof(*ctx->digest)) && 0 <= ctx->digest->from &&
+        ctx->digest->from < EVP_MD_TABLE_SIZE)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == evp_md_table[ctx->digest->from].md_size)
+{
+    assert(ctx != NULL);
+    return EVP_MD_size(ctx->digest);
+}
+
+/*
+ * Description: Cleans up digest context ctx and frees up the space allocated to it.
+ */
+void EVP_MD_CTX_free(EVP_MD_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_r_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(EVP_PKEY_CTX_RELEASE_ASSIGNS(ctx != NULL, ctx->pctx))
+    __CPROVER_frees(ctx != NULL: ctx, ctx->md_data; EVP_PKEY_CTX_FREES(ctx != NULL, ctx->pctx))
+{
+    if (ctx != NULL) {
+        /* ctx->digest points to one of the static EVP_MD objects, so it is not freed. */
+        model_free(ctx->md_data);
+        evp_md_ctx_free_pctx(ctx);
+        evp_md_ctx_pool_free(ctx);
+    }
+}
+
+/*
+ * Description: This call frees resources associated with the context.
+ */
+int EVP_MD_CTX_cleanup(EVP_MD_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(ctx != NULL: ctx->md_data, ctx->pctx; EVP_PKEY_CTX_RELEASE_ASSIGNS(ctx != NULL, ctx->pctx))
+    __CPROVER_frees(ctx != NULL: ctx->md_data; EVP_PKEY_CTX_FREES(ctx != NULL, ctx->pctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || ctx == NULL || (ctx->md_data == NULL && ctx->pctx == NULL))
+{
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST)) return 0;
+    if (ctx != NULL) {
+        model_free(ctx->md_data);
+        evp_md_ctx_free_pctx(ctx);
+        /* The context may still be passed to EVP_MD_CTX_free(), which must not free these again. */
+        ctx->md_data = NULL;
+        ctx->pctx    = NULL;
+    }
+    return 1;
+}
+
+/*
+ * Description: Resets the digest context ctx so that it can be reused for another digest operation. The model keeps the
+ * md_data buffer of ctx (and the digest it was sized for), so that a following EVP_DigestInit_ex() with the same digest
+ * reuses it instead of freeing and reallocating it. Until then, no digest operation is in progress on ctx. The public
+ * key context is released. Return values: Always returns 1.
+ */
+int EVP_MD_CTX_reset(EVP_MD_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(
+        ctx != NULL: ctx->pctx, ctx->flags, ctx->bytes_absorbed, ctx->is_finalized;
+        EVP_PKEY_CTX_RELEASE_ASSIGNS(ctx != NULL, ctx->pctx))
+    __CPROVER_frees(EVP_PKEY_CTX_FREES(ctx != NULL, ctx->pctx))
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        ctx == NULL || (ctx->pctx == NULL && ctx->flags == 0 && ctx->bytes_absorbed == 0 && ctx->is_finalized))
+{
+    if (ctx == NULL) return 1;
+    evp_md_ctx_free_pctx(ctx);
+    ctx->pctx           = NULL;
+    ctx->flags          = 0;
+    ctx->bytes_absorbed = 0;
+    ctx->is_finalized   = true; /* No EVP_DigestUpdate or EVP_DigestFinal_ex before the next EVP_DigestInit_ex. */
+    return 1;
+}
+
+/*
+ * Description: Returns the EVP_MD structure corresponding to the passed EVP_MD_CTX.
+ */
+const EVP_MD *EVP_MD_CTX_md(const EVP_MD_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_r_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == (ctx == NULL ? NULL : ctx->digest))
+{
+    if (ctx == NULL) return NULL;
+    return ctx->digest;
+}
+
+bool evp_md_is_valid(EVP_MD *md);
+
+/*
+ * Makes ctx->md_data a buffer of type->md_size bytes. The current buffer is reused if it was allocated for the same
+ * digest, otherwise it is freed and a new one is allocated. Returns false if the allocation fails.
+ */
+static bool evp_md_ctx_reserve_md_data(EVP_MD_CTX *ctx, const EVP_MD *type) {
+    if (ctx->md_data != NULL && ctx->digest == type) return true;
+    model_free(ctx->md_data);
+    ctx->md_data = model_malloc(type->md_size);
+    return ctx->md_data != NULL;
+}
+
+/*
+ * Description: Sets up digest context ctx to use a digest type from ENGINE impl. type will typically be supplied by
+ * a function such as EVP_sha1(). If impl is NULL then the default implementation of digest type is used. Return
+ * values: Returns 1 for success and 0 for failure.
+ */
+int EVP_DigestInit_ex(EVP_MD_CTX *ctx, const EVP_MD *type, ENGINE *impl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->md_data == NULL || ctx->digest != NULL) /* md_data is only ever set along with digest. */
+    __CPROVER_requires(evp_md_is_valid(type))
+    __CPROVER_requires(impl == NULL)
+    __CPROVER_assigns(ctx->digest, ctx->md_data, ctx->pctx, EVP_MD_CTX_ABSORB_ASSIGNS(ctx), ctx->is_finalized)
+    __CPROVER_frees(ctx->md_data != NULL && ctx->digest != type: ctx->md_data)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (__CPROVER_old(ctx->md_data) != NULL && __CPROVER_old(ctx->digest) == type
+             ? ctx->md_data == __CPROVER_old(ctx->md_data)
+             : __CPROVER_is_fresh(ctx->md_data, type->md_size)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (ctx->digest == type && ctx->pctx == NULL && ctx->bytes_absorbed == 0 && !ctx->is_finalized))
+{
+    assert(ctx != NULL);  // ctx must be initialized before calling EVP_DigestInit_ex function.
+    assert(evp_md_is_valid(type));
+    assert(impl == NULL);  // Assuming that this function is always called with impl == NULL
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST) || !evp_md_ctx_reserve_md_data(ctx, type)) return 0;
+
+    ctx->digest         = type;
+    ctx->pctx           = NULL;
+    ctx->bytes_absorbed = 0;
+    ctx->is_finalized   = false;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    ctx->fingerprint = DIGEST_FINGERPRINT_EMPTY;
+#endif
+
+    return 1;
+}
+
+/*
+ * Description: Behaves in the same way as EVP_DigestInit_ex() except it always uses the default digest implementation.
+ * Return value: Returns 1 for success and 0 for failure.
+ */
+int EVP_DigestInit(EVP_MD_CTX *ctx, const EVP_MD *type)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->md_data == NULL || ctx->digest != NULL) /* md_data is only ever set along with digest. */
+    __CPROVER_requires(evp_md_is_valid(type))
+    __CPROVER_assigns(ctx->digest, ctx->md_data, ctx->pctx, EVP_MD_CTX_ABSORB_ASSIGNS(ctx), ctx->is_finalized)
+    __CPROVER_frees(ctx->md_data != NULL && ctx->digest != type: ctx->md_data)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (__CPROVER_old(ctx->md_data) != NULL && __CPROVER_old(ctx->digest) == type
+             ? ctx->md_data == __CPROVER_old(ctx->md_data)
+             : __CPROVER_is_fresh(ctx->md_data, type->md_size)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (ctx->digest == type && ctx->pctx == NULL && ctx->bytes_absorbed == 0 && !ctx->is_finalized))
+{
+    return EVP_DigestInit_ex(ctx, type, NULL);
+}
+
+/*
+ * Description: Hashes cnt bytes of data at d into the digest context ctx. This function can be called several times
+ * on the same ctx to hash additional data. Return values: Returns 1 for success and 0 for failure.
+ */
+int EVP_DigestUpdate(EVP_MD_CTX *ctx, const void *d, size_t cnt)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && ctx->digest != NULL && !ctx->is_finalized)
+    __CPROVER_requires(cnt == 0 || __CPROVER_r_ok(d, cnt))
+    __CPROVER_assigns(EVP_MD_CTX_ABSORB_ASSIGNS(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        ctx->bytes_absorbed == (__CPROVER_return_value == 0 ? __CPROVER_old(ctx->bytes_absorbed)
+                                : cnt > SIZE_MAX - __CPROVER_old(ctx->bytes_absorbed)
+                                    ? SIZE_MAX
+                                    : __CPROVER_old(ctx->bytes_absorbed) + cnt))
+{
+    assert(ctx != NULL);
+    assert(ctx->digest != NULL);
+    assert(!ctx->is_finalized); /* No additional calls to EVP_DigestUpdate after EVP_DigestFinal_ex. */
+    assert(cnt == 0 || __CPROVER_r_ok(d, cnt));
+    COUNT_CALL(MODEL_CALL_EVP_DIGEST_UPDATE, cnt);
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST)) {
+        return 0;
+    }
+
+    /* Only the per-context state changes, ctx->digest is shared between all contexts using the same EVP_MD. */
+    ctx->bytes_absorbed = (cnt > SIZE_MAX - ctx->bytes_absorbed) ? SIZE_MAX : ctx->bytes_absorbed + cnt;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    ctx->fingerprint = digest_fingerprint_absorb(ctx->fingerprint, d, cnt);
+#endif
+    return 1;
+}
+
+/*
+ * Description: Retrieves the digest value from ctx and places it in md. If the s parameter is not NULL then the
+ * number of bytes of data written (i.e. the length of the digest) will be written to the integer at s, at most
+ * EVP_MAX_MD_SIZE bytes will be written. After calling EVP_DigestFinal_ex() no additional calls to
+ * EVP_DigestUpdate() can be made, but EVP_DigestInit_ex() can be called to initialize a new digest operation.
+ * Return values: Returns 1 for success and 0 for failure.
+ */
+int EVP_DigestFinal_ex(EVP_MD_CTX *ctx, unsigned char *md, unsigned int *s)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && !ctx->is_finalized)
+    __CPROVER_requires(
+        __CPROVER_r_ok(ctx->digest, sizeof(*ctx->digest)) && 0 <= ctx->digest->from &&
+        ctx->digest->from < EVP_MD_TABLE_SIZE)
+    __CPROVER_requires(__CPROVER_w_ok(md, evp_md_table[ctx->digest->from].md_size))
+    __CPROVER_requires(s == NULL || __CPROVER_w_ok(s, sizeof(*s)))
+    __CPROVER_assigns(
+        ctx->is_finalized, UNCONSTRAINED_DATA(md, evp_md_table[ctx->digest->from].md_size); s != NULL: *s)
+    __CPROVER_ensures(ctx->is_finalized)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || s == NULL || *s == evp_md_table[ctx->digest->from].md_size)
+{
+    assert(ctx != NULL);
+    assert(!ctx->is_finalized);
+    assert(__CPROVER_w_ok(md, EVP_MD_CTX_size(ctx)));
+    // s can be NULL
+    COUNT_CALL(MODEL_CALL_EVP_DIGEST_FINAL, 0);
+
+    DIGEST_OUTPUT(md, EVP_MD_CTX_size(ctx), ctx->digest->from, ctx->fingerprint, DIGEST_FINGERPRINT_EMPTY);
+
+    if (s) *s = EVP_MD_CTX_size(ctx);
+    ctx->is_finalized = true; /* No additional calls to EVP_DigestUpdate. */
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST)) {
+        // Something went wrong, can't guarantee *s will have the correct value
+        if (s) *s = nondet_uint();
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Description: Similar to EVP_DigestFinal_ex() except the digest context ctx is automatically cleaned up.
+ * Return values: Returns 1 for success and 0 for failure.
+ */
+int EVP_DigestFinal(EVP_MD_CTX *ctx, unsigned char *md, unsigned int *s)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && !ctx->is_finalized)
+    __CPROVER_requires(
+        __CPROVER_r_ok(ctx->digest, sizeof(*ctx->digest)) && 0 <= ctx->digest->from &&
+        ctx->digest->from < EVP_MD_TABLE_SIZE)
+    __CPROVER_requires(__CPROVER_w_ok(md, evp_md_table[ctx->digest->from].md_size))
+    __CPROVER_requires(s == NULL || __CPROVER_w_ok(s, sizeof(*s)))
+    __CPROVER_assigns(
+        ctx->is_finalized, UNCONSTRAINED_DATA(md, evp_md_table[ctx->digest->from].md_size); s != NULL: *s)
+    __CPROVER_ensures(ctx->is_finalized)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || s == NULL || *s == evp_md_table[ctx->digest->from].md_size)
+{
+    int ret;
+    ret = EVP_DigestFinal_ex(ctx, md, s);
+    // Context is "cleaned up", but not sure how this restricts future operations
+    // Assuming that EVP_PKEY is not freed, and that EVP_MD_CTX_free still needs to be called
+    return ret;
+}
+
+/*
+ * Description: EVP_Digest() is a wrapper around EVP_DigestInit_ex(), EVP_DigestUpdate() and EVP_DigestFinal_ex()
+ * that hashes count bytes at data with the digest type in one call. The digest is written to md and, if size is not
+ * NULL, its length to *size. The model has a single failure point for the whole sequence and does not need an
+ * EVP_MD_CTX. Return values: Returns 1 for success and 0 for failure.
+ */
+int EVP_Digest(
+    const void *data, size_t count, unsigned char *md, unsigned int *size, const EVP_MD *type, ENGINE *impl)
+    __CPROVER_requires(count == 0 || __CPROVER_r_ok(data, count))
+    __CPROVER_requires(evp_md_is_valid(type) && impl == NULL)
+    __CPROVER_requires(__CPROVER_w_ok(md, evp_md_table[type->from].md_size))
+    __CPROVER_requires(size == NULL || __CPROVER_w_ok(size, sizeof(*size)))
+    __CPROVER_assigns(UNCONSTRAINED_DATA(md, evp_md_table[type->from].md_size); size != NULL: *size)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || size == NULL || *size == evp_md_table[type->from].md_size)
+{
+    assert(count == 0 || __CPROVER_r_ok(data, count));
+    assert(evp_md_is_valid(type));
+    assert(impl == NULL);  // Assuming that this function is always called with impl == NULL
+    int md_size = EVP_MD_size(type);
+    assert(__CPROVER_w_ok(md, md_size));
+    COUNT_CALL(MODEL_CALL_EVP_DIGEST, count);
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST)) return 0;
+
+    DIGEST_OUTPUT(
+        md, md_size, type->from, digest_fingerprint_absorb(DIGEST_FINGERPRINT_EMPTY, data, count),
+        DIGEST_FINGERPRINT_EMPTY);
+    if (size) *size = md_size;
+    return 1;
+}
+
+void EVP_MD_CTX_set_flags(EVP_MD_CTX *ctx, int flags)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(ctx->flags)
+    __CPROVER_ensures(ctx->flags == (__CPROVER_old(ctx->flags) | flags))
+{
+    assert(__CPROVER_w_ok(ctx, sizeof(*ctx)));
+    ctx->flags |= flags;
+}
+
+int EVP_MD_CTX_test_flags(const EVP_MD_CTX *ctx, int flags)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == (int)(ctx->flags & flags))
+{
+    assert(__CPROVER_w_ok(ctx, sizeof(*ctx)));
+    return (ctx->flags & flags);
+}
+
+/*
+ * Description: EVP_MD_CTX_copy_ex() can be used to copy the message digest state from in to out. This is useful if
+ * large amounts of data are to be hashed which only differ in the last few bytes. out is reset first, but its md_data
+ * buffer is reused if it was allocated for the same digest. The public key context of in, if any, is duplicated
+ * (sharing its EVP_PKEY). Return values: Returns 1 for success and 0 for failure, in which case out is unchanged.
+ */
+int EVP_MD_CTX_copy_ex(EVP_MD_CTX *out, const EVP_MD_CTX *in)
+    __CPROVER_requires(__CPROVER_rw_ok(out, sizeof(*out)) && out != in)
+    __CPROVER_requires(out->md_data == NULL || out->digest != NULL)
+    __CPROVER_requires(EVP_MD_CTX_PCTX_IS_VALID(out->pctx))
+    __CPROVER_requires(
+        in == NULL || in->digest == NULL ||
+        (evp_md_is_valid(in->digest) && (in->md_data == NULL || __CPROVER_r_ok(in->md_data, in->digest->md_size)) &&
+         EVP_MD_CTX_PCTX_IS_VALID(in->pctx) &&
+         (in->pctx == NULL || in->pctx->pkey == NULL || in->pctx->pkey->references < MODEL_REFCOUNT_MAX)))
+    __CPROVER_assigns(
+        *out;
+        in != NULL && in->digest != NULL && in->pctx != NULL && in->pctx->pkey != NULL: in->pctx->pkey->references;
+        EVP_PKEY_CTX_RELEASE_ASSIGNS(in != NULL && in->digest != NULL, out->pctx))
+    __CPROVER_frees(
+        in != NULL && in->digest != NULL && out->md_data != NULL && (in->md_data == NULL || out->digest != in->digest):
+        out->md_data;
+        EVP_PKEY_CTX_FREES(in != NULL && in->digest != NULL, out->pctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || (in != NULL && in->digest != NULL))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (out->digest == in->digest && out->flags == in->flags && out->bytes_absorbed == in->bytes_absorbed &&
+         out->is_finalized == in->is_finalized && EVP_MD_CTX_SAME_FINGERPRINT(out, in) &&
+         IFF(out->md_data == NULL, in->md_data == NULL) &&
+         (in->pctx == NULL ? out->pctx == NULL : out->pctx != NULL && out->pctx->pkey == in->pctx->pkey)))
+{
+    assert(out != NULL);
+    if (in == NULL || in->digest == NULL) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_DIGEST)) return 0;
+
+    /* Everything that can fail happens before out is modified. */
+    void *md_data = NULL;
+    if (in->md_data != NULL) {
+        md_data = (out->md_data != NULL && out->digest == in->digest) ? out->md_data
+                                                                      : model_malloc(in->digest->md_size);
+        if (md_data == NULL) return 0;
+    }
+    EVP_PKEY_CTX *pctx = NULL;
+    if (EVP_MD_CTX_PCTX(in) != NULL) {
+        pctx = model_malloc(sizeof(EVP_PKEY_CTX));
+        if (pctx == NULL) {
+            if (md_data != out->md_data) model_free(md_data);
+            return 0;
+        }
+        *pctx = *in->pctx;
+        if (pctx->pkey != NULL) refcount_acquire(&pctx->pkey->references);
+    }
+
+    if (md_data != out->md_data) model_free(out->md_data);
+    if (md_data != NULL) memcpy(md_data, in->md_data, in->digest->md_size);
+    evp_md_ctx_free_pctx(out);
+    out->md_data        = md_data;
+    out->pctx           = pctx;
+    out->digest         = in->digest;
+    out->flags          = in->flags;
+    out->bytes_absorbed = in->bytes_absorbed;
+    out->is_finalized   = in->is_finalized;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    out->fingerprint = in->fingerprint;
+#endif
+    return 1;
+}
+
+/* CBMC helper functions */
+
+bool evp_md_is_valid(EVP_MD *md) {
+    return md && 0 <= md->from && md->from < EVP_MD_TABLE_SIZE && md->md_size == evp_md_table[md->from].md_size;
+}
+
+/* Helper function for CBMC proofs: allocates EVP_MD_CTX nondeterministically. */
+EVP_MD_CTX *evp_md_ctx_nondet_alloc() {
+    return evp_md_ctx_pool_alloc();
+}
+
+/*
+ * Helper function for CBMC proofs: allocates an EVP_MD_CTX that satisfies evp_md_ctx_is_valid() by construction, for
+ * any digest of the model and in any state of the digest operation, or returns NULL when the allocation fails. With
+ * depth > 0 the context may carry a public key context generated with depth - 1 and shared_pkey.
+ */
+EVP_MD_CTX *evp_md_ctx_nondet_valid_alloc(int depth, EVP_PKEY *shared_pkey) {
+    EVP_MD_CTX *ctx = evp_md_ctx_pool_alloc();
+    if (ctx == NULL) return NULL;
+
+    size_t digest = nondet_size_t();
+    __CPROVER_assume(digest < EVP_MD_TABLE_SIZE);
+    ctx->digest  = &evp_md_table[digest];
+    ctx->md_data = nondet_bool() ? model_malloc(ctx->digest->md_size) : NULL;
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    assert(shared_pkey == NULL);
+    ctx->pctx = NULL;
+#else
+    ctx->pctx = (depth > 0 && nondet_bool()) ? evp_pkey_ctx_nondet_valid_alloc(depth - 1, shared_pkey) : NULL;
+#endif
+    return ctx;
+}
+
+/* Helper function for CBMC proofs: checks if EVP_MD_CTX is initialized. */
+bool evp_md_ctx_is_initialized(EVP_MD_CTX *ctx) {
+    return (ctx->digest != NULL);
+}
+
+/* Helper function for CBMC proofs: returns digest size. */
+size_t evp_md_ctx_get_digest_size(EVP_MD_CTX *ctx) {
+    return ctx->digest->ctx_size;
+}
+
+/* Helper function for CBMC proofs: get EVP_PKEY without incrementing the reference count. */
+EVP_PKEY *evp_md_ctx_get0_evp_pkey(EVP_MD_CTX *ctx) {
+    return ctx && EVP_MD_CTX_PCTX(ctx) ? ctx->pctx->pkey : NULL;
+}
+
+/* Helper function for CBMC proofs: set EVP_PKEY without incrementing the reference count. */
+void evp_md_ctx_set0_evp_pkey(EVP_MD_CTX *ctx, EVP_PKEY *pkey) {
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    assert(pkey == NULL);
+#else
+    if (ctx) ctx->pctx->pkey = pkey;
+#endif
+}
+
+/* Helper function for CBMC proofs: frees the memory of the ctx without freeing the EVP_PKEY. */
+void evp_md_ctx_shallow_free(EVP_MD_CTX *ctx) {
+    evp_md_ctx_pool_free(ctx);
+    // Does not free EVP_KEY, since this is always done separately in our use cases
+}
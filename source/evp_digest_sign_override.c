@@ -0,0 +1,229 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <call_count_utils.h>
+#include <evp_utils.h>
+#include <openssl/evp.h>
+
+#include <assert.h>
+
+/*
+ * Digest signing and verification: an EVP_MD_CTX that carries a public key context of an EVP_PKEY. Kept apart from
+ * evp_digest_override.c so that proofs which only digest do not link the EVP_PKEY family (see
+ * LIBCRYPTO_MODEL_MD_CTX_NO_PKEY in model_config.h).
+ */
+
+/*
+ * Common part of EVP_DigestSignInit() and EVP_DigestVerifyInit(): starts a digest of type on ctx and attaches a new
+ * public key context of pkey, initialized for operation, in place of the previous one. On failure ctx is left without
+ * a public key context.
+ */
+static int evp_digest_sigver_init(
+    EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx, const EVP_MD *type, EVP_PKEY *pkey, enum evp_pkey_ctx_operation operation) {
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    __CPROVER_assert(0, "public key contexts of digests are not supported in this configuration");
+    return 0;
+#else
+    /* Referencing pkey first keeps it alive if the previous public key context held its last reference. */
+    EVP_PKEY_CTX *pkey_ctx = EVP_PKEY_CTX_new(pkey, NULL);
+    EVP_PKEY_CTX_free(ctx->pctx);
+    ctx->pctx = NULL;
+
+    if (pkey_ctx == NULL || evp_pkey_ctx_start_operation(pkey_ctx, operation) != 1 ||
+        EVP_DigestInit_ex(ctx, type, NULL) != 1) {
+        EVP_PKEY_CTX_free(pkey_ctx);
+        return 0;
+    }
+
+    ctx->pctx = pkey_ctx;
+    if (pctx != NULL) *pctx = pkey_ctx;
+    return 1;
+#endif
+}
+
+/*
+ * Description: EVP_DigestSignInit() sets up signing context ctx to use digest type from ENGINE e and private key pkey.
+ * ctx must be created with EVP_MD_CTX_new() before calling this function. If pctx is not NULL, the EVP_PKEY_CTX of the
+ * signing operation will be written to *pctx: this can be used to set alternative signing options. The EVP_PKEY_CTX
+ * value returned must not be freed directly by the application, it is freed automatically when the EVP_MD_CTX is
+ * freed. The model replaces (and releases) any EVP_PKEY_CTX previously attached to ctx.
+ * Return values: EVP_DigestSignInit() EVP_DigestSignUpdate() return 1 for success and 0 for failure.
+ */
+int EVP_DigestSignInit(EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx, const EVP_MD *type, ENGINE *e, EVP_PKEY *pkey)
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    __CPROVER_requires(false) /* Public key contexts of digests are not supported in this configuration. */
+#endif
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->md_data == NULL || ctx->digest != NULL) /* md_data is only ever set along with digest. */
+    __CPROVER_requires(ctx->pctx == NULL || evp_pkey_ctx_is_valid(ctx->pctx))
+    __CPROVER_requires(pctx == NULL || __CPROVER_w_ok(pctx, sizeof(*pctx)))
+    __CPROVER_requires(evp_md_is_valid(type) && e == NULL)
+    __CPROVER_requires(evp_pkey_is_valid(pkey) && pkey->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_assigns(
+        ctx->digest, ctx->md_data, ctx->pctx, EVP_MD_CTX_ABSORB_ASSIGNS(ctx), ctx->is_finalized, pkey->references;
+        EVP_PKEY_CTX_RELEASE_ASSIGNS(true, ctx->pctx); pctx != NULL: *pctx)
+    __CPROVER_frees(ctx->md_data != NULL && ctx->digest != type: ctx->md_data; EVP_PKEY_CTX_FREES(true, ctx->pctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 1 || ctx->pctx == NULL)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (__CPROVER_is_fresh(ctx->pctx, sizeof(EVP_PKEY_CTX)) && ctx->pctx->pkey == pkey &&
+         ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_SIGN && (pctx == NULL || *pctx == ctx->pctx)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (ctx->digest == type && ctx->bytes_absorbed == 0 && !ctx->is_finalized))
+{
+    assert(ctx != NULL);
+    assert(evp_md_is_valid(type));
+    assert(!e);  // Assuming that this function is always called in ESDK with e == NULL
+    assert(evp_pkey_is_valid(pkey));
+
+    return evp_digest_sigver_init(ctx, pctx, type, pkey, EVP_PKEY_CTX_OPERATION_SIGN);
+}
+
+/*
+ * Description: EVP_DigestSignFinal() signs the data in ctx and places the signature in sig. If sig is NULL then the
+ * maximum size of the output buffer is written to siglen. If sig is not NULL then before the call siglen should
+ * contain the length of the sig buffer. If the call is successful the signature is written to sig and the amount of
+ * data written to siglen. As in OpenSSL, the digest is finalized on a copy of ctx, so more data can be signed with
+ * further calls to EVP_DigestSignUpdate().
+ * Return values: EVP_DigestSignFinal() returns 1 for success and 0 or a negative value for failure.
+ */
+int EVP_DigestSignFinal(EVP_MD_CTX *ctx, unsigned char *sig, size_t *siglen)
+    __CPROVER_requires(evp_md_ctx_is_valid(ctx) && !ctx->is_finalized)
+    __CPROVER_requires(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_SIGN)
+    __CPROVER_requires(__CPROVER_rw_ok(siglen, sizeof(*siglen)))
+    __CPROVER_requires(EVP_PKEY_SIGNATURE_BUFFER_IS_VALID(ctx->pctx, sig, siglen))
+    __CPROVER_requires(sig == NULL || __CPROVER_w_ok(sig, *siglen))
+    __CPROVER_assigns(*siglen, SIZE_BOUND_ASSIGNS(SIGNATURE_SIZE_BOUND); sig != NULL: UNCONSTRAINED_DATA(sig, *siglen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(SIGNATURE_SIZE_BOUND))
+    __CPROVER_ensures(__CPROVER_return_value != 1 || EVP_PKEY_SIGNATURE_SIZE_IS_VALID(ctx->pctx, sig, siglen))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *siglen == __CPROVER_old(*siglen))
+{
+    assert(evp_md_ctx_is_valid(ctx));
+    assert(!ctx->is_finalized);
+    assert(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_SIGN);
+
+    /* The signature is unconstrained, so the value of the digest does not matter: only its size is passed on. */
+    unsigned char md[EVP_MAX_MD_SIZE];
+    return EVP_PKEY_sign(ctx->pctx, sig, siglen, md, ctx->digest->md_size);
+}
+
+/*
+ * Description: EVP_DigestSign() signs tbslen bytes of data at tbs and places the signature in sigret and its length
+ * in siglen in a similar way to EVP_DigestSignFinal(). If sigret is NULL, only the signature size is written to siglen
+ * and no data is absorbed.
+ * Return values: EVP_DigestSign() returns 1 for success and 0 or a negative value for failure.
+ */
+int EVP_DigestSign(EVP_MD_CTX *ctx, unsigned char *sigret, size_t *siglen, const unsigned char *tbs, size_t tbslen)
+    __CPROVER_requires(evp_md_ctx_is_valid(ctx) && !ctx->is_finalized)
+    __CPROVER_requires(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_SIGN)
+    __CPROVER_requires(__CPROVER_rw_ok(siglen, sizeof(*siglen)))
+    __CPROVER_requires(EVP_PKEY_SIGNATURE_BUFFER_IS_VALID(ctx->pctx, sigret, siglen))
+    __CPROVER_requires(sigret == NULL || __CPROVER_w_ok(sigret, *siglen))
+    __CPROVER_requires(tbslen == 0 || __CPROVER_r_ok(tbs, tbslen))
+    __CPROVER_assigns(
+        EVP_MD_CTX_ABSORB_ASSIGNS(ctx), *siglen, SIZE_BOUND_ASSIGNS(SIGNATURE_SIZE_BOUND);
+        sigret != NULL: UNCONSTRAINED_DATA(sigret, *siglen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(SIGNATURE_SIZE_BOUND))
+    __CPROVER_ensures(__CPROVER_return_value != 1 || EVP_PKEY_SIGNATURE_SIZE_IS_VALID(ctx->pctx, sigret, siglen))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *siglen == __CPROVER_old(*siglen))
+{
+    if (sigret != NULL && EVP_DigestSignUpdate(ctx, tbs, tbslen) <= 0) return 0;
+    return EVP_DigestSignFinal(ctx, sigret, siglen);
+}
+
+/*
+ * Description: EVP_DigestVerifyInit() sets up verification context ctx to use digest type from ENGINE e and public key
+ * pkey. ctx must be created with EVP_MD_CTX_new() before calling this function. If pctx is not NULL, the EVP_PKEY_CTX
+ * of the verification operation will be written to *pctx: this can be used to set alternative verification options.
+ * Note that any existing value in *pctx is overwritten. The EVP_PKEY_CTX value returned must not be freed directly by
+ * the application if ctx is not assigned an EVP_PKEY_CTX value before being passed to EVP_DigestVerifyInit() (which
+ * means the EVP_PKEY_CTX is created inside EVP_DigestVerifyInit() and it will be freed automatically when the
+ * EVP_MD_CTX is freed). The model replaces (and releases) any EVP_PKEY_CTX previously attached to ctx.
+ * Return values: EVP_DigestVerifyInit() EVP_DigestVerifyUpdate() return 1 for success and 0 for
+ * failure.
+ */
+int EVP_DigestVerifyInit(EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx, const EVP_MD *type, ENGINE *e, EVP_PKEY *pkey)
+#ifdef LIBCRYPTO_MODEL_MD_CTX_NO_PKEY
+    __CPROVER_requires(false) /* Public key contexts of digests are not supported in this configuration. */
+#endif
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->md_data == NULL || ctx->digest != NULL) /* md_data is only ever set along with digest. */
+    __CPROVER_requires(ctx->pctx == NULL || evp_pkey_ctx_is_valid(ctx->pctx))
+    __CPROVER_requires(pctx == NULL || __CPROVER_w_ok(pctx, sizeof(*pctx)))
+    __CPROVER_requires(evp_md_is_valid(type) && e == NULL)
+    __CPROVER_requires(evp_pkey_is_valid(pkey) && pkey->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_assigns(
+        ctx->digest, ctx->md_data, ctx->pctx, EVP_MD_CTX_ABSORB_ASSIGNS(ctx), ctx->is_finalized, pkey->references;
+        EVP_PKEY_CTX_RELEASE_ASSIGNS(true, ctx->pctx); pctx != NULL: *pctx)
+    __CPROVER_frees(ctx->md_data != NULL && ctx->digest != type: ctx->md_data; EVP_PKEY_CTX_FREES(true, ctx->pctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 1 || ctx->pctx == NULL)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (__CPROVER_is_fresh(ctx->pctx, sizeof(EVP_PKEY_CTX)) && ctx->pctx->pkey == pkey &&
+         ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_VERIFY && (pctx == NULL || *pctx == ctx->pctx)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (ctx->digest == type && ctx->bytes_absorbed == 0 && !ctx->is_finalized))
+{
+    assert(ctx != NULL);
+    assert(evp_md_is_valid(type));
+    assert(!e);  // Assuming that this function is always called in ESDK with e == NULL
+    assert(evp_pkey_is_valid(pkey));
+
+    return evp_digest_sigver_init(ctx, pctx, type, pkey, EVP_PKEY_CTX_OPERATION_VERIFY);
+}
+
+/*
+ * Description: EVP_DigestVerifyFinal() verifies the data in ctx against the signature in sig of length siglen.
+ * Return values: EVP_DigestVerifyFinal() and EVP_DigestVerify() return 1 for success; any other value indicates
+ * failure. A return value of zero indicates that the signature did not verify successfully (that is, tbs did not match
+ * the original data or the signature had an invalid form), while other values indicate a more serious error (and
+ * sometimes also indicate an invalid signature form).
+ */
+int EVP_DigestVerifyFinal(EVP_MD_CTX *ctx, const unsigned char *sig, size_t siglen)
+    __CPROVER_requires(evp_md_ctx_is_valid(ctx) && !ctx->is_finalized)
+    __CPROVER_requires(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_VERIFY)
+    __CPROVER_requires(sig != NULL && __CPROVER_r_ok(sig, siglen))
+    __CPROVER_assigns()
+{
+    assert(evp_md_ctx_is_valid(ctx));
+    assert(!ctx->is_finalized);
+    assert(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_VERIFY);
+    assert(sig);
+    assert(__CPROVER_r_ok(sig, siglen));
+    COUNT_CALL(MODEL_CALL_EVP_DIGEST_VERIFY_FINAL, siglen);
+
+    // Since this operation only performs verification, none of the arguments are modified
+
+    return nondet_int();
+}
+
+/*
+ * Description: EVP_DigestVerify() verifies tbslen bytes at tbs against the signature in sig of length siglen.
+ * Return values: see EVP_DigestVerifyFinal(). A failure to absorb tbs is reported as -1.
+ */
+int EVP_DigestVerify(EVP_MD_CTX *ctx, const unsigned char *sig, size_t siglen, const unsigned char *tbs, size_t tbslen)
+    __CPROVER_requires(evp_md_ctx_is_valid(ctx) && !ctx->is_finalized)
+    __CPROVER_requires(ctx->pctx != NULL && ctx->pctx->operation == EVP_PKEY_CTX_OPERATION_VERIFY)
+    __CPROVER_requires(sig != NULL && __CPROVER_r_ok(sig, siglen))
+    __CPROVER_requires(tbslen == 0 || __CPROVER_r_ok(tbs, tbslen))
+    __CPROVER_assigns(EVP_MD_CTX_ABSORB_ASSIGNS(ctx))
+{
+    if (EVP_DigestVerifyUpdate(ctx, tbs, tbslen) <= 0) return -1;
+    return EVP_DigestVerifyFinal(ctx, sig, siglen);
+}
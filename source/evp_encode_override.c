@@ -0,0 +1,392 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <evp_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <openssl/evp.h>
+
+#include <assert.h>
+#include <limits.h>
+
+#define EVP_ENCODE_LENGTH 48      // Input bytes per line of base64 output.
+#define EVP_ENCODE_LINE_SIZE 65   // 64 base64 characters and a newline.
+#define EVP_DECODE_GROUP_SIZE 64  // Base64 characters buffered by EVP_DecodeUpdate() before decoding them.
+
+/*
+ * Base64 encoding and decoding. Like OpenSSL, the streaming encoder emits lines of EVP_ENCODE_LENGTH input bytes, i.e.
+ * 64 base64 characters and a newline, and the streaming decoder decodes its input in groups of up to
+ * EVP_DECODE_GROUP_SIZE characters. Output lengths are exact; the values of the written bytes are unconstrained.
+ */
+
+/* Base64 characters encoding n bytes: 4 for every started group of 3 bytes. */
+#define EVP_ENCODED_LENGTH(n) ((size_t)(n) / 3 * 4 + ((n) % 3 != 0 ? 4 : 0))
+
+/* Bytes that EVP_DecodeBlock() writes for n base64 characters: 3 for every group of 4. */
+#define EVP_DECODED_LENGTH(n) ((size_t)(n) / 4 * 3)
+
+/* Length of the complete lines that EVP_EncodeUpdate() outputs with num bytes buffered and inl more, NUL excluded. */
+#define EVP_ENCODE_UPDATE_SIZE(num, inl) \
+    ((inl) <= 0 ? 0 : ((size_t)(num) + (size_t)(inl)) / EVP_ENCODE_LENGTH * EVP_ENCODE_LINE_SIZE)
+
+/* Length of the last line that EVP_EncodeFinal() outputs with num bytes buffered, newline included, NUL excluded. */
+#define EVP_ENCODE_FINAL_SIZE(num) ((num) == 0 ? 0 : EVP_ENCODED_LENGTH(num) + 1)
+
+/* Upper bound of the bytes that EVP_DecodeUpdate() writes with num characters buffered and inl more. */
+#define EVP_DECODE_UPDATE_MAX_SIZE(num, inl) EVP_DECODED_LENGTH((size_t)(num) + (size_t)(inl))
+
+/**
+ * https://docs.openssl.org/master/man3/EVP_EncodeInit/#description
+ *
+ * EVP_DecodeBlock() will decode the block of n characters of base64 data contained
+ * in f and store the result in t.
+ */
+int EVP_DecodeBlock(unsigned char *t, const unsigned char *f, int n)
+    __CPROVER_requires(n == 0 || (n % 4 == 0 && __CPROVER_r_ok(f, n) && __CPROVER_w_ok(t, EVP_DECODED_LENGTH(n))))
+    __CPROVER_assigns(n != 0: UNCONSTRAINED_DATA(t, EVP_DECODED_LENGTH(n)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == (n == 0 ? 0 : __CPROVER_return_value == -1 ? -1 : (int)EVP_DECODED_LENGTH(n)))
+{
+    if (n == 0) {
+        return 0;
+    }
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_ENCODE)) {
+        return -1;
+    }
+
+    /* > its length MUST be divisible by 4 */
+    assert(n % 4 == 0);
+
+    assert(__CPROVER_r_ok(f, n));
+
+    /* > For every 4 input bytes exactly 3 output bytes will be produced */
+    int written_length = n / 4 * 3;
+    assert(__CPROVER_w_ok(t, written_length));
+    write_unconstrained_data(t, written_length);
+
+    /* > EVP_DecodeBlock() will return the length of the data decoded or -1 on error */
+    return written_length;
+}
+
+/**
+ * https://docs.openssl.org/master/man3/EVP_EncodeInit/#description
+ *
+ * EVP_EncodeBlock() encodes a full block of input data in f and of length n and
+ * stores it in t.
+ */
+int EVP_EncodeBlock(unsigned char *t, const unsigned char *f, int n)
+    __CPROVER_requires(n >= 0 && EVP_ENCODED_LENGTH(n) < INT_MAX)
+    __CPROVER_requires(__CPROVER_w_ok(t, 1))
+    __CPROVER_requires(n == 0 || (__CPROVER_r_ok(f, n) && __CPROVER_w_ok(t, EVP_ENCODED_LENGTH(n) + 1)))
+    __CPROVER_assigns(UNCONSTRAINED_DATA(t, EVP_ENCODED_LENGTH(n) + 1))
+    __CPROVER_ensures(
+        __CPROVER_return_value == (n == 0 ? 0 : __CPROVER_return_value == -1 ? -1 : (int)EVP_ENCODED_LENGTH(n)))
+    __CPROVER_ensures(__CPROVER_return_value == -1 || t[__CPROVER_return_value] == '\0')
+{
+    /* even if no data is passed in, should be able to write null terminator */
+    assert(__CPROVER_w_ok(t, 1));
+    if (n == 0) {
+        t[0] = '\0';
+        return 0;
+    }
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_ENCODE)) {
+        return -1;
+    }
+
+    assert(__CPROVER_r_ok(f, n));
+
+    /* > For every 3 bytes of input provided 4 bytes of output data will be produced. */
+    int written_length = n / 3 * 4;
+    /* > If n is not divisible by 3 then the block is encoded as a final block of
+     * > data and the output is padded such that it is always divisible by 4 */
+    written_length += (n % 3 != 0) ? 4 : 0;
+    /* > Additionally a NUL terminator character will be added. */
+    written_length += 1;
+    assert(__CPROVER_w_ok(t, written_length));
+    write_unconstrained_data(t, written_length - 1);
+    t[written_length - 1] = '\0';
+    /* > The length of the data generated without the NUL terminator is returned
+     * > from the function. */
+    return written_length - 1;
+}
+
+/*
+ * EVP_ENCODE_CTX_new() allocates, initializes and returns a context to be used for the encode/decode functions.
+ */
+EVP_ENCODE_CTX *EVP_ENCODE_CTX_new(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_ENCODE_CTX)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL || (__CPROVER_return_value->num == 0 && __CPROVER_return_value->eof == 0))
+{
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_ENCODE)) return NULL;
+    EVP_ENCODE_CTX *ctx = model_malloc(sizeof(EVP_ENCODE_CTX));
+    if (ctx != NULL) {
+        ctx->num = 0;
+        ctx->eof = 0;
+    }
+    return ctx;
+}
+
+/*
+ * EVP_ENCODE_CTX_free() cleans up an encode/decode context ctx and frees up the space allocated to it.
+ */
+void EVP_ENCODE_CTX_free(EVP_ENCODE_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns()
+    __CPROVER_frees(ctx)
+{
+    model_free(ctx);
+}
+
+/*
+ * EVP_ENCODE_CTX_num() will return the number of as yet unprocessed bytes still to be encoded or decoded that are
+ * pending in the ctx object.
+ */
+int EVP_ENCODE_CTX_num(EVP_ENCODE_CTX *ctx)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == ctx->num)
+{
+    return ctx->num;
+}
+
+/*
+ * EVP_EncodeInit() initialises ctx for the start of a new encoding operation.
+ */
+void EVP_EncodeInit(EVP_ENCODE_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(*ctx)
+    __CPROVER_ensures(ctx->num == 0 && ctx->eof == 0)
+{
+    ctx->num = 0;
+    ctx->eof = 0;
+}
+
+/*
+ * EVP_EncodeUpdate() encodes inl bytes of data found in the buffer pointed to by in. The output is stored in the
+ * buffer out and the number of bytes output is stored in *outl. The encoded data is output in blocks of 64 characters
+ * (plus a newline); any remainder of less than EVP_ENCODE_LENGTH input bytes is held in ctx for a later call. A NUL
+ * terminator follows the output whenever there is any. Returns 1 on success, or 0 when inl is not positive.
+ */
+int EVP_EncodeUpdate(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && evp_encode_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(outl, sizeof(*outl)))
+    __CPROVER_requires(inl <= 0 || __CPROVER_r_ok(in, inl))
+    __CPROVER_requires(EVP_ENCODE_UPDATE_SIZE(ctx->num, inl) < INT_MAX)
+    __CPROVER_requires(
+        EVP_ENCODE_UPDATE_SIZE(ctx->num, inl) == 0 || __CPROVER_w_ok(out, EVP_ENCODE_UPDATE_SIZE(ctx->num, inl) + 1))
+    __CPROVER_assigns(*outl; inl > 0: ctx->num; EVP_ENCODE_UPDATE_SIZE(ctx->num, inl) != 0:
+        UNCONSTRAINED_DATA(out, EVP_ENCODE_UPDATE_SIZE(ctx->num, inl) + 1))
+    __CPROVER_ensures(__CPROVER_return_value == (inl > 0))
+    __CPROVER_ensures(*outl == EVP_ENCODE_UPDATE_SIZE(__CPROVER_old(ctx->num), inl))
+    __CPROVER_ensures(
+        inl <= 0 || ctx->num == ((size_t)__CPROVER_old(ctx->num) + (size_t)inl) % EVP_ENCODE_LENGTH)
+    __CPROVER_ensures(*outl == 0 || out[*outl] == '\0')
+    __CPROVER_ensures(evp_encode_ctx_is_valid(ctx))
+{
+    assert(evp_encode_ctx_is_valid(ctx));
+    *outl = 0;
+    if (inl <= 0) return 0;
+    assert(__CPROVER_r_ok(in, inl));
+
+    size_t buffered = (size_t)ctx->num + (size_t)inl;
+    size_t total    = buffered / EVP_ENCODE_LENGTH * EVP_ENCODE_LINE_SIZE;
+    assert(total < INT_MAX);
+    if (total != 0) {
+        assert(__CPROVER_w_ok(out, total + 1));
+        write_unconstrained_data(out, total);
+        out[total] = '\0';
+    }
+    ctx->num = buffered % EVP_ENCODE_LENGTH;
+    *outl    = total;
+    return 1;
+}
+
+/*
+ * EVP_EncodeFinal() must be called at the end of an encoding operation. It will process any partial block of data
+ * remaining in the ctx object. The output data will be stored in out, followed by a newline and a NUL terminator, and
+ * the length of the data written (newline included, NUL excluded) will be stored in *outl.
+ */
+void EVP_EncodeFinal(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && evp_encode_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(outl, sizeof(*outl)))
+    __CPROVER_requires(ctx->num == 0 || __CPROVER_w_ok(out, EVP_ENCODE_FINAL_SIZE(ctx->num) + 1))
+    __CPROVER_assigns(ctx->num, *outl; ctx->num != 0: UNCONSTRAINED_DATA(out, EVP_ENCODE_FINAL_SIZE(ctx->num) + 1))
+    __CPROVER_ensures(ctx->num == 0)
+    __CPROVER_ensures(*outl == EVP_ENCODE_FINAL_SIZE(__CPROVER_old(ctx->num)))
+    __CPROVER_ensures(*outl == 0 || out[*outl] == '\0')
+{
+    assert(evp_encode_ctx_is_valid(ctx));
+    size_t written = EVP_ENCODE_FINAL_SIZE(ctx->num);
+    if (written != 0) {
+        assert(__CPROVER_w_ok(out, written + 1));
+        write_unconstrained_data(out, written - 1);
+        out[written - 1] = '\n';
+        out[written]     = '\0';
+    }
+    ctx->num = 0;
+    *outl    = written;
+}
+
+/*
+ * EVP_DecodeInit() initialises ctx for the start of a new decoding operation.
+ */
+void EVP_DecodeInit(EVP_ENCODE_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(*ctx)
+    __CPROVER_ensures(ctx->num == 0 && ctx->eof == 0)
+{
+    ctx->num = 0;
+    ctx->eof = 0;
+}
+
+/* Classes of input characters of the base64 decoder, after the conversion table of OpenSSL's crypto/evp/encode.c. */
+enum evp_base64_class { EVP_BASE64_DATA, EVP_BASE64_PAD, EVP_BASE64_WS, EVP_BASE64_EOF, EVP_BASE64_ERROR };
+
+static enum evp_base64_class evp_base64_classify(unsigned char c) {
+    if (('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z') || ('0' <= c && c <= '9') || c == '+' || c == '/') {
+        return EVP_BASE64_DATA;
+    }
+    if (c == '=') return EVP_BASE64_PAD;
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') return EVP_BASE64_WS;
+    if (c == '-') return EVP_BASE64_EOF;
+    return EVP_BASE64_ERROR;
+}
+
+/*
+ * EVP_DecodeUpdate() decodes inl characters of data found in the buffer pointed to by in. The output is stored in the
+ * buffer out and the number of bytes output is stored in *outl. Whitespace, newline and carriage return characters are
+ * ignored, a '-' ends the data, and any other character that is not base64 is an error. Decoded padding bytes ('='
+ * characters) are not counted in *outl.
+ * Returns -1 on error, 0 if the last byte decoded was the end of the data (a '-' or padding) and 1 otherwise.
+ *
+ * The body follows the algorithm of OpenSSL 1.1.1, so the returned value and the output length are exact functions of
+ * the classes of the input characters; only the decoded values are unconstrained.
+ */
+int EVP_DecodeUpdate(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl, const unsigned char *in, int inl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && evp_decode_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(outl, sizeof(*outl)))
+    __CPROVER_requires(inl >= 0 && __CPROVER_r_ok(in, inl))
+    __CPROVER_requires(
+        EVP_DECODE_UPDATE_MAX_SIZE(ctx->num, inl) == 0 ||
+        __CPROVER_w_ok(out, EVP_DECODE_UPDATE_MAX_SIZE(ctx->num, inl)))
+    __CPROVER_assigns(*outl, ctx->num, ctx->eof; EVP_DECODE_UPDATE_MAX_SIZE(ctx->num, inl) != 0:
+        UNCONSTRAINED_DATA(out, EVP_DECODE_UPDATE_MAX_SIZE(ctx->num, inl)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == -1 || __CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(0 <= *outl && *outl <= EVP_DECODE_UPDATE_MAX_SIZE(__CPROVER_old(ctx->num), inl))
+    __CPROVER_ensures(evp_decode_ctx_is_valid(ctx))
+{
+    assert(evp_decode_ctx_is_valid(ctx));
+    int n = ctx->num, eof = ctx->eof, pending_eof = ctx->eof, ret = 0;
+    bool seof = false, error = false;
+
+    if (inl == 0) {
+        *outl = 0;
+        return 0;
+    }
+    assert(__CPROVER_r_ok(in, inl));
+
+    for (int i = 0; i < inl && !seof && !error; i++) {
+        enum evp_base64_class c = evp_base64_classify(in[i]);
+        bool is_base64          = c == EVP_BASE64_DATA || c == EVP_BASE64_PAD;
+        if (c == EVP_BASE64_PAD) eof++;
+        if (c == EVP_BASE64_ERROR || eof > 2 || (c == EVP_BASE64_DATA && eof > 0)) {
+            /* Not base64, more than two padding characters, or more data after padding. */
+            error = true;
+        } else if (c == EVP_BASE64_EOF) {
+            seof = true;
+        } else if (is_base64) {
+            assert(n < EVP_DECODE_GROUP_SIZE);
+            n++;
+            if (c == EVP_BASE64_PAD) pending_eof++;
+            if (n == EVP_DECODE_GROUP_SIZE) {
+                int decoded = EVP_DECODED_LENGTH(n);
+                write_unconstrained_data(out + ret, decoded);
+                n           = 0;
+                pending_eof = 0;
+                ret += decoded - eof;
+            }
+        }
+    }
+
+    /* Decodes the last group of characters, as long as they are complete quads. */
+    if (!error && n > 0) {
+        if (n % 4 == 0) {
+            int decoded = EVP_DECODED_LENGTH(n);
+            write_unconstrained_data(out + ret, decoded);
+            n           = 0;
+            pending_eof = 0;
+            ret += decoded - eof;
+        } else if (seof) {
+            /* Incomplete quad before the end of the data. */
+            error = true;
+        }
+    }
+
+    ctx->num = n;
+    ctx->eof = pending_eof;
+    *outl    = ret;
+    if (error) return -1;
+    return seof || (n == 0 && eof) ? 0 : 1;
+}
+
+/*
+ * EVP_DecodeFinal() must be called at the end of a decoding operation. If there is any unprocessed data still in ctx
+ * then the input data must not have been a multiple of 4 and therefore an error has occurred. The function will return
+ * -1 in this case. Otherwise the function returns 1 on success. Like OpenSSL, complete quads still buffered are decoded
+ * to out, padding bytes included.
+ */
+int EVP_DecodeFinal(EVP_ENCODE_CTX *ctx, unsigned char *out, int *outl)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)) && evp_decode_ctx_is_valid(ctx))
+    __CPROVER_requires(__CPROVER_w_ok(outl, sizeof(*outl)))
+    __CPROVER_requires(ctx->num % 4 != 0 || ctx->num == 0 || __CPROVER_w_ok(out, EVP_DECODED_LENGTH(ctx->num)))
+    __CPROVER_assigns(*outl; ctx->num % 4 == 0: ctx->num, ctx->eof;
+        ctx->num % 4 == 0 && ctx->num != 0: UNCONSTRAINED_DATA(out, EVP_DECODED_LENGTH(ctx->num)))
+    __CPROVER_ensures(__CPROVER_return_value == (__CPROVER_old(ctx->num) % 4 == 0 ? 1 : -1))
+    __CPROVER_ensures(*outl == (__CPROVER_old(ctx->num) % 4 == 0 ? EVP_DECODED_LENGTH(__CPROVER_old(ctx->num)) : 0))
+    __CPROVER_ensures(__CPROVER_return_value == -1 || (ctx->num == 0 && ctx->eof == 0))
+{
+    assert(evp_decode_ctx_is_valid(ctx));
+    *outl = 0;
+    if (ctx->num % 4 != 0) return -1;
+    if (ctx->num != 0) {
+        int decoded = EVP_DECODED_LENGTH(ctx->num);
+        assert(__CPROVER_w_ok(out, decoded));
+        write_unconstrained_data(out, decoded);
+        *outl = decoded;
+    }
+    ctx->num = 0;
+    ctx->eof = 0;
+    return 1;
+}
+
+/* CBMC helper functions */
+
+/* Helper function for CBMC proofs: checks if EVP_ENCODE_CTX holds less than one line of input to encode. */
+bool evp_encode_ctx_is_valid(const EVP_ENCODE_CTX *ctx) {
+    return ctx && 0 <= ctx->num && ctx->num < EVP_ENCODE_LENGTH;
+}
+
+/*
+ * Helper function for CBMC proofs: checks if EVP_ENCODE_CTX holds less than one group of characters to decode, ending
+ * with at most two padding characters.
+ */
+bool evp_decode_ctx_is_valid(const EVP_ENCODE_CTX *ctx) {
+    return ctx && 0 <= ctx->num && ctx->num < EVP_DECODE_GROUP_SIZE && 0 <= ctx->eof && ctx->eof <= 2 &&
+           ctx->eof <= ctx->num;
+}
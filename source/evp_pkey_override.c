@@ -0,0 +1,813 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <call_count_utils.h>
+#include <evp_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/rsa.h>
+
+#include <assert.h>
+
+DEFINE_MODEL_POOL(EVP_PKEY, evp_pkey)
+
+/*
+ * Description: The EVP_PKEY_new() function allocates an empty EVP_PKEY structure which is used by OpenSSL to store
+ * public and private keys. The reference count is set to 1. Return values: EVP_PKEY_new() returns either the newly
+ * allocated EVP_PKEY structure or NULL if an error occurred.
+ */
+EVP_PKEY *EVP_PKEY_new()
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_PKEY)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->references == 1 && EVP_PKEY_EC_KEY(__CPROVER_return_value) == NULL))
+{
+    EVP_PKEY *pkey = evp_pkey_pool_alloc();
+
+    if (pkey) {
+        refcount_init(&pkey->references);
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+        pkey->ec_key = NULL;
+#endif
+    }
+
+    return pkey;
+}
+
+/*
+ * Description: EVP_PKEY_up_ref() increments the reference count of key.
+ * Return values: EVP_PKEY_up_ref() returns 1 for success and 0 for failure.
+ */
+int EVP_PKEY_up_ref(EVP_PKEY *pkey)
+    __CPROVER_requires(__CPROVER_rw_ok(pkey, sizeof(*pkey)))
+    __CPROVER_requires(refcount_is_live(pkey->references) && pkey->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_assigns(pkey->references)
+    __CPROVER_ensures(pkey->references == __CPROVER_old(pkey->references) + 1)
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+{
+    assert(pkey);
+
+    refcount_acquire(&pkey->references);
+    return 1;
+}
+
+/*
+ * Description: EVP_PKEY_get0_EC_KEY() also returns the referenced key in pkey or NULL if the key is not of the correct
+ * type but the reference count of the returned key is not incremented and so must not be freed up after use. Return
+ * value: EVP_PKEY_get0_EC_KEY() returns the referenced key or NULL if an error occurred.
+ */
+EC_KEY *EVP_PKEY_get0_EC_KEY(EVP_PKEY *pkey)
+#ifndef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    __CPROVER_requires(false) /* EC keys are not supported in this configuration. */
+#endif
+    __CPROVER_requires(__CPROVER_r_ok(pkey, sizeof(*pkey)))
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == EVP_PKEY_EC_KEY(pkey))
+{
+    assert(pkey);
+
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    // In our current model, an EVP_PKEY never holds an RSA key object, so any key is of type EC
+    return pkey->ec_key;
+#else
+    __CPROVER_assert(0, "EC keys are not supported in this configuration");
+    return NULL;
+#endif
+}
+
+/*
+ * Description: EVP_PKEY_set1_EC_KEY() sets the key referenced by pkey to key.
+ * Return values: EVP_PKEY_set1_EC_KEY() returns 1 for success or 0 for failure.
+ */
+int EVP_PKEY_set1_EC_KEY(EVP_PKEY *pkey, EC_KEY *key)
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    __CPROVER_requires(pkey == NULL || __CPROVER_rw_ok(pkey, sizeof(*pkey)))
+    __CPROVER_requires(key == NULL || (ec_key_is_valid(key) && key->references < MODEL_REFCOUNT_MAX))
+    __CPROVER_assigns(pkey != NULL && key != NULL: pkey->ec_key, key->references)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (pkey->ec_key == key && key->references == __CPROVER_old(key != NULL ? key->references : 0) + 1))
+#else
+    __CPROVER_requires(false) /* EC keys are not supported in this configuration. */
+    __CPROVER_assigns()
+#endif
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    if (pkey == NULL || key == NULL || inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        return 0;
+    }
+
+    EC_KEY_up_ref(key);
+    pkey->ec_key = key;
+
+    return 1;
+#else
+    __CPROVER_assert(0, "EC keys are not supported in this configuration");
+    return 0;
+#endif
+}
+
+/*
+ * Description: EVP_PKEY_free() decrements the reference count of key and, if the reference count is zero, frees it up.
+ * If key is NULL, nothing is done.
+ */
+void EVP_PKEY_free(EVP_PKEY *pkey)
+    __CPROVER_requires(pkey == NULL || __CPROVER_rw_ok(pkey, sizeof(*pkey)))
+    __CPROVER_assigns(EVP_PKEY_RELEASE_ASSIGNS(true, pkey))
+    __CPROVER_frees(EVP_PKEY_FREES(true, pkey))
+{
+    if (pkey != NULL && refcount_release(&pkey->references)) {
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+        EC_KEY_free(pkey->ec_key);
+#endif
+        evp_pkey_pool_free(pkey);
+    }
+}
+
+bool evp_pkey_is_valid(EVP_PKEY *pkey);
+
+/*
+ * Description: The EVP_PKEY_CTX_new() function allocates public key algorithm context using the algorithm specified in
+ * pkey and ENGINE e. Return values: EVP_PKEY_CTX_new() returns either the newly allocated EVP_PKEY_CTX structure of
+ * NULL if an error occurred.
+ */
+EVP_PKEY_CTX *EVP_PKEY_CTX_new(EVP_PKEY *pkey, ENGINE *e)
+    __CPROVER_requires(evp_pkey_is_valid(pkey) && pkey->references < MODEL_REFCOUNT_MAX)
+    __CPROVER_requires(e == NULL)
+    __CPROVER_assigns(pkey->references)
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_PKEY_CTX)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->id == EVP_PKEY_NONE && __CPROVER_return_value->pkey == pkey &&
+         __CPROVER_return_value->operation == EVP_PKEY_CTX_OPERATION_UNDEFINED))
+    __CPROVER_ensures(
+        pkey->references == __CPROVER_old(pkey->references) + (__CPROVER_return_value == NULL ? 0 : 1))
+{
+    assert(evp_pkey_is_valid(pkey));
+    assert(!e);  // Assuming is always called with e == NULL
+
+    EVP_PKEY_CTX *ctx = model_malloc(sizeof(EVP_PKEY_CTX));
+
+    if (ctx) {
+        ctx->id        = EVP_PKEY_NONE;
+        ctx->operation = EVP_PKEY_CTX_OPERATION_UNDEFINED;
+        ctx->pkey      = pkey;
+        ctx->hkdf      = (struct evp_pkey_hkdf_params){ 0 };
+        refcount_acquire(&pkey->references);
+    }
+
+    return ctx;
+}
+
+/*
+ * Description: The EVP_PKEY_CTX_new_id() function allocates public key algorithm
+ * context using the algorithm specified by id and ENGINE e. It is normally used when no EVP_PKEY structure is
+ * associated with the operations, for example during parameter generation of key generation for some algorithms. Return
+ * values: EVP_PKEY_CTX_new_id() returns either the newly allocated EVP_PKEY_CTX structure of NULL if an error occurred.
+ */
+EVP_PKEY_CTX *EVP_PKEY_CTX_new_id(int id, ENGINE *e)
+    __CPROVER_assigns()
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(EVP_PKEY_CTX)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->id == id && __CPROVER_return_value->pkey == NULL &&
+         __CPROVER_return_value->operation == EVP_PKEY_CTX_OPERATION_UNDEFINED))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->hkdf.md == NULL && __CPROVER_return_value->hkdf.salt_len == 0 &&
+         !__CPROVER_return_value->hkdf.is_key_set && __CPROVER_return_value->hkdf.info_len == 0 &&
+         __CPROVER_return_value->hkdf.mode == EVP_PKEY_HKDEF_MODE_EXTRACT_AND_EXPAND))
+{
+    // assert(!e);  // Assuming is always called with e == NULL
+
+    EVP_PKEY_CTX *ctx = model_malloc(sizeof(EVP_PKEY_CTX));
+
+    if (ctx) {
+        ctx->id        = id;
+        ctx->operation = EVP_PKEY_CTX_OPERATION_UNDEFINED;
+        ctx->pkey      = NULL;
+        ctx->hkdf      = (struct evp_pkey_hkdf_params){ 0 };
+    }
+
+    return ctx;
+}
+
+/*
+ * Common part of the EVP_PKEY_*_init() functions: (re)initializes ctx for the given operation, forgetting the previous
+ * one, and returns 1. On failure ctx is left uninitialized and a value <= 0 is returned.
+ */
+int evp_pkey_ctx_start_operation(EVP_PKEY_CTX *ctx, enum evp_pkey_ctx_operation operation) {
+    if (!inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        ctx->operation = operation;
+        return 1;
+    }
+
+    ctx->operation = EVP_PKEY_CTX_OPERATION_UNDEFINED;
+    int rv         = nondet_int();
+    __CPROVER_assume(rv <= 0);
+    return rv;
+}
+
+/* Description: The EVP_PKEY_derive_init() function initializes a public key algorithm context using key pkey
+ * for shared secret derivation. EVP_PKEY_derive_init() returns 1 for success and 0 or a negative
+ * value for failure. In particular a return value of -2 indicates the operation is not supported by the public key
+ * algorithm.
+ */
+int EVP_PKEY_derive_init(EVP_PKEY_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(ctx->operation)
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(
+        ctx->operation ==
+        (__CPROVER_return_value == 1 ? EVP_PKEY_CTX_OPERATION_DERIVE : EVP_PKEY_CTX_OPERATION_UNDEFINED))
+{
+    assert(ctx);
+    return evp_pkey_ctx_start_operation(ctx, EVP_PKEY_CTX_OPERATION_DERIVE);
+}
+
+/*
+ * Description: The EVP_PKEY_sign_init() function initializes a public key algorithm context using key pkey for a
+ * signing operation. Return values: EVP_PKEY_sign_init() and EVP_PKEY_sign() return 1 for success and 0 or a negative
+ * value for failure. In particular a return value of -2 indicates the operation is not supported by the public key
+ * algorithm.
+ */
+int EVP_PKEY_sign_init(EVP_PKEY_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->pkey != NULL)
+    __CPROVER_assigns(ctx->operation)
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(
+        ctx->operation ==
+        (__CPROVER_return_value == 1 ? EVP_PKEY_CTX_OPERATION_SIGN : EVP_PKEY_CTX_OPERATION_UNDEFINED))
+{
+    assert(ctx);
+    assert(ctx->pkey);
+
+    return evp_pkey_ctx_start_operation(ctx, EVP_PKEY_CTX_OPERATION_SIGN);
+}
+
+bool evp_pkey_ctx_is_valid(EVP_PKEY_CTX *);
+
+/*
+ * Description: The EVP_PKEY_sign() function performs a public key signing operation using ctx. The data to be signed is
+ * specified using the tbs and tbslen parameters. If sig is NULL then the maximum size of the output buffer is written
+ * to the siglen parameter. If sig is not NULL then before the call the siglen parameter should contain the length of
+ * the sig buffer, if the call is successful the signature is written to sig and the amount of data written to siglen.
+ * Return values: EVP_PKEY_sign_init() and EVP_PKEY_sign() return 1 for success and 0 or a negative value for failure.
+ * In particular a return value of -2 indicates the operation is not supported by the public key algorithm.
+ */
+int EVP_PKEY_sign(EVP_PKEY_CTX *ctx, unsigned char *sig, size_t *siglen, const unsigned char *tbs, size_t tbslen)
+    __CPROVER_requires(evp_pkey_ctx_is_valid(ctx) && ctx->operation == EVP_PKEY_CTX_OPERATION_SIGN)
+    __CPROVER_requires(__CPROVER_rw_ok(siglen, sizeof(*siglen)))
+    __CPROVER_requires(EVP_PKEY_SIGNATURE_BUFFER_IS_VALID(ctx, sig, siglen))
+    __CPROVER_requires(sig == NULL || __CPROVER_w_ok(sig, *siglen))
+    __CPROVER_requires(tbs != NULL && __CPROVER_r_ok(tbs, tbslen))
+    __CPROVER_assigns(*siglen, SIZE_BOUND_ASSIGNS(SIGNATURE_SIZE_BOUND); sig != NULL: UNCONSTRAINED_DATA(sig, *siglen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(SIGNATURE_SIZE_BOUND))
+    __CPROVER_ensures(__CPROVER_return_value != 1 || EVP_PKEY_SIGNATURE_SIZE_IS_VALID(ctx, sig, siglen))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *siglen == __CPROVER_old(*siglen))
+{
+    assert(evp_pkey_ctx_is_valid(ctx));
+    assert(ctx->operation == EVP_PKEY_CTX_OPERATION_SIGN);
+    assert(siglen);
+    assert(tbs);
+    assert(__CPROVER_r_ok(tbs, tbslen));
+    if (sig != NULL) COUNT_CALL(MODEL_CALL_EVP_PKEY_SIGN, tbslen);
+
+    // ECDSA signatures are at most ECDSA_size() bytes, which only depends on the curve. Other signature sizes are
+    // nondeterministic but fixed. See ec_override.c for details.
+    size_t max_required_size =
+        EVP_PKEY_HAS_EC_KEY(ctx->pkey) ? EVP_PKEY_ECDSA_SIZE(ctx->pkey) : max_signature_size();
+    assert(!sig || (*siglen >= max_required_size && __CPROVER_w_ok(sig, *siglen)));
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        int rv = nondet_int();
+        __CPROVER_assume(rv <= 0);
+        return rv;
+    }
+
+    if (!sig) {
+        *siglen = max_required_size;
+    } else {
+        size_t amount_of_data_written = nondet_size_t();
+        __CPROVER_assume(amount_of_data_written <= max_required_size);
+        write_unconstrained_data(sig, amount_of_data_written);
+        *siglen = amount_of_data_written;
+    }
+
+    return 1;
+}
+
+/*
+ * Applies an HKDF control command to the parameters of an EVP_PKEY_HKDF context, after pkey_hkdf_ctrl() in OpenSSL's
+ * crypto/kdf/hkdf.c (but see EVP_PKEY_derive() for how the parameters are used). Returns 1 for success, 0 for invalid
+ * arguments and -2 for commands that HKDF does not support.
+ */
+static int evp_pkey_hkdf_ctrl(struct evp_pkey_hkdf_params *hkdf, int cmd, int p1, void *p2) {
+    switch (cmd) {
+        case EVP_PKEY_CTRL_HKDF_MD:
+            if (p2 == NULL) return 0;
+            assert(evp_md_is_valid(p2));
+            hkdf->md = p2;
+            return 1;
+        case EVP_PKEY_CTRL_HKDF_MODE:
+            /* Not validated here: EVP_PKEY_derive() fails with an unknown mode. */
+            hkdf->mode = p1;
+            return 1;
+        case EVP_PKEY_CTRL_HKDF_SALT:
+            if (p1 == 0 || p2 == NULL) return 1;
+            if (p1 < 0) return 0;
+            assert(__CPROVER_r_ok(p2, p1));
+            hkdf->salt_len = p1;
+            return 1;
+        case EVP_PKEY_CTRL_HKDF_KEY:
+            if (p1 < 0 || p2 == NULL) return 0;
+            assert(__CPROVER_r_ok(p2, p1));
+            hkdf->is_key_set = true;
+            hkdf->key_len    = p1;
+            return 1;
+        case EVP_PKEY_CTRL_HKDF_INFO:
+            if (p1 == 0 || p2 == NULL) return 1;
+            if (p1 < 0 || (size_t)p1 > HKDF_MAXBUF - hkdf->info_len) return 0;
+            assert(__CPROVER_r_ok(p2, p1));
+            hkdf->info_len += p1;
+            return 1;
+        default:
+            return -2;
+    }
+}
+
+/*
+ * Description: The function EVP_PKEY_CTX_ctrl() sends a control operation to the context ctx.
+ * The key type used must match keytype if it is not -1. The parameter optype is a mask indicating which operations
+ * the control can be applied to. The control command is indicated in cmd and any additional arguments in p1 and p2.
+ * EVP_PKEY_CTX_ctrl() and its macros return a positive value for success and 0 or a negative value for failure.
+ * In particular a return value of -2 indicates the operation is not supported by the public key algorithm.
+ * The model records the parameters of EVP_PKEY_HKDF contexts (see kdf.h) and ignores the commands of other contexts.
+ */
+int EVP_PKEY_CTX_ctrl(EVP_PKEY_CTX *ctx, int keytype, int optype, int cmd, int p1, void *p2)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(keytype == -1)
+    __CPROVER_requires(
+        ctx->id != EVP_PKEY_HKDF || cmd != EVP_PKEY_CTRL_HKDF_MD || p2 == NULL || evp_md_is_valid((EVP_MD *)p2))
+    __CPROVER_requires(
+        ctx->id != EVP_PKEY_HKDF ||
+        (cmd != EVP_PKEY_CTRL_HKDF_SALT && cmd != EVP_PKEY_CTRL_HKDF_KEY && cmd != EVP_PKEY_CTRL_HKDF_INFO) ||
+        p1 <= 0 || p2 == NULL || __CPROVER_r_ok(p2, p1))
+    __CPROVER_requires(ctx->id != EVP_PKEY_HKDF || ctx->hkdf.info_len <= HKDF_MAXBUF)
+    __CPROVER_assigns(ctx->id == EVP_PKEY_HKDF: ctx->hkdf)
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(
+        ctx->id != EVP_PKEY_HKDF || __CPROVER_return_value == 1 ||
+        (ctx->hkdf.md == __CPROVER_old(ctx->hkdf.md) && ctx->hkdf.salt_len == __CPROVER_old(ctx->hkdf.salt_len) &&
+         ctx->hkdf.is_key_set == __CPROVER_old(ctx->hkdf.is_key_set) &&
+         ctx->hkdf.key_len == __CPROVER_old(ctx->hkdf.key_len) &&
+         ctx->hkdf.info_len == __CPROVER_old(ctx->hkdf.info_len) && ctx->hkdf.mode == __CPROVER_old(ctx->hkdf.mode)))
+    __CPROVER_ensures(
+        ctx->id != EVP_PKEY_HKDF || __CPROVER_return_value != 1 ||
+        (cmd == EVP_PKEY_CTRL_HKDF_MD ? ctx->hkdf.md == p2
+         : cmd == EVP_PKEY_CTRL_HKDF_MODE ? ctx->hkdf.mode == p1
+         : cmd == EVP_PKEY_CTRL_HKDF_SALT ? p1 == 0 || p2 == NULL || ctx->hkdf.salt_len == (size_t)p1
+         : cmd == EVP_PKEY_CTRL_HKDF_KEY  ? ctx->hkdf.is_key_set && ctx->hkdf.key_len == (size_t)p1
+         : cmd == EVP_PKEY_CTRL_HKDF_INFO
+             ? ctx->hkdf.info_len == __CPROVER_old(ctx->hkdf.info_len) + (p1 == 0 || p2 == NULL ? 0 : (size_t)p1)
+             : false))
+    __CPROVER_ensures(ctx->id != EVP_PKEY_HKDF || ctx->hkdf.info_len <= HKDF_MAXBUF)
+{
+    assert(ctx != NULL);
+    assert(keytype == -1);  // Is this ever false?
+    if (ctx->id == EVP_PKEY_HKDF) {
+        /* Controls only apply to a context initialized for one of the operations in optype. */
+        if (optype != -1 && !((optype & EVP_PKEY_OP_DERIVE) && ctx->operation == EVP_PKEY_CTX_OPERATION_DERIVE)) {
+            return -1;
+        }
+        if (inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) return 0;
+        return evp_pkey_hkdf_ctrl(&ctx->hkdf, cmd, p1, p2);
+    }
+    if (!inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        return 1;
+    }
+    int rv = nondet_int();
+    __CPROVER_assume(rv <= 0);
+    return rv;
+}
+
+/*
+ * HKDF derivation of EVP_PKEY_derive(), after pkey_hkdf_derive() in OpenSSL's crypto/kdf/hkdf.c. Extraction writes
+ * exactly one digest, expansion exactly the *keylen bytes requested, which is at most HKDF_MAX_BLOCKS digests.
+ */
+static int evp_pkey_hkdf_derive(const struct evp_pkey_hkdf_params *hkdf, unsigned char *key, size_t *keylen) {
+    if (hkdf->md == NULL || !hkdf->is_key_set) return 0;
+    size_t md_size = EVP_MD_size(hkdf->md);
+
+    switch (hkdf->mode) {
+        case EVP_PKEY_HKDEF_MODE_EXTRACT_ONLY:
+            if (key != NULL) {
+                assert(*keylen >= md_size); /* The pseudorandom key is always written in full. */
+                write_unconstrained_data(key, md_size);
+            }
+            *keylen = md_size;
+            return 1;
+        case EVP_PKEY_HKDEF_MODE_EXTRACT_AND_EXPAND:
+        case EVP_PKEY_HKDEF_MODE_EXPAND_ONLY:
+            /* The output length is chosen by the caller, so there is no maximum to query. */
+            if (key == NULL || *keylen > HKDF_MAX_BLOCKS * md_size) return 0;
+            write_unconstrained_data(key, *keylen);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Description: The EVP_PKEY_derive() derives a shared secret using ctx. If key is NULL then the maximum size of the
+ * output buffer is written to the keylen parameter. If key is not NULL then before the call the keylen parameter should
+ * contain the length of the key buffer, if the call is successful the shared secret is written to key and the amount of
+ * data written to keylen. The sizes of HKDF outputs follow from the parameters of ctx (see evp_pkey_hkdf_derive()),
+ * others from the derivation size bound.
+ */
+int EVP_PKEY_derive(EVP_PKEY_CTX *ctx, unsigned char *key, size_t *keylen)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)) && ctx->operation == EVP_PKEY_CTX_OPERATION_DERIVE)
+    __CPROVER_requires(ctx->id != EVP_PKEY_HKDF || ctx->hkdf.md == NULL || evp_md_is_valid((EVP_MD *)ctx->hkdf.md))
+    __CPROVER_requires(__CPROVER_rw_ok(keylen, sizeof(*keylen)))
+    __CPROVER_requires(key == NULL || __CPROVER_w_ok(key, *keylen))
+    __CPROVER_requires(
+        ctx->id != EVP_PKEY_HKDF || ctx->hkdf.mode != EVP_PKEY_HKDEF_MODE_EXTRACT_ONLY || ctx->hkdf.md == NULL ||
+        key == NULL || *keylen >= ctx->hkdf.md->md_size)
+    __CPROVER_assigns(*keylen, SIZE_BOUND_ASSIGNS(DERIVATION_SIZE_BOUND); key != NULL: UNCONSTRAINED_DATA(key, *keylen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(DERIVATION_SIZE_BOUND))
+    __CPROVER_ensures(
+        __CPROVER_return_value != 1 || ctx->id != EVP_PKEY_HKDF ||
+        (ctx->hkdf.md != NULL && ctx->hkdf.is_key_set &&
+         (ctx->hkdf.mode == EVP_PKEY_HKDEF_MODE_EXTRACT_ONLY
+              ? *keylen == ctx->hkdf.md->md_size
+              : key != NULL && *keylen == __CPROVER_old(*keylen) &&
+                    *keylen <= HKDF_MAX_BLOCKS * (size_t)ctx->hkdf.md->md_size)))
+    __CPROVER_ensures(
+        __CPROVER_return_value != 1 || ctx->id == EVP_PKEY_HKDF ||
+        (output_size_bound_is_initialized[DERIVATION_SIZE_BOUND] &&
+         (key == NULL ? *keylen == output_size_bounds[DERIVATION_SIZE_BOUND] : *keylen <= __CPROVER_old(*keylen))))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *keylen == __CPROVER_old(*keylen))
+{
+    /* TODO: assert(evp_pkey_ctx_is_valid(ctx)); */
+    assert(ctx != NULL);
+    assert(ctx->operation == EVP_PKEY_CTX_OPERATION_DERIVE);
+    assert(keylen);
+    if (key != NULL) COUNT_CALL(MODEL_CALL_EVP_PKEY_DERIVE, 0);
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        int rv = nondet_int();
+        __CPROVER_assume(rv <= 0);
+        return rv;
+    }
+    if (ctx->id == EVP_PKEY_HKDF) return evp_pkey_hkdf_derive(&ctx->hkdf, key, keylen);
+
+    // Derivation size is nondeterministic but fixed. See ec_override.c for details.
+    size_t max_required_size = max_derivation_size();
+    if (!key) {
+        *keylen = max_required_size;
+    } else {
+        size_t amount_of_data_written = nondet_size_t();
+        __CPROVER_assume(amount_of_data_written <= *keylen);
+        write_unconstrained_data(key, amount_of_data_written);
+        *keylen = amount_of_data_written;
+    }
+
+    return 1;
+}
+
+/*
+ * The EVP_PKEY_encrypt_init() function initializes a public key algorithm context using key pkey for an encryption
+ * operation. EVP_PKEY_encrypt_init() and EVP_PKEY_encrypt() return 1 for success and 0 or a negative value for failure.
+ * In particular a return value of -2 indicates the operation is not supported by the public key algorithm.
+ */
+int EVP_PKEY_encrypt_init(EVP_PKEY_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->pkey != NULL)
+    __CPROVER_assigns(ctx->operation)
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(
+        ctx->operation ==
+        (__CPROVER_return_value == 1 ? EVP_PKEY_CTX_OPERATION_ENCRYPT : EVP_PKEY_CTX_OPERATION_UNDEFINED))
+{
+    assert(ctx != NULL);
+    assert(ctx->pkey != NULL);
+    return evp_pkey_ctx_start_operation(ctx, EVP_PKEY_CTX_OPERATION_ENCRYPT);
+}
+
+/*
+ * The EVP_PKEY_decrypt_init() function initializes a public key algorithm context using key pkey for a decryption
+ * operation. EVP_PKEY_decrypt_init() and EVP_PKEY_decrypt() return 1 for success and 0 or a negative value for failure.
+ * In particular a return value of -2 indicates the operation is not supported by the public key algorithm.
+ */
+int EVP_PKEY_decrypt_init(EVP_PKEY_CTX *ctx)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_requires(ctx->pkey != NULL)
+    __CPROVER_assigns(ctx->operation)
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(
+        ctx->operation ==
+        (__CPROVER_return_value == 1 ? EVP_PKEY_CTX_OPERATION_DECRYPT : EVP_PKEY_CTX_OPERATION_UNDEFINED))
+{
+    assert(ctx != NULL);
+    assert(ctx->pkey != NULL);
+    return evp_pkey_ctx_start_operation(ctx, EVP_PKEY_CTX_OPERATION_DECRYPT);
+}
+
+/*
+ * The macro EVP_PKEY_CTX_set_rsa_padding() sets the RSA padding mode for ctx. The pad parameter can take the value
+ * RSA_PKCS1_PADDING for PKCS#1 padding, RSA_SSLV23_PADDING for SSLv23 padding, RSA_NO_PADDING for no padding,
+ * RSA_PKCS1_OAEP_PADDING for OAEP padding (encrypt and decrypt only), RSA_X931_PADDING for X9.31 padding (signature
+ * operations only) and RSA_PKCS1_PSS_PADDING (sign and verify only).
+ *
+ */
+int EVP_PKEY_CTX_set_rsa_padding(EVP_PKEY_CTX *ctx, int pad)
+    __CPROVER_requires(__CPROVER_rw_ok(ctx, sizeof(*ctx)))
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    __CPROVER_requires(
+        pad == RSA_PKCS1_PADDING || pad == RSA_SSLV23_PADDING || pad == RSA_NO_PADDING ||
+        pad == RSA_PKCS1_OAEP_PADDING || pad == RSA_X931_PADDING || pad == RSA_PKCS1_PSS_PADDING)
+    __CPROVER_requires(pad != RSA_X931_PADDING || ctx->operation == EVP_PKEY_CTX_OPERATION_SIGN)
+    __CPROVER_assigns(ctx->rsa_pad)
+    __CPROVER_ensures(ctx->rsa_pad == pad)
+#else
+    __CPROVER_requires(false) /* RSA keys are not supported in this configuration. */
+    __CPROVER_assigns()
+#endif
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    assert(
+        pad == RSA_PKCS1_PADDING || pad == RSA_SSLV23_PADDING || pad == RSA_NO_PADDING ||
+        pad == RSA_PKCS1_OAEP_PADDING || pad == RSA_X931_PADDING || pad == RSA_PKCS1_PSS_PADDING);
+    assert(IMPLIES(pad == RSA_X931_PADDING, ctx->operation == EVP_PKEY_CTX_OPERATION_SIGN));
+    ctx->rsa_pad = pad;
+    return inject_failure(LIBCRYPTO_MODEL_EVP_PKEY) ? 0 : 1;
+#else
+    __CPROVER_assert(0, "RSA keys are not supported in this configuration");
+    return 0;
+#endif
+}
+/*
+ * The EVP_PKEY_CTX_set_rsa_oaep_md() macro sets the message digest type used in RSA OAEP to md.
+ * The padding mode must have been set to RSA_PKCS1_OAEP_PADDING.
+ */
+int EVP_PKEY_CTX_set_rsa_oaep_md(EVP_PKEY_CTX *ctx, const EVP_MD *md)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)))
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    __CPROVER_requires(ctx->rsa_pad == RSA_PKCS1_OAEP_PADDING)
+    __CPROVER_assigns()
+#else
+    __CPROVER_requires(false) /* RSA keys are not supported in this configuration. */
+    __CPROVER_assigns()
+#endif
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    assert(ctx->rsa_pad == RSA_PKCS1_OAEP_PADDING);
+    return inject_failure(LIBCRYPTO_MODEL_EVP_PKEY) ? 0 : 1;
+#else
+    __CPROVER_assert(0, "RSA keys are not supported in this configuration");
+    return 0;
+#endif
+}
+
+/*
+ * The EVP_PKEY_CTX_set_rsa_mgf1_md() macro sets the MGF1 digest for RSA padding schemes to md.
+ * If not explicitly set the signing digest is used. The padding mode must have been set to RSA_PKCS1_OAEP_PADDING or
+ * RSA_PKCS1_PSS_PADDING.
+ */
+int EVP_PKEY_CTX_set_rsa_mgf1_md(EVP_PKEY_CTX *ctx, const EVP_MD *md)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)))
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    __CPROVER_requires(ctx->rsa_pad == RSA_PKCS1_OAEP_PADDING || ctx->rsa_pad == RSA_PKCS1_PSS_PADDING)
+    __CPROVER_assigns()
+#else
+    __CPROVER_requires(false) /* RSA keys are not supported in this configuration. */
+    __CPROVER_assigns()
+#endif
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(ctx != NULL);
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_RSA
+    assert(ctx->rsa_pad == RSA_PKCS1_OAEP_PADDING || ctx->rsa_pad == RSA_PKCS1_PSS_PADDING);
+    return inject_failure(LIBCRYPTO_MODEL_EVP_PKEY) ? 0 : 1;
+#else
+    __CPROVER_assert(0, "RSA keys are not supported in this configuration");
+    return 0;
+#endif
+}
+
+/*
+ * The EVP_PKEY_encrypt() function performs a public key encryption operation using ctx.
+ * The data to be encrypted is specified using the in and inlen parameters. If out is NULL then the maximum size of the
+ * output buffer is written to the outlen parameter. If out is not NULL then before the call the outlen parameter should
+ * contain the length of the out buffer, if the call is successful the encrypted data is written to out and the amount
+ * of data written to outlen.
+ */
+int EVP_PKEY_encrypt(EVP_PKEY_CTX *ctx, unsigned char *out, size_t *outlen, const unsigned char *in, size_t inlen)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)) && ctx->operation == EVP_PKEY_CTX_OPERATION_ENCRYPT)
+    __CPROVER_requires(__CPROVER_rw_ok(outlen, sizeof(*outlen)))
+    __CPROVER_requires(out == NULL || __CPROVER_w_ok(out, *outlen))
+    __CPROVER_assigns(*outlen, SIZE_BOUND_ASSIGNS(ENCRYPTION_SIZE_BOUND); out != NULL: UNCONSTRAINED_DATA(out, *outlen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(ENCRYPTION_SIZE_BOUND))
+    __CPROVER_ensures(
+        __CPROVER_return_value != 1 ||
+        (output_size_bound_is_initialized[ENCRYPTION_SIZE_BOUND] &&
+         (out == NULL ? *outlen == output_size_bounds[ENCRYPTION_SIZE_BOUND] : *outlen <= __CPROVER_old(*outlen))))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *outlen == __CPROVER_old(*outlen))
+{
+    assert(ctx != NULL);
+    assert(ctx->operation == EVP_PKEY_CTX_OPERATION_ENCRYPT);
+    if (out != NULL) COUNT_CALL(MODEL_CALL_EVP_PKEY_ENCRYPT, inlen);
+    // Encyption size is nondeterministic but fixed. See ec_override.c for details.
+    size_t max_required_size = max_encryption_size();
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        int rv = nondet_int();
+        __CPROVER_assume(rv <= 0);
+        return rv;
+    }
+
+    if (!out) {
+        *outlen = max_required_size;
+    } else {
+        size_t amount_of_data_written = nondet_size_t();
+        __CPROVER_assume(amount_of_data_written <= *outlen);
+        write_unconstrained_data(out, amount_of_data_written);
+        *outlen = amount_of_data_written;
+    }
+
+    return 1;
+}
+
+/*
+ * The EVP_PKEY_decrypt() function performs a public key decryption operation using ctx. The data to be decrypted is
+ * specified using the in and inlen parameters. If out is NULL then the maximum size of the output buffer is written to
+ * the outlen parameter. If out is not NULL then before the call the outlen parameter should contain the length of the
+ * out buffer, if the call is successful the decrypted data is written to out and the amount of data written to outlen.
+ */
+int EVP_PKEY_decrypt(EVP_PKEY_CTX *ctx, unsigned char *out, size_t *outlen, const unsigned char *in, size_t inlen)
+    __CPROVER_requires(__CPROVER_r_ok(ctx, sizeof(*ctx)) && ctx->operation == EVP_PKEY_CTX_OPERATION_DECRYPT)
+    __CPROVER_requires(__CPROVER_rw_ok(outlen, sizeof(*outlen)))
+    __CPROVER_requires(out == NULL || __CPROVER_w_ok(out, *outlen))
+    __CPROVER_assigns(*outlen, SIZE_BOUND_ASSIGNS(DECRYPTION_SIZE_BOUND); out != NULL: UNCONSTRAINED_DATA(out, *outlen))
+    __CPROVER_ensures(__CPROVER_return_value <= 1)
+    __CPROVER_ensures(SIZE_BOUND_IS_STABLE(DECRYPTION_SIZE_BOUND))
+    __CPROVER_ensures(
+        __CPROVER_return_value != 1 ||
+        (output_size_bound_is_initialized[DECRYPTION_SIZE_BOUND] &&
+         (out == NULL ? *outlen == output_size_bounds[DECRYPTION_SIZE_BOUND] : *outlen <= __CPROVER_old(*outlen))))
+    __CPROVER_ensures(__CPROVER_return_value == 1 || *outlen == __CPROVER_old(*outlen))
+{
+    assert(ctx != NULL);
+    assert(ctx->operation == EVP_PKEY_CTX_OPERATION_DECRYPT);
+    if (out != NULL) COUNT_CALL(MODEL_CALL_EVP_PKEY_DECRYPT, inlen);
+    // Decryption size is nondeterministic but fixed. See ec_override.c for details.
+    size_t max_required_size = max_decryption_size();
+
+    if (inject_failure(LIBCRYPTO_MODEL_EVP_PKEY)) {
+        int rv = nondet_int();
+        __CPROVER_assume(rv <= 0);
+        return rv;
+    }
+
+    if (!out) {
+        *outlen = max_required_size;
+    } else {
+        size_t amount_of_data_written = nondet_size_t();
+        __CPROVER_assume(amount_of_data_written <= *outlen);
+        write_unconstrained_data(out, amount_of_data_written);
+        *outlen = amount_of_data_written;
+    }
+
+    return 1;
+}
+
+/*
+ * EVP_PKEY_CTX_free() frees up the context ctx. If ctx is NULL, nothing is done.
+ *
+ * Reference Implementation:
+ * https://github.com/openssl/openssl/blob/6c9bc258d2e9e7b500236a1c696da1f384f0b907/crypto/evp/pmeth_lib.c#L393
+ */
+void EVP_PKEY_CTX_free(EVP_PKEY_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_r_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(EVP_PKEY_CTX_RELEASE_ASSIGNS(true, ctx))
+    __CPROVER_frees(EVP_PKEY_CTX_FREES(true, ctx))
+{
+    if (!ctx) return;
+
+    EVP_PKEY_free(ctx->pkey);
+    model_free(ctx);
+}
+
+/* CBMC helper functions */
+
+/* Helper function for CBMC proofs: checks if EVP_PKEY is valid. */
+bool evp_pkey_is_valid(EVP_PKEY *pkey) {
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    return pkey && refcount_is_live(pkey->references) && (pkey->ec_key == NULL || ec_key_is_valid(pkey->ec_key));
+#else
+    return pkey && refcount_is_live(pkey->references);
+#endif
+}
+
+/* Helper function for CBMC proofs: allocates EVP_PKEY nondeterministically. */
+EVP_PKEY *evp_pkey_nondet_alloc() {
+    EVP_PKEY *pkey = evp_pkey_pool_alloc();
+    return pkey;
+}
+
+/*
+ * Helper function for CBMC proofs: allocates an EVP_PKEY that satisfies evp_pkey_is_valid() by construction, with any
+ * live reference count, or returns NULL when the allocation fails. The key holds a new reference to shared_ec_key if
+ * it is not NULL; otherwise, with depth > 0, it may hold a fresh EC key generated with depth - 1.
+ */
+EVP_PKEY *evp_pkey_nondet_valid_alloc(int depth, EC_KEY *shared_ec_key) {
+    EVP_PKEY *pkey = evp_pkey_pool_alloc();
+    if (pkey == NULL) return NULL;
+
+    pkey->references = nondet_int();
+    __CPROVER_assume(refcount_is_live(pkey->references));
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    if (shared_ec_key != NULL) {
+        assert(ec_key_is_valid(shared_ec_key));
+        __CPROVER_assume(shared_ec_key->references < MODEL_REFCOUNT_MAX);
+        refcount_acquire(&shared_ec_key->references);
+        pkey->ec_key = shared_ec_key;
+    } else {
+        pkey->ec_key = (depth > 0 && nondet_bool()) ? ec_key_nondet_valid_alloc(depth - 1) : NULL;
+    }
+#else
+    assert(shared_ec_key == NULL);
+#endif
+    return pkey;
+}
+
+/*
+ * Helper function for CBMC proofs: allocates an EVP_PKEY_CTX that satisfies evp_pkey_ctx_is_valid() by construction,
+ * for an unconstrained algorithm and operation, or returns NULL when the allocation fails. The context holds a new
+ * reference to shared_pkey if it is not NULL; otherwise, with depth > 0, it may hold a fresh key generated with
+ * depth - 1.
+ */
+EVP_PKEY_CTX *evp_pkey_ctx_nondet_valid_alloc(int depth, EVP_PKEY *shared_pkey) {
+    EVP_PKEY_CTX *ctx = model_malloc(sizeof(EVP_PKEY_CTX));
+    if (ctx == NULL) return NULL;
+
+    if (shared_pkey != NULL) {
+        assert(evp_pkey_is_valid(shared_pkey));
+        __CPROVER_assume(shared_pkey->references < MODEL_REFCOUNT_MAX);
+        refcount_acquire(&shared_pkey->references);
+        ctx->pkey = shared_pkey;
+    } else {
+        ctx->pkey = (depth > 0 && nondet_bool()) ? evp_pkey_nondet_valid_alloc(depth - 1, NULL) : NULL;
+    }
+    return ctx;
+}
+
+/* Helper function for CBMC proofs: returns the reference count. */
+int evp_pkey_get_reference_count(EVP_PKEY *pkey) {
+    return pkey ? pkey->references : 0;
+}
+
+/* Helper function for CBMC proofs: set EC_KEY without incrementing the reference count. */
+void evp_pkey_set0_ec_key(EVP_PKEY *pkey, EC_KEY *ec) {
+#ifdef LIBCRYPTO_MODEL_PKEY_HAS_EC
+    if (pkey) pkey->ec_key = ec;
+#else
+    assert(ec == NULL);
+#endif
+}
+
+/* Helper function for CBMC proofs: frees the memory regardless of the reference count. */
+void evp_pkey_unconditional_free(EVP_PKEY *pkey) {
+    evp_pkey_pool_free(pkey);
+    // Does not free EC_KEY, since this is always done separately in our use cases
+}
+
+bool evp_pkey_ctx_is_valid(EVP_PKEY_CTX *ctx) {
+    return ctx && (ctx->pkey == NULL || evp_pkey_is_valid(ctx->pkey));
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2019 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ *  http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include <call_count_utils.h>
+#include <evp_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <assert.h>
+
+/* Abstraction of the HMAC_CTX struct has been moved to hmcac.h*/
+
+/* Assigns clause targets of the state that absorbing message bytes and setting a key update. */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define HMAC_CTX_ABSORB_ASSIGNS(ctx) (ctx)->fingerprint
+#    define HMAC_CTX_KEY_ASSIGNS(ctx) (ctx)->md, (ctx)->is_keyed, (ctx)->key_fingerprint, (ctx)->fingerprint
+#else
+#    define HMAC_CTX_ABSORB_ASSIGNS(ctx)
+#    define HMAC_CTX_KEY_ASSIGNS(ctx) (ctx)->md, (ctx)->is_keyed
+#endif
+
+/*
+ * Description: HMAC_CTX_init() initialises a HMAC_CTX before first use. It must be called.
+ */
+void HMAC_CTX_init(HMAC_CTX *ctx)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(*ctx)
+    __CPROVER_ensures(ctx->is_initialized && !ctx->is_keyed && ctx->md == NULL)
+{
+    ctx->md             = NULL;
+    ctx->md_ctx         = NULL;
+    ctx->i_ctx          = NULL;
+    ctx->o_ctx          = NULL;
+    ctx->is_initialized = true;
+    ctx->is_keyed       = false;
+}
+
+/*
+ * Description: HMAC_CTX_new() creates a new HMAC_CTX in heap memory. Return values: Returns a pointer to the new
+ * HMAC_CTX, or NULL if an error occurred.
+ */
+HMAC_CTX *HMAC_CTX_new(void)
+    __CPROVER_assigns()
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_is_fresh(__CPROVER_return_value, sizeof(HMAC_CTX)))
+    __CPROVER_ensures(
+        __CPROVER_return_value == NULL ||
+        (__CPROVER_return_value->is_initialized && !__CPROVER_return_value->is_keyed &&
+         __CPROVER_return_value->md == NULL))
+{
+    if (inject_failure(LIBCRYPTO_MODEL_HMAC)) return NULL;
+    HMAC_CTX *ctx = model_malloc(sizeof(HMAC_CTX));
+    if (ctx != NULL) HMAC_CTX_init(ctx);
+    return ctx;
+}
+
+/*
+ * Description: HMAC_CTX_reset() zeroes an existing HMAC_CTX and associated resources, making it suitable for new
+ * computations as if it was newly created with HMAC_CTX_new(). The key is forgotten, so the next HMAC_Init_ex() must
+ * set one. Return values: Returns 1 for success or 0 if an error occurred.
+ */
+int HMAC_CTX_reset(HMAC_CTX *ctx)
+    __CPROVER_requires(__CPROVER_w_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns(*ctx)
+    __CPROVER_ensures(__CPROVER_return_value == 1)
+    __CPROVER_ensures(ctx->is_initialized && !ctx->is_keyed && ctx->md == NULL)
+{
+    HMAC_CTX_init(ctx);
+    return 1;
+}
+
+/*
+ * Description: HMAC_CTX_copy() copies all of the internal state from sctx into dctx, including the key. Return values:
+ * Returns 1 for success or 0 if an error occurred, in which case dctx is unchanged.
+ */
+int HMAC_CTX_copy(HMAC_CTX *dctx, HMAC_CTX *sctx)
+    __CPROVER_requires(__CPROVER_w_ok(dctx, sizeof(*dctx)))
+    __CPROVER_requires(hmac_ctx_is_valid(sctx))
+    __CPROVER_assigns(*dctx)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (dctx->is_initialized && dctx->is_keyed == sctx->is_keyed && dctx->md == sctx->md))
+{
+    assert(hmac_ctx_is_valid(sctx));
+    if (inject_failure(LIBCRYPTO_MODEL_HMAC)) return 0;
+    *dctx = *sctx;
+    return 1;
+}
+
+/*
+ * Description: HMAC_CTX_free() erases the key and other data from the HMAC_CTX, releases any associated resources and
+ * finally frees the HMAC_CTX itself.
+ */
+void HMAC_CTX_free(HMAC_CTX *ctx)
+    __CPROVER_requires(ctx == NULL || __CPROVER_rw_ok(ctx, sizeof(*ctx)))
+    __CPROVER_assigns()
+    __CPROVER_frees(ctx)
+{
+    model_free(ctx);
+}
+
+/*
+HMAC() computes the message authentication code of the n bytes at d using the hash function evp_md and the
+key key which is key_len bytes long.
+It places the result in md (which must have space for the output of the hash function,
+which is no more than EVP_MAX_MD_SIZE bytes). If md is NULL, the digest is placed in a static array.
+The size of the output is placed in md_len, unless it is NULL.
+Note: passing a NULL value for md to use the static array is not thread safe.
+*/
+
+static unsigned char hmac_static_md[EVP_MAX_MD_SIZE];
+
+unsigned char *HMAC(
+    const EVP_MD *evp_md,
+    const void *key,
+    int key_len,
+    const unsigned char *d,
+    size_t n,
+    unsigned char *md,
+    unsigned int *md_len)
+    __CPROVER_requires(evp_md != NULL)
+    __CPROVER_requires(
+        md == NULL || (__CPROVER_w_ok(md, EVP_MAX_MD_SIZE) && __CPROVER_w_ok(md_len, sizeof(*md_len))))
+    __CPROVER_assigns(md != NULL: UNCONSTRAINED_DATA(md, EVP_MAX_MD_SIZE), *md_len; md == NULL: hmac_static_md)
+    __CPROVER_ensures(md == NULL || (__CPROVER_return_value == md && *md_len <= EVP_MAX_MD_SIZE))
+    __CPROVER_ensures(md != NULL || __CPROVER_return_value == hmac_static_md)
+{
+    assert(evp_md != NULL);
+    COUNT_CALL(MODEL_CALL_HMAC, n);
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    /* Equal inputs must give equal outputs, including their lengths. */
+    size_t amount_of_data_written      = EVP_MD_size(evp_md);
+    digest_fingerprint message         = digest_fingerprint_absorb(DIGEST_FINGERPRINT_EMPTY, d, n);
+    digest_fingerprint key_fingerprint =
+        key != NULL ? digest_fingerprint_absorb(DIGEST_FINGERPRINT_EMPTY, key, key_len) : DIGEST_FINGERPRINT_EMPTY;
+#else
+    size_t amount_of_data_written = nondet_size_t();
+    __CPROVER_assume(amount_of_data_written <= EVP_MAX_MD_SIZE);
+#endif
+    if (md != NULL) {
+        DIGEST_OUTPUT(md, amount_of_data_written, DIGEST_ALGORITHM_HMAC(evp_md->from), message, key_fingerprint);
+        *md_len = amount_of_data_written;
+        return md;
+    }
+    DIGEST_OUTPUT(
+        hmac_static_md, amount_of_data_written, DIGEST_ALGORITHM_HMAC(evp_md->from), message, key_fingerprint);
+    return hmac_static_md;
+}
+
+bool hmac_ctx_is_valid(HMAC_CTX *ctx);
+
+/*
+* HMAC_Init_ex() initializes or reuses a HMAC_CTX structure to use the hash function evp_md and key key.
+* If both are NULL (or evp_md is the same as the previous digest used by ctx and key is NULL) the existing key is
+reused.
+* ctx must have been created with HMAC_CTX_new() before the first use of an HMAC_CTX in this function.
+* N.B. HMAC_Init() had this undocumented behaviour in previous versions of OpenSSL - failure to switch to HMAC_Init_ex()
+in
+* programs that expect it will cause them to stop working.
+
+* NB: if HMAC_Init_ex() is called with key NULL and evp_md is not the same as the previous digest used by ctx then an
+* error is returned because reuse of an existing key with a different digest is not supported.
+* Reusing the key of a ctx that never had one is an error as well.
+*
+* Return 1 for success or 0 if an error occurred, in which case ctx is unchanged.
+*/
+int HMAC_Init_ex(HMAC_CTX *ctx, const void *key, int len, const EVP_MD *md, ENGINE *impl)
+    __CPROVER_requires(hmac_ctx_is_valid(ctx))
+    __CPROVER_requires(key == NULL || (0 <= len && __CPROVER_r_ok(key, len)))
+    __CPROVER_requires(md == NULL || evp_md_is_valid((EVP_MD *)md))
+    __CPROVER_assigns(HMAC_CTX_KEY_ASSIGNS(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(key != NULL || __CPROVER_old(ctx->is_keyed) || __CPROVER_return_value == 0)
+    __CPROVER_ensures(key != NULL || md == NULL || md == __CPROVER_old(ctx->md) || __CPROVER_return_value == 0)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 ||
+        (ctx->is_keyed && ctx->md == (md != NULL ? md : __CPROVER_old(ctx->md)) && ctx->md != NULL))
+    __CPROVER_ensures(
+        __CPROVER_return_value == 1 ||
+        (ctx->is_keyed == __CPROVER_old(ctx->is_keyed) && ctx->md == __CPROVER_old(ctx->md)))
+{
+    assert(hmac_ctx_is_valid(ctx));
+    if (md == NULL) {
+        md = ctx->md;
+    } else if (key == NULL && md != ctx->md) {
+        return 0;
+    }
+    if (md == NULL || (key == NULL && !ctx->is_keyed)) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_HMAC)) return 0;
+
+    /* Reusing the key (key == NULL) only restarts the computation, so nothing is allocated either way. */
+    ctx->md       = md;
+    ctx->is_keyed = true;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    if (key != NULL) ctx->key_fingerprint = digest_fingerprint_absorb(DIGEST_FINGERPRINT_EMPTY, key, len);
+    ctx->fingerprint = DIGEST_FINGERPRINT_EMPTY;
+#endif
+    return 1;
+}
+
+/*
+ * HMAC_Update() can be called repeatedly with chunks of the message to be authenticated (len bytes at data).
+ * Return 1 for success or 0 if an error occurred.
+ */
+int HMAC_Update(HMAC_CTX *ctx, const unsigned char *data, size_t len)
+    __CPROVER_requires(hmac_ctx_is_valid(ctx))
+    __CPROVER_assigns(HMAC_CTX_ABSORB_ASSIGNS(ctx))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(ctx->is_keyed || __CPROVER_return_value == 0)
+{
+    assert(hmac_ctx_is_valid(ctx));
+    COUNT_CALL(MODEL_CALL_HMAC_UPDATE, len);
+    if (!ctx->is_keyed) return 0;
+    int rv = inject_failure(LIBCRYPTO_MODEL_HMAC) ? 0 : 1;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    if (rv == 1) ctx->fingerprint = digest_fingerprint_absorb(ctx->fingerprint, data, len);
+#endif
+    return rv;
+}
+
+/*
+ *HMAC_Final() places the message authentication code in md, which must have space for the hash function output.
+ */
+int HMAC_Final(HMAC_CTX *ctx, unsigned char *md, unsigned int *len)
+    __CPROVER_requires(hmac_ctx_is_valid(ctx))
+    __CPROVER_requires(
+        __CPROVER_r_ok(ctx->md, sizeof(*ctx->md)) && 0 <= ctx->md->from && ctx->md->from < EVP_MD_TABLE_SIZE)
+    __CPROVER_requires(__CPROVER_w_ok(md, evp_md_table[ctx->md->from].md_size))
+    __CPROVER_requires(__CPROVER_w_ok(len, sizeof(*len)))
+    __CPROVER_assigns(UNCONSTRAINED_DATA(md, evp_md_table[ctx->md->from].md_size), *len)
+    __CPROVER_ensures(*len == evp_md_table[ctx->md->from].md_size)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+{
+    assert(hmac_ctx_is_valid(ctx));
+    assert(ctx->md != NULL);
+    COUNT_CALL(MODEL_CALL_HMAC_FINAL, 0);
+    int md_size = EVP_MD_size(ctx->md);
+    DIGEST_OUTPUT(md, md_size, DIGEST_ALGORITHM_HMAC(ctx->md->from), ctx->fingerprint, ctx->key_fingerprint);
+    *len = md_size;
+    int rv = inject_failure(LIBCRYPTO_MODEL_HMAC) ? 0 : 1;
+    /*
+     * Using __CPROVER_r_ok(md, md_size)  would make this assumption stronger,
+     * but the use of these primitives in assumptions may lead to spurious results.
+     */
+    __CPROVER_assume(md != NULL);
+    return rv;
+}
+
+/* CBMC helper functions */
+
+/* Helper function for CBMC proofs: checks if HMAC_CTX is valid. */
+bool hmac_ctx_is_valid(HMAC_CTX *ctx) {
+    return ctx && ctx->is_initialized && (!ctx->is_keyed || evp_md_is_valid((EVP_MD *)ctx->md));
+}
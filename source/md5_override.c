@@ -14,6 +14,9 @@
  */
 
 #include <ec_utils.h>
+#include <failure_utils.h>
+#include <md32_utils.h>
+#include <model_config.h>
 #include <openssl/md5.h>
 
 #include <assert.h>
@@ -27,9 +30,84 @@
 #define INIT_DATA_C (unsigned long)0x98badcfeL
 #define INIT_DATA_D (unsigned long)0x10325476L
 
+#ifdef LIBCRYPTO_MODEL_CONCRETE_MD5
+/* Reference implementation of MD5 (RFC 1321), see LIBCRYPTO_MODEL_CONCRETE_MD5 in model_config.h. */
+#    define MD5_STREAM(c) ((struct md32_stream){ (unsigned char *)(c)->data, &(c)->num, &(c)->Nl, &(c)->Nh })
+
+/* Additive constants and rotation amounts of the 64 steps. */
+static const uint32_t md5_t[64] = {
+    0xd76aa478UL, 0xe8c7b756UL, 0x242070dbUL, 0xc1bdceeeUL, 0xf57c0fafUL, 0x4787c62aUL, 0xa8304613UL, 0xfd469501UL,
+    0x698098d8UL, 0x8b44f7afUL, 0xffff5bb1UL, 0x895cd7beUL, 0x6b901122UL, 0xfd987193UL, 0xa679438eUL, 0x49b40821UL,
+    0xf61e2562UL, 0xc040b340UL, 0x265e5a51UL, 0xe9b6c7aaUL, 0xd62f105dUL, 0x02441453UL, 0xd8a1e681UL, 0xe7d3fbc8UL,
+    0x21e1cde6UL, 0xc33707d6UL, 0xf4d50d87UL, 0x455a14edUL, 0xa9e3e905UL, 0xfcefa3f8UL, 0x676f02d9UL, 0x8d2a4c8aUL,
+    0xfffa3942UL, 0x8771f681UL, 0x6d9d6122UL, 0xfde5380cUL, 0xa4beea44UL, 0x4bdecfa9UL, 0xf6bb4b60UL, 0xbebfbc70UL,
+    0x289b7ec6UL, 0xeaa127faUL, 0xd4ef3085UL, 0x04881d05UL, 0xd9d4d039UL, 0xe6db99e5UL, 0x1fa27cf8UL, 0xc4ac5665UL,
+    0xf4292244UL, 0x432aff97UL, 0xab9423a7UL, 0xfc93a039UL, 0x655b59c3UL, 0x8f0ccc92UL, 0xffeff47dUL, 0x85845dd1UL,
+    0x6fa87e4fUL, 0xfe2ce6e0UL, 0xa3014314UL, 0x4e0811a1UL, 0xf7537e82UL, 0xbd3af235UL, 0x2ad7d2bbUL, 0xeb86d391UL
+};
+
+static const unsigned char md5_shift[4][4] = {
+    { 7, 12, 17, 22 }, { 5, 9, 14, 20 }, { 4, 11, 16, 23 }, { 6, 10, 15, 21 }
+};
+
+static void md5_block(void *ctx, const unsigned char *block) {
+    MD5_CTX *c = ctx;
+    uint32_t x[16];
+    for (size_t i = 0; i < 16; i++) x[i] = md32_load_le(block + 4 * i);
+
+    uint32_t a = c->A, b = c->B, cc = c->C, d = c->D;
+    for (size_t i = 0; i < 64; i++) {
+        uint32_t f;
+        size_t g;
+        switch (i / 16) {
+            case 0:
+                f = (b & cc) | (~b & d);
+                g = i;
+                break;
+            case 1:
+                f = (d & b) | (~d & cc);
+                g = (5 * i + 1) % 16;
+                break;
+            case 2:
+                f = b ^ cc ^ d;
+                g = (3 * i + 5) % 16;
+                break;
+            default:
+                f = cc ^ (b | ~d);
+                g = (7 * i) % 16;
+                break;
+        }
+        uint32_t sum = a + f + md5_t[i] + x[g];
+        a            = d;
+        d            = cc;
+        cc           = b;
+        b            = b + MD32_ROTL(sum, md5_shift[i / 16][i % 4]);
+    }
+
+    c->A += a;
+    c->B += b;
+    c->C += cc;
+    c->D += d;
+}
+
+static void md5_reference_final(unsigned char *md, MD5_CTX *c) {
+    md32_final(c, MD5_STREAM(c), md5_block, false);
+    md32_store_le(md, c->A);
+    md32_store_le(md + 4, c->B);
+    md32_store_le(md + 8, c->C);
+    md32_store_le(md + 12, c->D);
+}
+
+#    define MD5_REFERENCE_UPDATE(c, data, len) md32_update((c), MD5_STREAM(c), md5_block, (data), (len))
+#    define MD5_REFERENCE_FINAL(md, c) md5_reference_final((md), (c))
+#else
+#    define MD5_REFERENCE_UPDATE(c, data, len)
+#    define MD5_REFERENCE_FINAL(md, c) __CPROVER_havoc_slice((md), MD5_DIGEST_LENGTH)
+#endif
+
 int MD5_Init(MD5_CTX *c) {
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_MD5)) return 0;
     *c   = (const MD5_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->A = INIT_DATA_A;
     c->B = INIT_DATA_B;
@@ -41,15 +119,16 @@ int MD5_Init(MD5_CTX *c) {
 int MD5_Final(unsigned char *md, MD5_CTX *c) {
     assert(__CPROVER_w_ok(md, MD5_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, MD5_DIGEST_LENGTH);
+    if (inject_failure(LIBCRYPTO_MODEL_MD5)) return 0;
+    MD5_REFERENCE_FINAL(md, c);
     *c = (const MD5_CTX){ 0 };
     return 1;
 }
 
 int MD5_Update(MD5_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_MD5)) return 0;
+    MD5_REFERENCE_UPDATE(c, data, len);
     return 1;
 }
@@ -0,0 +1,29 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+/*
+ * Unconstrained output shared by all families of the model (see havoc_utils.h). Nothing in this unit models an OpenSSL
+ * API.
+ */
+
+#include <assert.h>
+#include <havoc_utils.h>
+
+/* Writes arbitrary data into the buffer out. */
+void write_unconstrained_data(unsigned char *out, size_t len)
+    __CPROVER_requires(__CPROVER_w_ok(out, len))
+    __CPROVER_assigns(UNCONSTRAINED_DATA(out, len))
+{
+    assert(__CPROVER_w_ok(out, len));
+
+#ifdef LIBCRYPTO_MODEL_PRECISE_HAVOC
+    // Only the bytes that are actually written become unconstrained, the rest of the object is left untouched.
+    __CPROVER_havoc_slice(out, len);
+#else
+    // By default we ignore the len parameter and just fill the entire buffer with unconstrained data.
+    // This is fine because it is strictly more general behavior than writing only len bytes.
+    __CPROVER_havoc_object(out);
+#endif
+}
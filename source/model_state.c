@@ -0,0 +1,118 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+/*
+ * Ghost state of the model that is shared by all of its units and by the harnesses, in the configurations that keep
+ * it (see model_config.h). Nothing in this unit models an OpenSSL API.
+ */
+
+#include <assert.h>
+#include <call_count_utils.h>
+#include <failure_utils.h>
+#include <heap_utils.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef LIBCRYPTO_MODEL_FAILURE_BUDGET
+/* Number of failures injected so far, shared by all failure sites of the model. */
+static unsigned int injected_failures = 0;
+
+bool inject_budgeted_failure(void) {
+    if (injected_failures >= LIBCRYPTO_MODEL_FAILURE_BUDGET || !nondet_bool()) return false;
+    injected_failures += 1;
+    return true;
+}
+
+unsigned int injected_failure_count(void) {
+    return injected_failures;
+}
+#endif
+
+#ifdef LIBCRYPTO_MODEL_HEAP_ACCOUNTING
+/* Ghost counters of the heap objects of the model, see heap_utils.h. */
+static size_t heap_live_bytes   = 0;
+static size_t heap_live_objects = 0;
+static size_t heap_peak_bytes   = 0;
+
+static void heap_acquire(size_t size) {
+    heap_live_bytes += size;
+    heap_live_objects += 1;
+    if (heap_live_bytes > heap_peak_bytes) heap_peak_bytes = heap_live_bytes;
+}
+
+static void heap_release(void *ptr) {
+    size_t size = __CPROVER_OBJECT_SIZE(ptr);
+    assert(heap_live_objects > 0 && size <= heap_live_bytes); /* Only objects allocated by the model. */
+    heap_live_bytes -= size;
+    heap_live_objects -= 1;
+}
+
+void *model_malloc(size_t size) {
+    void *ptr = malloc(size);
+    if (ptr != NULL) heap_acquire(size);
+    return ptr;
+}
+
+void *model_realloc(void *ptr, size_t size) {
+    void *grown = realloc(ptr, size);
+    if (grown != NULL) {
+        heap_acquire(size);
+        if (ptr != NULL) heap_release(ptr);
+    }
+    return grown;
+}
+
+void model_free(void *ptr) {
+    if (ptr == NULL) return;
+    heap_release(ptr);
+    free(ptr);
+}
+
+size_t model_heap_live_bytes(void) {
+    return heap_live_bytes;
+}
+
+size_t model_heap_live_objects(void) {
+    return heap_live_objects;
+}
+
+size_t model_heap_peak_bytes(void) {
+    return heap_peak_bytes;
+}
+
+void model_heap_reset_peak(void) {
+    heap_peak_bytes = heap_live_bytes;
+}
+#endif
+
+#ifdef LIBCRYPTO_MODEL_CALL_COUNTS
+/* Ghost call and byte counts of the APIs of call_count_utils.h, shared by all translation units of the model. */
+static size_t call_counts[MODEL_CALL_COUNT];
+static size_t call_bytes[MODEL_CALL_COUNT];
+
+void model_count_call(enum model_call call, size_t bytes) {
+    assert((unsigned int)call < MODEL_CALL_COUNT);
+    if (call_counts[call] < SIZE_MAX) call_counts[call] += 1;
+    call_bytes[call] = bytes > SIZE_MAX - call_bytes[call] ? SIZE_MAX : call_bytes[call] + bytes;
+}
+
+size_t model_call_count(enum model_call call) {
+    assert((unsigned int)call < MODEL_CALL_COUNT);
+    return call_counts[call];
+}
+
+size_t model_call_bytes(enum model_call call) {
+    assert((unsigned int)call < MODEL_CALL_COUNT);
+    return call_bytes[call];
+}
+
+void model_reset_call_counts(void) {
+    for (int call = 0; call < MODEL_CALL_COUNT; call++) {
+        call_counts[call] = 0;
+        call_bytes[call]  = 0;
+    }
+}
+#endif
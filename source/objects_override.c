@@ -15,23 +15,114 @@
 
 #include <assert.h>
 #include <openssl/objects.h>
-#include <proof_helpers/nondet.h>
-#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Objects known to the model, with the lengths of their names precomputed. The curves are the only objects currently
+ * used in the ESDK; like OpenSSL, objects without a long name use their short name as long name.
+ */
+struct obj_entry {
+    int nid;
+    const char *sn;
+    size_t sn_length;
+    const char *ln;
+    size_t ln_length;
+    const char *oid;
+    size_t oid_length;
+};
+
+#define OBJ_ENTRY(nid, sn, ln, oid) \
+    { (nid), (sn), sizeof(sn) - 1, (ln), sizeof(ln) - 1, (oid), sizeof(oid) - 1 }
+
+static const struct obj_entry obj_table[] = {
+    OBJ_ENTRY(NID_X9_62_prime256v1, SN_X9_62_prime256v1, SN_X9_62_prime256v1, OBJ_X9_62_prime256v1),
+    OBJ_ENTRY(NID_secp384r1, SN_secp384r1, SN_secp384r1, OBJ_secp384r1),
+};
+
+#define OBJ_TABLE_SIZE (sizeof(obj_table) / sizeof(obj_table[0]))
+
+/* Longer than every name and OID text in obj_table. */
+#define OBJ_MAX_TEXT_LENGTH 32
+
+/*
+ * Length of the string s, or OBJ_MAX_TEXT_LENGTH if it is at least that long: no name in obj_table matches such a
+ * string, so the scan never looks further, whatever the length of s.
+ */
+static size_t obj_text_length(const char *s) {
+    size_t length = 0;
+    while (length < OBJ_MAX_TEXT_LENGTH && s[length] != '\0') length++;
+    return length;
+}
+
+/* Whether the first length characters of s spell text, which has text_length characters. */
+static bool obj_text_equals(const char *s, size_t length, const char *text, size_t text_length) {
+    if (length != text_length) return false;
+    for (size_t i = 0; i < text_length; i++) {
+        if (s[i] != text[i]) return false;
+    }
+    return true;
+}
+
+/*
+ * Description: OBJ_sn2nid() and OBJ_ln2nid() return the corresponding NID for the short name and long name s.
+ * Return values: The NID, or NID_undef if s is not the name of an object known to the model.
+ */
+int OBJ_sn2nid(const char *s) {
+    if (!s) return NID_undef;
+
+    size_t length = obj_text_length(s);
+    for (size_t i = 0; i < OBJ_TABLE_SIZE; i++) {
+        if (obj_text_equals(s, length, obj_table[i].sn, obj_table[i].sn_length)) return obj_table[i].nid;
+    }
+    return NID_undef;
+}
+
+int OBJ_ln2nid(const char *s) {
+    if (!s) return NID_undef;
+
+    size_t length = obj_text_length(s);
+    for (size_t i = 0; i < OBJ_TABLE_SIZE; i++) {
+        if (obj_text_equals(s, length, obj_table[i].ln, obj_table[i].ln_length)) return obj_table[i].nid;
+    }
+    return NID_undef;
+}
 
 /*
  * Description: OBJ_txt2nid() returns NID corresponding to text string <s>. s can be a long name, a short name or the
  * numerical representation of an object. Return values: OBJ_txt2nid() returns a NID or NID_undef on error.
  */
 int OBJ_txt2nid(const char *s) {
-    // Currently these are the only values used in the ESDK
-    if (!s) {
-        return NID_undef;
-    } else if (strcmp(s, "prime256v1") == 0) {
-        return NID_X9_62_prime256v1;
-    } else if (strcmp(s, "secp384r1") == 0) {
-        return NID_secp384r1;
-    } else {
-        __CPROVER_assert(0, "s had unexpected value");
+    if (!s) return NID_undef;
+
+    size_t length = obj_text_length(s);
+    for (size_t i = 0; i < OBJ_TABLE_SIZE; i++) {
+        const struct obj_entry *entry = &obj_table[i];
+        if (obj_text_equals(s, length, entry->sn, entry->sn_length) ||
+            obj_text_equals(s, length, entry->ln, entry->ln_length) ||
+            obj_text_equals(s, length, entry->oid, entry->oid_length)) {
+            return entry->nid;
+        }
+    }
+    return NID_undef;
+}
+
+/*
+ * Description: OBJ_nid2sn() and OBJ_nid2ln() return the short and long name of NID n.
+ * Return values: The name, or NULL if n is not the NID of an object known to the model.
+ */
+const char *OBJ_nid2sn(int n) {
+    if (n == NID_undef) return SN_undef;
+    for (size_t i = 0; i < OBJ_TABLE_SIZE; i++) {
+        if (obj_table[i].nid == n) return obj_table[i].sn;
+    }
+    return NULL;
+}
+
+const char *OBJ_nid2ln(int n) {
+    if (n == NID_undef) return LN_undef;
+    for (size_t i = 0; i < OBJ_TABLE_SIZE; i++) {
+        if (obj_table[i].nid == n) return obj_table[i].ln;
     }
-    return nondet_int();
+    return NULL;
 }
@@ -14,8 +14,16 @@
  */
 
 #include <make_common_data_structures.h>
+#include <call_count_utils.h>
+#include <failure_utils.h>
+#include <model_config.h>
 #include <openssl/rand.h>
 
+#ifdef LIBCRYPTO_MODEL_DETERMINISTIC_RAND
+/* Number of successful RAND_bytes() calls so far (see LIBCRYPTO_MODEL_DETERMINISTIC_RAND in model_config.h). */
+static size_t rand_bytes_calls = 0;
+#endif
+
 /*
  * RAND_bytes() puts num cryptographically strong pseudo-random bytes into buf.
  * An error occurs if the PRNG has not been seeded with enough randomness to ensure an unpredictable byte sequence.
@@ -23,7 +31,19 @@
  */
 int RAND_bytes(unsigned char *buf, size_t num) {
     assert(__CPROVER_w_ok(buf, num));
-    int rv;
-    __CPROVER_assume(rv == 0 || rv == 1);
-    return rv;
+    COUNT_CALL(MODEL_CALL_RAND_BYTES, num);
+
+    if (inject_failure(LIBCRYPTO_MODEL_RAND)) return 0;
+
+#ifdef LIBCRYPTO_MODEL_DETERMINISTIC_RAND
+    for (size_t i = 0; i < num; i++) {
+        buf[i] = (unsigned char)(rand_bytes_calls + i);
+    }
+    rand_bytes_calls += 1;
+#else
+    // Exactly the num output bytes become unconstrained, even without LIBCRYPTO_MODEL_PRECISE_HAVOC: stale contents of
+    // buf must not survive, and the rest of the object is not touched by the real function either.
+    __CPROVER_havoc_slice(buf, num);
+#endif
+    return 1;
 }
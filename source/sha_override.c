@@ -13,10 +13,16 @@
  * permissions and limitations under the License.
  */
 
+#include <digest_utils.h>
 #include <ec_utils.h>
+#include <failure_utils.h>
+#include <md32_utils.h>
+#include <model_config.h>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 
 #include <assert.h>
+#include <stdint.h>
 
 /*
  * All macros extracted from the original openssl implementation.
@@ -28,21 +34,55 @@
 #define INIT_DATA_h3 0x10325476UL
 #define INIT_DATA_h4 0xc3d2e1f0UL
 
-int SHA1_Init(SHA_CTX *c) {
-    assert(c != NULL);
-    if (nondet_bool()) return 0;
+/* Whether the stream of c was started by SHA*_Init() and not yet ended by SHA*_Final(). */
+#define SHA_STREAM_IS_OPEN(c) ((c)->stream_state == SHA_STREAM_INITIALIZED || (c)->stream_state == SHA_STREAM_ABSORBING)
+
+/* Number of bytes absorbed by a context after absorbing len more, saturating at SIZE_MAX. */
+#define SHA_ABSORBED_AFTER(absorbed, len) ((len) > SIZE_MAX - (absorbed) ? SIZE_MAX : (absorbed) + (len))
+
+/*
+ * Records that the len bytes at data were absorbed into the stream of c, and assigns clause targets of doing so. With
+ * LIBCRYPTO_MODEL_UF_DIGESTS the bytes are also folded into the fingerprint of c.
+ */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define SHA_FINGERPRINT_ABSORB(c, data, len) \
+        (c)->fingerprint = digest_fingerprint_absorb((c)->fingerprint, (data), (len))
+#    define SHA_STREAM_ASSIGNS(c) (c)->stream_state, (c)->bytes_absorbed, (c)->fingerprint
+#else
+#    define SHA_FINGERPRINT_ABSORB(c, data, len)
+#    define SHA_STREAM_ASSIGNS(c) (c)->stream_state, (c)->bytes_absorbed
+#endif
+
+#define SHA_ABSORB(c, data, len)                                              \
+    do {                                                                      \
+        (c)->stream_state   = SHA_STREAM_ABSORBING;                           \
+        (c)->bytes_absorbed = SHA_ABSORBED_AFTER((c)->bytes_absorbed, (len)); \
+        SHA_FINGERPRINT_ABSORB((c), (data), (len));                           \
+    } while (0)
+
+/*
+ * Writes the md_len-byte digest of the given algorithm (an enum evp_sha value) of the message absorbed into c to md:
+ * unconstrained bytes by default, an uninterpreted function of the fingerprint of c with LIBCRYPTO_MODEL_UF_DIGESTS.
+ */
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+#    define SHA_DIGEST_OUTPUT(md, c, md_len, algorithm) \
+        digest_fingerprint_output((md), (md_len), (algorithm), (c)->fingerprint, DIGEST_FINGERPRINT_EMPTY)
+#else
+#    define SHA_DIGEST_OUTPUT(md, c, md_len, algorithm) __CPROVER_havoc_slice((md), (md_len))
+#endif
+
+static void sha1_init_state(SHA_CTX *c) {
     *c    = (const SHA_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->h0 = INIT_DATA_h0;
     c->h1 = INIT_DATA_h1;
     c->h2 = INIT_DATA_h2;
     c->h3 = INIT_DATA_h3;
     c->h4 = INIT_DATA_h4;
-    return 1;
+
+    c->stream_state = SHA_STREAM_INITIALIZED;
 }
 
-int SHA224_Init(SHA256_CTX *c) {
-    assert(c != NULL);
-    if (nondet_bool()) return 0;
+static void sha224_init_state(SHA256_CTX *c) {
     *c        = (const SHA256_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->h[0]   = 0xc1059ed8UL;
     c->h[1]   = 0x367cd507UL;
@@ -52,13 +92,11 @@ int SHA224_Init(SHA256_CTX *c) {
     c->h[5]   = 0x68581511UL;
     c->h[6]   = 0x64f98fa7UL;
     c->h[7]   = 0xbefa4fa4UL;
-    c->md_len = SHA224_DIGEST_LENGTH;
-    return 1;
+    c->md_len       = SHA224_DIGEST_LENGTH;
+    c->stream_state = SHA_STREAM_INITIALIZED;
 }
 
-int SHA256_Init(SHA256_CTX *c) {
-    assert(c != NULL);
-    if (nondet_bool()) return 0;
+static void sha256_init_state(SHA256_CTX *c) {
     *c        = (const SHA256_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->h[0]   = 0x6a09e667UL;
     c->h[1]   = 0xbb67ae85UL;
@@ -68,13 +106,201 @@ int SHA256_Init(SHA256_CTX *c) {
     c->h[5]   = 0x9b05688cUL;
     c->h[6]   = 0x1f83d9abUL;
     c->h[7]   = 0x5be0cd19UL;
-    c->md_len = SHA256_DIGEST_LENGTH;
+    c->md_len       = SHA256_DIGEST_LENGTH;
+    c->stream_state = SHA_STREAM_INITIALIZED;
+}
+
+#ifdef LIBCRYPTO_MODEL_CONCRETE_SHA1
+/* Reference implementation of SHA-1 (FIPS 180-4, section 6.1), see LIBCRYPTO_MODEL_CONCRETE_SHA1 in model_config.h. */
+#    define SHA1_STREAM(c) ((struct md32_stream){ (unsigned char *)(c)->data, &(c)->num, &(c)->Nl, &(c)->Nh })
+
+static void sha1_block(void *ctx, const unsigned char *block) {
+    SHA_CTX *c = ctx;
+    uint32_t w[80];
+    for (size_t t = 0; t < 16; t++) w[t] = md32_load_be(block + 4 * t);
+    for (size_t t = 16; t < 80; t++) w[t] = MD32_ROTL(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+
+    uint32_t a = c->h0, b = c->h1, d = c->h3, e = c->h4;
+    uint32_t cc = c->h2;
+    for (size_t t = 0; t < 80; t++) {
+        uint32_t f, k;
+        if (t < 20) {
+            f = (b & cc) | (~b & d);
+            k = 0x5a827999UL;
+        } else if (t < 40) {
+            f = b ^ cc ^ d;
+            k = 0x6ed9eba1UL;
+        } else if (t < 60) {
+            f = (b & cc) | (b & d) | (cc & d);
+            k = 0x8f1bbcdcUL;
+        } else {
+            f = b ^ cc ^ d;
+            k = 0xca62c1d6UL;
+        }
+        uint32_t temp = MD32_ROTL(a, 5) + f + e + k + w[t];
+        e             = d;
+        d             = cc;
+        cc            = MD32_ROTL(b, 30);
+        b             = a;
+        a             = temp;
+    }
+
+    c->h0 += a;
+    c->h1 += b;
+    c->h2 += cc;
+    c->h3 += d;
+    c->h4 += e;
+}
+
+static void sha1_reference_final(unsigned char *md, SHA_CTX *c) {
+    md32_final(c, SHA1_STREAM(c), sha1_block, true);
+    md32_store_be(md, c->h0);
+    md32_store_be(md + 4, c->h1);
+    md32_store_be(md + 8, c->h2);
+    md32_store_be(md + 12, c->h3);
+    md32_store_be(md + 16, c->h4);
+}
+
+/* Update and Final assign the whole context, and expect less than a block of buffered data. */
+#    define SHA1_UPDATE_ASSIGNS(c) *(c)
+#    define SHA1_BUFFER_IS_VALID(c) ((c)->num < MD32_CBLOCK)
+#    define SHA1_REFERENCE_UPDATE(c, data, len) md32_update((c), SHA1_STREAM(c), sha1_block, (data), (len))
+#    define SHA1_REFERENCE_FINAL(md, c) sha1_reference_final((md), (c))
+#else
+#    define SHA1_UPDATE_ASSIGNS(c) SHA_STREAM_ASSIGNS(c)
+#    define SHA1_BUFFER_IS_VALID(c) true
+#    define SHA1_REFERENCE_UPDATE(c, data, len)
+#    define SHA1_REFERENCE_FINAL(md, c) SHA_DIGEST_OUTPUT((md), (c), SHA_DIGEST_LENGTH, EVP_SHA1)
+#endif
+
+#ifdef LIBCRYPTO_MODEL_CONCRETE_SHA256
+/*
+ * Reference implementation of SHA-256 and SHA-224 (FIPS 180-4, section 6.2), see LIBCRYPTO_MODEL_CONCRETE_SHA256 in
+ * model_config.h.
+ */
+#    define SHA256_STREAM(c) ((struct md32_stream){ (unsigned char *)(c)->data, &(c)->num, &(c)->Nl, &(c)->Nh })
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+    0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+    0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+    0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+    0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+    0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+    0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+#    define SHA256_ROTR(x, n) MD32_ROTL((x), 32 - (n))
+#    define SHA256_SIGMA0(x) (SHA256_ROTR((x), 2) ^ SHA256_ROTR((x), 13) ^ SHA256_ROTR((x), 22))
+#    define SHA256_SIGMA1(x) (SHA256_ROTR((x), 6) ^ SHA256_ROTR((x), 11) ^ SHA256_ROTR((x), 25))
+#    define SHA256_sigma0(x) (SHA256_ROTR((x), 7) ^ SHA256_ROTR((x), 18) ^ ((x) >> 3))
+#    define SHA256_sigma1(x) (SHA256_ROTR((x), 17) ^ SHA256_ROTR((x), 19) ^ ((x) >> 10))
+
+static void sha256_block(void *ctx, const unsigned char *block) {
+    SHA256_CTX *c = ctx;
+    uint32_t w[64];
+    for (size_t t = 0; t < 16; t++) w[t] = md32_load_be(block + 4 * t);
+    for (size_t t = 16; t < 64; t++) {
+        w[t] = SHA256_sigma1(w[t - 2]) + w[t - 7] + SHA256_sigma0(w[t - 15]) + w[t - 16];
+    }
+
+    uint32_t a = c->h[0], b = c->h[1], cc = c->h[2], d = c->h[3];
+    uint32_t e = c->h[4], f = c->h[5], g = c->h[6], h = c->h[7];
+    for (size_t t = 0; t < 64; t++) {
+        uint32_t t1 = h + SHA256_SIGMA1(e) + ((e & f) ^ (~e & g)) + sha256_k[t] + w[t];
+        uint32_t t2 = SHA256_SIGMA0(a) + ((a & b) ^ (a & cc) ^ (b & cc));
+        h           = g;
+        g           = f;
+        f           = e;
+        e           = d + t1;
+        d           = cc;
+        cc          = b;
+        b           = a;
+        a           = t1 + t2;
+    }
+
+    c->h[0] += a;
+    c->h[1] += b;
+    c->h[2] += cc;
+    c->h[3] += d;
+    c->h[4] += e;
+    c->h[5] += f;
+    c->h[6] += g;
+    c->h[7] += h;
+}
+
+/* Writes the first md_len bytes of the digest of c, i.e. the SHA-256 digest or the truncated SHA-224 one, to md. */
+static void sha256_reference_final(unsigned char *md, SHA256_CTX *c, size_t md_len) {
+    md32_final(c, SHA256_STREAM(c), sha256_block, true);
+    for (size_t i = 0; i < md_len / 4; i++) md32_store_be(md + 4 * i, c->h[i]);
+}
+
+/* Update and Final assign the whole context, and expect less than a block of buffered data. */
+#    define SHA256_UPDATE_ASSIGNS(c) *(c)
+#    define SHA256_BUFFER_IS_VALID(c) ((c)->num < MD32_CBLOCK)
+#    define SHA256_REFERENCE_UPDATE(c, data, len) md32_update((c), SHA256_STREAM(c), sha256_block, (data), (len))
+#    define SHA256_REFERENCE_FINAL(md, c, md_len) sha256_reference_final((md), (c), (md_len))
+#else
+#    define SHA256_UPDATE_ASSIGNS(c) SHA_STREAM_ASSIGNS(c)
+#    define SHA256_BUFFER_IS_VALID(c) true
+#    define SHA256_REFERENCE_UPDATE(c, data, len)
+#    define SHA256_REFERENCE_FINAL(md, c, md_len) \
+        SHA_DIGEST_OUTPUT((md), (c), (md_len), (md_len) == SHA224_DIGEST_LENGTH ? EVP_SHA224 : EVP_SHA256)
+#endif
+
+int SHA1_Init(SHA_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(c, sizeof(*c)))
+    __CPROVER_assigns(*c)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (c->stream_state == SHA_STREAM_INITIALIZED && c->bytes_absorbed == 0))
+{
+    assert(c != NULL);
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    sha1_init_state(c);
+    return 1;
+}
+
+int SHA224_Init(SHA256_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(c, sizeof(*c)))
+    __CPROVER_assigns(*c)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (c->stream_state == SHA_STREAM_INITIALIZED && c->bytes_absorbed == 0))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->md_len == SHA224_DIGEST_LENGTH)
+{
+    assert(c != NULL);
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    sha224_init_state(c);
+    return 1;
+}
+
+int SHA256_Init(SHA256_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(c, sizeof(*c)))
+    __CPROVER_assigns(*c)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (c->stream_state == SHA_STREAM_INITIALIZED && c->bytes_absorbed == 0))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->md_len == SHA256_DIGEST_LENGTH)
+{
+    assert(c != NULL);
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    sha256_init_state(c);
     return 1;
 }
 
-int SHA384_Init(SHA512_CTX *c) {
+int SHA384_Init(SHA512_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(c, sizeof(*c)))
+    __CPROVER_assigns(*c)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (c->stream_state == SHA_STREAM_INITIALIZED && c->bytes_absorbed == 0))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->md_len == SHA384_DIGEST_LENGTH)
+{
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    *c      = (const SHA512_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->h[0] = U64(0xcbbb9d5dc1059ed8);
     c->h[1] = U64(0x629a292a367cd507);
     c->h[2] = U64(0x9159015a3070dd17);
@@ -84,16 +310,22 @@ int SHA384_Init(SHA512_CTX *c) {
     c->h[6] = U64(0xdb0c2e0d64f98fa7);
     c->h[7] = U64(0x47b5481dbefa4fa4);
 
-    c->Nl     = 0;
-    c->Nh     = 0;
-    c->num    = 0;
-    c->md_len = SHA384_DIGEST_LENGTH;
+    c->md_len       = SHA384_DIGEST_LENGTH;
+    c->stream_state = SHA_STREAM_INITIALIZED;
     return 1;
 }
 
-int SHA512_Init(SHA512_CTX *c) {
+int SHA512_Init(SHA512_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(c, sizeof(*c)))
+    __CPROVER_assigns(*c)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0 || (c->stream_state == SHA_STREAM_INITIALIZED && c->bytes_absorbed == 0))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->md_len == SHA512_DIGEST_LENGTH)
+{
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    *c      = (const SHA512_CTX){ 0 }; /* memset(c, 0, sizeof(*c)); */
     c->h[0] = U64(0x6a09e667f3bcc908);
     c->h[1] = U64(0xbb67ae8584caa73b);
     c->h[2] = U64(0x3c6ef372fe94f82b);
@@ -103,89 +335,309 @@ int SHA512_Init(SHA512_CTX *c) {
     c->h[6] = U64(0x1f83d9abfb41bd6b);
     c->h[7] = U64(0x5be0cd19137e2179);
 
-    c->Nl     = 0;
-    c->Nh     = 0;
-    c->num    = 0;
-    c->md_len = SHA512_DIGEST_LENGTH;
+    c->md_len       = SHA512_DIGEST_LENGTH;
+    c->stream_state = SHA_STREAM_INITIALIZED;
     return 1;
 }
 
-int SHA1_Final(unsigned char *md, SHA_CTX *c) {
+int SHA1_Final(unsigned char *md, SHA_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(md, SHA_DIGEST_LENGTH))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA1_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(*c, __CPROVER_object_upto(md, SHA_DIGEST_LENGTH))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->stream_state == SHA_STREAM_FINALIZED)
+{
     assert(__CPROVER_w_ok(md, SHA_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, SHA_DIGEST_LENGTH);
-    *c = (const SHA_CTX){ 0 };
+    assert(SHA1_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Final requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA1_REFERENCE_FINAL(md, c);
+    *c              = (const SHA_CTX){ 0 };
+    c->stream_state = SHA_STREAM_FINALIZED;
     return 1;
 }
 
-int SHA224_Final(unsigned char *md, SHA256_CTX *c) {
+int SHA224_Final(unsigned char *md, SHA256_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(md, SHA224_DIGEST_LENGTH))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA256_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(*c, __CPROVER_object_upto(md, SHA224_DIGEST_LENGTH))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->stream_state == SHA_STREAM_FINALIZED)
+{
     assert(__CPROVER_w_ok(md, SHA224_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, SHA224_DIGEST_LENGTH);
-    *c = (const SHA256_CTX){ 0 };
+    assert(SHA256_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Final requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA256_REFERENCE_FINAL(md, c, SHA224_DIGEST_LENGTH);
+    *c              = (const SHA256_CTX){ 0 };
+    c->stream_state = SHA_STREAM_FINALIZED;
     return 1;
 }
 
-int SHA256_Final(unsigned char *md, SHA256_CTX *c) {
+int SHA256_Final(unsigned char *md, SHA256_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(md, SHA256_DIGEST_LENGTH))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA256_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(*c, __CPROVER_object_upto(md, SHA256_DIGEST_LENGTH))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->stream_state == SHA_STREAM_FINALIZED)
+{
     assert(__CPROVER_w_ok(md, SHA256_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, SHA256_DIGEST_LENGTH);
-    *c = (const SHA256_CTX){ 0 };
+    assert(SHA256_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Final requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA256_REFERENCE_FINAL(md, c, SHA256_DIGEST_LENGTH);
+    *c              = (const SHA256_CTX){ 0 };
+    c->stream_state = SHA_STREAM_FINALIZED;
     return 1;
 }
 
-int SHA384_Final(unsigned char *md, SHA512_CTX *c) {
+int SHA384_Final(unsigned char *md, SHA512_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(md, SHA384_DIGEST_LENGTH))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_assigns(*c, __CPROVER_object_upto(md, SHA384_DIGEST_LENGTH))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->stream_state == SHA_STREAM_FINALIZED)
+{
     assert(__CPROVER_w_ok(md, SHA384_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, SHA384_DIGEST_LENGTH);
-    *c = (const SHA512_CTX){ 0 };
+    assert(SHA_STREAM_IS_OPEN(c)); /* Final requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA_DIGEST_OUTPUT(md, c, SHA384_DIGEST_LENGTH, EVP_SHA384);
+    *c              = (const SHA512_CTX){ 0 };
+    c->stream_state = SHA_STREAM_FINALIZED;
     return 1;
 }
 
-int SHA512_Final(unsigned char *md, SHA512_CTX *c) {
+int SHA512_Final(unsigned char *md, SHA512_CTX *c)
+    __CPROVER_requires(__CPROVER_w_ok(md, SHA512_DIGEST_LENGTH))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_assigns(*c, __CPROVER_object_upto(md, SHA512_DIGEST_LENGTH))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(__CPROVER_return_value == 0 || c->stream_state == SHA_STREAM_FINALIZED)
+{
     assert(__CPROVER_w_ok(md, SHA512_DIGEST_LENGTH));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
-    __CPROVER_havoc_slice(md, SHA512_DIGEST_LENGTH);
-    *c = (const SHA512_CTX){ 0 };
+    assert(SHA_STREAM_IS_OPEN(c)); /* Final requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA_DIGEST_OUTPUT(md, c, SHA512_DIGEST_LENGTH, EVP_SHA512);
+    *c              = (const SHA512_CTX){ 0 };
+    c->stream_state = SHA_STREAM_FINALIZED;
     return 1;
 }
 
-int SHA1_Update(SHA_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+int SHA1_Update(SHA_CTX *c, const void *data, size_t len)
+    __CPROVER_requires(len == 0 || __CPROVER_r_ok(data, len))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA1_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(SHA1_UPDATE_ASSIGNS(c))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? c->stream_state == __CPROVER_old(c->stream_state) && c->bytes_absorbed == __CPROVER_old(c->bytes_absorbed)
+            : c->stream_state == SHA_STREAM_ABSORBING &&
+                  c->bytes_absorbed == SHA_ABSORBED_AFTER(__CPROVER_old(c->bytes_absorbed), len))
+{
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    assert(SHA1_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Update requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA1_REFERENCE_UPDATE(c, data, len);
+    SHA_ABSORB(c, data, len);
     return 1;
 }
 
-int SHA224_Update(SHA256_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+int SHA224_Update(SHA256_CTX *c, const void *data, size_t len)
+    __CPROVER_requires(len == 0 || __CPROVER_r_ok(data, len))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA256_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(SHA256_UPDATE_ASSIGNS(c))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? c->stream_state == __CPROVER_old(c->stream_state) && c->bytes_absorbed == __CPROVER_old(c->bytes_absorbed)
+            : c->stream_state == SHA_STREAM_ABSORBING &&
+                  c->bytes_absorbed == SHA_ABSORBED_AFTER(__CPROVER_old(c->bytes_absorbed), len))
+{
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    assert(SHA256_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Update requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA256_REFERENCE_UPDATE(c, data, len);
+    SHA_ABSORB(c, data, len);
     return 1;
 }
 
-int SHA256_Update(SHA256_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+int SHA256_Update(SHA256_CTX *c, const void *data, size_t len)
+    __CPROVER_requires(len == 0 || __CPROVER_r_ok(data, len))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_requires(SHA256_BUFFER_IS_VALID(c))
+    __CPROVER_assigns(SHA256_UPDATE_ASSIGNS(c))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? c->stream_state == __CPROVER_old(c->stream_state) && c->bytes_absorbed == __CPROVER_old(c->bytes_absorbed)
+            : c->stream_state == SHA_STREAM_ABSORBING &&
+                  c->bytes_absorbed == SHA_ABSORBED_AFTER(__CPROVER_old(c->bytes_absorbed), len))
+{
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    assert(SHA256_BUFFER_IS_VALID(c));
+    assert(SHA_STREAM_IS_OPEN(c)); /* Update requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA256_REFERENCE_UPDATE(c, data, len);
+    SHA_ABSORB(c, data, len);
     return 1;
 }
 
-int SHA384_Update(SHA512_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+int SHA384_Update(SHA512_CTX *c, const void *data, size_t len)
+    __CPROVER_requires(len == 0 || __CPROVER_r_ok(data, len))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_assigns(SHA_STREAM_ASSIGNS(c))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? c->stream_state == __CPROVER_old(c->stream_state) && c->bytes_absorbed == __CPROVER_old(c->bytes_absorbed)
+            : c->stream_state == SHA_STREAM_ABSORBING &&
+                  c->bytes_absorbed == SHA_ABSORBED_AFTER(__CPROVER_old(c->bytes_absorbed), len))
+{
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    assert(SHA_STREAM_IS_OPEN(c)); /* Update requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA_ABSORB(c, data, len);
     return 1;
 }
 
-int SHA512_Update(SHA512_CTX *c, const void *data, size_t len) {
-    assert(len == 0 || __CPROVER_w_ok(data, len));
+int SHA512_Update(SHA512_CTX *c, const void *data, size_t len)
+    __CPROVER_requires(len == 0 || __CPROVER_r_ok(data, len))
+    __CPROVER_requires(__CPROVER_rw_ok(c, sizeof(*c)) && SHA_STREAM_IS_OPEN(c))
+    __CPROVER_assigns(SHA_STREAM_ASSIGNS(c))
+    __CPROVER_ensures(__CPROVER_return_value == 0 || __CPROVER_return_value == 1)
+    __CPROVER_ensures(
+        __CPROVER_return_value == 0
+            ? c->stream_state == __CPROVER_old(c->stream_state) && c->bytes_absorbed == __CPROVER_old(c->bytes_absorbed)
+            : c->stream_state == SHA_STREAM_ABSORBING &&
+                  c->bytes_absorbed == SHA_ABSORBED_AFTER(__CPROVER_old(c->bytes_absorbed), len))
+{
+    assert(len == 0 || __CPROVER_r_ok(data, len));
     assert(c != NULL);
-    if (nondet_bool()) return 0;
+    assert(SHA_STREAM_IS_OPEN(c)); /* Update requires a preceding Init and no Final since. */
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return 0;
+    SHA_ABSORB(c, data, len);
     return 1;
 }
+
+/*
+ * One-shot digests: SHA256(d, n, md) computes the SHA-256 digest of the n bytes at d in a single call, and likewise
+ * for the other variants. They model the whole Init/Update/Final sequence with a single failure point and a single
+ * write of the output. The digest is placed in md, or in a static array if md is NULL. Returns a pointer to the
+ * digest, or NULL on failure (as in OpenSSL 3.0).
+ */
+static unsigned char sha1_static_md[SHA_DIGEST_LENGTH];
+static unsigned char sha224_static_md[SHA224_DIGEST_LENGTH];
+static unsigned char sha256_static_md[SHA256_DIGEST_LENGTH];
+static unsigned char sha384_static_md[SHA384_DIGEST_LENGTH];
+static unsigned char sha512_static_md[SHA512_DIGEST_LENGTH];
+
+static unsigned char *sha_one_shot(
+    const unsigned char *d, size_t n, unsigned char *md, size_t md_len, enum evp_sha algorithm) {
+    assert(n == 0 || __CPROVER_r_ok(d, n));
+    assert(__CPROVER_w_ok(md, md_len));
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return NULL;
+#ifdef LIBCRYPTO_MODEL_UF_DIGESTS
+    digest_fingerprint_output(
+        md, md_len, algorithm, digest_fingerprint_absorb(DIGEST_FINGERPRINT_EMPTY, d, n), DIGEST_FINGERPRINT_EMPTY);
+#else
+    __CPROVER_havoc_slice(md, md_len);
+#endif
+    return md;
+}
+
+#ifdef LIBCRYPTO_MODEL_CONCRETE_SHA1
+static unsigned char *sha1_one_shot(
+    const unsigned char *d, size_t n, unsigned char *md, size_t md_len, enum evp_sha algorithm) {
+    assert(n == 0 || __CPROVER_r_ok(d, n));
+    assert(__CPROVER_w_ok(md, md_len));
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return NULL;
+    SHA_CTX c;
+    sha1_init_state(&c);
+    SHA1_REFERENCE_UPDATE(&c, d, n);
+    SHA1_REFERENCE_FINAL(md, &c);
+    return md;
+}
+#else
+#    define sha1_one_shot sha_one_shot
+#endif
+
+#ifdef LIBCRYPTO_MODEL_CONCRETE_SHA256
+static unsigned char *sha256_one_shot(
+    const unsigned char *d, size_t n, unsigned char *md, size_t md_len, enum evp_sha algorithm) {
+    assert(n == 0 || __CPROVER_r_ok(d, n));
+    assert(__CPROVER_w_ok(md, md_len));
+    if (inject_failure(LIBCRYPTO_MODEL_SHA)) return NULL;
+    SHA256_CTX c;
+    if (md_len == SHA224_DIGEST_LENGTH) {
+        sha224_init_state(&c);
+    } else {
+        sha256_init_state(&c);
+    }
+    SHA256_REFERENCE_UPDATE(&c, d, n);
+    SHA256_REFERENCE_FINAL(md, &c, md_len);
+    return md;
+}
+#else
+#    define sha256_one_shot sha_one_shot
+#endif
+
+unsigned char *SHA1(const unsigned char *d, size_t n, unsigned char *md)
+    __CPROVER_requires(n == 0 || __CPROVER_r_ok(d, n))
+    __CPROVER_requires(md == NULL || __CPROVER_w_ok(md, SHA_DIGEST_LENGTH))
+    __CPROVER_assigns(md != NULL: __CPROVER_object_upto(md, SHA_DIGEST_LENGTH); md == NULL: sha1_static_md)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_return_value == (md != NULL ? md : sha1_static_md))
+{
+    return sha1_one_shot(d, n, md != NULL ? md : sha1_static_md, SHA_DIGEST_LENGTH, EVP_SHA1);
+}
+
+unsigned char *SHA224(const unsigned char *d, size_t n, unsigned char *md)
+    __CPROVER_requires(n == 0 || __CPROVER_r_ok(d, n))
+    __CPROVER_requires(md == NULL || __CPROVER_w_ok(md, SHA224_DIGEST_LENGTH))
+    __CPROVER_assigns(md != NULL: __CPROVER_object_upto(md, SHA224_DIGEST_LENGTH); md == NULL: sha224_static_md)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_return_value == (md != NULL ? md : sha224_static_md))
+{
+    return sha256_one_shot(d, n, md != NULL ? md : sha224_static_md, SHA224_DIGEST_LENGTH, EVP_SHA224);
+}
+
+unsigned char *SHA256(const unsigned char *d, size_t n, unsigned char *md)
+    __CPROVER_requires(n == 0 || __CPROVER_r_ok(d, n))
+    __CPROVER_requires(md == NULL || __CPROVER_w_ok(md, SHA256_DIGEST_LENGTH))
+    __CPROVER_assigns(md != NULL: __CPROVER_object_upto(md, SHA256_DIGEST_LENGTH); md == NULL: sha256_static_md)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_return_value == (md != NULL ? md : sha256_static_md))
+{
+    return sha256_one_shot(d, n, md != NULL ? md : sha256_static_md, SHA256_DIGEST_LENGTH, EVP_SHA256);
+}
+
+unsigned char *SHA384(const unsigned char *d, size_t n, unsigned char *md)
+    __CPROVER_requires(n == 0 || __CPROVER_r_ok(d, n))
+    __CPROVER_requires(md == NULL || __CPROVER_w_ok(md, SHA384_DIGEST_LENGTH))
+    __CPROVER_assigns(md != NULL: __CPROVER_object_upto(md, SHA384_DIGEST_LENGTH); md == NULL: sha384_static_md)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_return_value == (md != NULL ? md : sha384_static_md))
+{
+    return sha_one_shot(d, n, md != NULL ? md : sha384_static_md, SHA384_DIGEST_LENGTH, EVP_SHA384);
+}
+
+unsigned char *SHA512(const unsigned char *d, size_t n, unsigned char *md)
+    __CPROVER_requires(n == 0 || __CPROVER_r_ok(d, n))
+    __CPROVER_requires(md == NULL || __CPROVER_w_ok(md, SHA512_DIGEST_LENGTH))
+    __CPROVER_assigns(md != NULL: __CPROVER_object_upto(md, SHA512_DIGEST_LENGTH); md == NULL: sha512_static_md)
+    __CPROVER_ensures(__CPROVER_return_value == NULL || __CPROVER_return_value == (md != NULL ? md : sha512_static_md))
+{
+    return sha_one_shot(d, n, md != NULL ? md : sha512_static_md, SHA512_DIGEST_LENGTH, EVP_SHA512);
+}